@@ -0,0 +1,225 @@
+﻿// bench/game_bench.cpp
+// 게임 소켓 서버 벤치마크
+// 마이크로: HTTP 요청 해석(이전 방식/Beast 파서), 요청 JSON 파싱, 세션 토큰 발급/검증
+// 매크로: BENCH_GAME_DB_URL(libpq 연결 문자열)을 지정하면 서버를 프로세스 안에서 띄우고
+//         루프백 HTTP와 WebSocket(permessage-deflate)으로 login 요청을 보내
+//         응답까지의 왕복 시간을 측정 (DB 풀 획득/반환 포함)
+// 사용법: GameSocketBench [--filter 이름] [--json 결과.json] [--min-time 초] [--repetitions 횟수]
+#include "bench/bench_harness.h"
+#include "server.h"
+#include "db/db_pool.h"
+#include "auth/signed_token.h"
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/websocket.hpp>
+#include <pqxx/pqxx>
+#include <spdlog/spdlog.h>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+using namespace game_server;
+using bench::doNotOptimize;
+using json = nlohmann::json;
+namespace beast = boost::beast;
+
+namespace {
+
+    const std::string kLoginBody =
+        R"({"action":"login","username":"benchuser","password":"benchpass"})";
+
+    std::string makeHttpRequest(const std::string& body) {
+        return "POST /api HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "Connection: keep-alive\r\n"
+            "\r\n" + body;
+    }
+
+    // 이전 Session::read_header 방식 (대소문자 구분 find + stoul, 파이프라이닝/청크 미지원), 개선 폭 비교용
+    // e2e 클라이언트도 서버 응답 헤더를 읽을 때 사용
+    std::size_t parseContentLength(const std::string& header) {
+        const std::string cl_header = "Content-Length: ";
+        auto pos = header.find(cl_header);
+        if (pos == std::string::npos) return 0;
+        auto end_pos = header.find("\r\n", pos);
+        if (end_pos == std::string::npos) return 0;
+        return std::stoul(header.substr(pos + cl_header.length(), end_pos - (pos + cl_header.length())));
+    }
+
+    json benchTokenConfig() {
+        return {
+            {"activeKeyId", 1},
+            {"ttlSeconds", 3600},
+            {"keys", json::array({ { {"id", 1}, {"secret", "game-socket-bench-secret-key-0123456789"} } })}
+        };
+    }
+
+    void benchHttp(bench::Runner& runner) {
+        const std::string request = makeHttpRequest(kLoginBody);
+
+        runner.run("http/header Content-Length + body split (before)", [&]() {
+            std::string header(request.data(), request.size());
+            std::size_t length = parseContentLength(header);
+            auto body_start = header.find("\r\n\r\n");
+            doNotOptimize(header.substr(body_start + 4, length));
+            });
+
+        // Session과 같이 요청마다 파서를 새로 만들고, 남은 바이트는 다음 요청에서 이어서 해석
+        auto parseAll = [](const std::string& input) {
+            std::size_t offset = 0;
+            std::size_t requests = 0;
+            while (offset < input.size()) {
+                beast::http::request_parser<beast::http::string_body> parser;
+                parser.header_limit(8192);
+                parser.eager(true); // 헤더에서 멈추지 않고 본문까지 한 번에 해석
+                beast::error_code ec;
+                offset += parser.put(boost::asio::buffer(input.data() + offset, input.size() - offset), ec);
+                if (ec || !parser.is_done()) break;
+                doNotOptimize(parser.get().body().size());
+                ++requests;
+            }
+            return requests;
+        };
+        runner.run("http/beast parser login request", [&]() {
+            doNotOptimize(parseAll(request));
+            });
+
+        std::string pipelined;
+        for (int i = 0; i < 16; ++i) pipelined += request;
+        runner.run("http/beast parser 16 pipelined requests", [&]() {
+            doNotOptimize(parseAll(pipelined));
+            });
+
+        const std::string chunked = "POST /api HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\n"
+            "20\r\n" + kLoginBody.substr(0, 32) + "\r\n" +
+            "20\r\n" + kLoginBody.substr(32) + "\r\n0\r\n\r\n";
+        runner.run("http/beast parser chunked body", [&]() {
+            doNotOptimize(parseAll(chunked));
+            });
+
+        runner.run("json/parse login body", [&]() {
+            doNotOptimize(json::parse(kLoginBody));
+            });
+
+        json response = {
+            {"status", "success"}, {"message", "Login successful"},
+            {"user_id", 1234}, {"username", "benchuser"},
+            {"token", "AQABAAAE0mf7c2AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"}
+        };
+        runner.run("json/dump login response", [&]() {
+            doNotOptimize(response.dump());
+            });
+    }
+
+    void benchToken(bench::Runner& runner) {
+        auth::TokenSigner signer(auth::TokenKeyConfig::fromJson(benchTokenConfig()));
+        runner.run("token/issue", [&]() {
+            doNotOptimize(signer.issue(1234));
+            });
+
+        auth::SessionToken token = signer.issue(1234);
+        std::string text(token.view());
+        runner.run("token/verify", [&]() {
+            auth::TokenClaims claims;
+            doNotOptimize(signer.verify(text, &claims));
+            });
+    }
+
+    void benchDb(bench::Runner& runner) {
+        const char* url = std::getenv("BENCH_GAME_DB_URL");
+        if (!url || !*url) {
+            runner.skip("dbpool/acquire+release", "BENCH_GAME_DB_URL 미지정");
+            runner.skip("e2e/http login round trip", "BENCH_GAME_DB_URL 미지정");
+            runner.skip("e2e/websocket login round trip", "BENCH_GAME_DB_URL 미지정");
+            return;
+        }
+
+        if (runner.enabled("dbpool/")) {
+            DbPool pool(url, 4);
+            runner.run("dbpool/acquire+release", [&]() {
+                auto conn = pool.get_connection();
+                doNotOptimize(conn.get());
+                pool.return_connection(std::move(conn));
+                });
+        }
+
+        if (!runner.enabled("e2e/")) return;
+
+        // 로그인 대상 계정 준비 (처음 실행이면 register, 이미 있으면 오류 응답을 무시)
+        boost::asio::io_context io_context;
+        json config = { {"sessionToken", benchTokenConfig()} };
+        Server server(io_context, 0, url, config);
+        server.run();
+        std::thread io_thread([&io_context]() {
+            auto guard = boost::asio::make_work_guard(io_context);
+            io_context.run();
+            });
+
+        // 세션은 keep-alive로 연결을 유지하므로 연결 하나로 요청을 반복
+        boost::asio::io_context client_context;
+        boost::asio::ip::tcp::socket socket(client_context);
+        socket.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), server.local_port()));
+        std::string received;
+        auto roundTrip = [&](const std::string& body) {
+            boost::asio::write(socket, boost::asio::buffer(makeHttpRequest(body)));
+            std::size_t header_length = boost::asio::read_until(socket, boost::asio::dynamic_buffer(received), "\r\n\r\n");
+            std::size_t total = header_length + parseContentLength(received.substr(0, header_length));
+            if (received.size() < total) {
+                boost::asio::read(socket, boost::asio::dynamic_buffer(received), boost::asio::transfer_exactly(total - received.size()));
+            }
+            std::string response = received.substr(header_length, total - header_length);
+            received.erase(0, total);
+            return response;
+        };
+
+        roundTrip(R"({"action":"register","username":"benchuser","password":"benchpass"})");
+        runner.run("e2e/http login round trip", [&]() {
+            doNotOptimize(roundTrip(kLoginBody));
+            });
+
+        boost::system::error_code ignored;
+        socket.close(ignored);
+
+        // 게임 클라이언트와 같은 지속 연결: 업그레이드 후 메시지 하나가 요청 하나
+        beast::websocket::stream<boost::asio::ip::tcp::socket> ws(client_context);
+        ws.next_layer().connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), server.local_port()));
+        beast::websocket::permessage_deflate deflate;
+        deflate.client_enable = true;
+        ws.set_option(deflate);
+        ws.handshake("localhost", "/ws");
+        ws.text(true);
+        beast::flat_buffer ws_buffer;
+        runner.run("e2e/websocket login round trip", [&]() {
+            ws.write(boost::asio::buffer(kLoginBody));
+            ws.read(ws_buffer);
+            doNotOptimize(ws_buffer.size());
+            ws_buffer.consume(ws_buffer.size());
+            });
+        ws.close(beast::websocket::close_code::normal, ignored);
+
+        server.stop();
+        io_context.stop();
+        io_thread.join();
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    spdlog::set_level(spdlog::level::warn);
+
+    bench::Runner runner("game-socket", argc, argv);
+    try {
+        benchHttp(runner);
+        benchToken(runner);
+        benchDb(runner);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "벤치마크 오류: %s\n", e.what());
+        return 1;
+    }
+    return runner.finish();
+}
@@ -0,0 +1,150 @@
+#include "api_router.h"
+#include <array>
+#include <atomic>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    namespace {
+        // Indexed by protocol::LimitViolation
+        std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(protocol::LimitViolation::Malformed) + 1> rejected_requests{};
+    }
+
+    std::uint64_t ApiRouter::count_rejection(protocol::LimitViolation reason)
+    {
+        return rejected_requests[static_cast<std::size_t>(reason)].fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    std::uint64_t ApiRouter::rejected_count(protocol::LimitViolation reason)
+    {
+        return rejected_requests[static_cast<std::size_t>(reason)].load(std::memory_order_relaxed);
+    }
+
+    std::string ApiRouter::rejection_body(protocol::LimitViolation reason)
+    {
+        json error_response = {
+            {"status", "error"},
+            {"message", reason == protocol::LimitViolation::Malformed ? "Invalid request format" : "Request exceeds limits"}
+        };
+        return error_response.dump();
+    }
+
+    ApiRouter::ApiRouter(std::map<std::string, std::shared_ptr<ApiHandler>>& api_handlers,
+        const auth::TokenSigner& token_signer,
+        const protocol::RequestLimits& limits)
+        : api_handlers_(api_handlers),
+        token_signer_(token_signer),
+        limits_(limits)
+    {
+    }
+
+    ApiRouter::Reply ApiRouter::dispatch(const std::string& request_data, ClientState& client) const
+    {
+        // Parse JSON within the configured depth/string/element limits (stops at the first violation)
+        json request;
+        protocol::LimitViolation violation = protocol::parseBounded(
+            request_data.data(), request_data.data() + request_data.size(), limits_, request);
+        if (violation != protocol::LimitViolation::None) {
+            std::uint64_t count = count_rejection(violation);
+            spdlog::warn("Rejected request: {} ({} bytes, {} total)", protocol::toString(violation), request_data.size(), count);
+            return Reply{ rejection_body(violation), true };
+        }
+
+        try {
+            // Requests may carry a token issued by any server sharing the signing keys
+            if (request.contains("token") && request["token"].is_string()) {
+                authenticate_token(request["token"], client);
+            }
+
+            // Route to API
+            std::string action = request["action"];
+            std::string api_type;
+
+            if (action == "register" || action == "login") {
+                api_type = "auth";
+            }
+            else {
+                // Add routing for other API actions
+                spdlog::warn("Unknown action: {}", action);
+                json error_response = {
+                    {"status", "error"},
+                    {"message", "Unknown action"}
+                };
+                return Reply{ error_response.dump() };
+            }
+
+            // Find appropriate API handler
+            auto handler_it = api_handlers_.find(api_type);
+            if (handler_it == api_handlers_.end()) {
+                spdlog::error("API handler not found for type: {}", api_type);
+                json error_response = {
+                    {"status", "error"},
+                    {"message", "Internal server error"}
+                };
+                return Reply{ error_response.dump() };
+            }
+
+            // Forward request to API handler
+            std::string response = handler_it->second->handle_request(request, client.user_id, client.auth_token);
+
+            // Update authentication info (on successful login)
+            if (action == "login") {
+                json resp_json = json::parse(response);
+                if (resp_json["status"] == "success") {
+                    client.user_id = resp_json["user_id"];
+                    if (resp_json.contains("token")) {
+                        client.auth_token = resp_json["token"];
+                        // Verified in full the first time the client presents it
+                        client.token_claims = auth::TokenClaims{};
+                    }
+                    spdlog::info("User {} logged in", client.user_id);
+                }
+            }
+
+            return Reply{ std::move(response) };
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Error processing request: {}", e.what());
+            json error_response = {
+                {"status", "error"},
+                {"message", "Invalid request format"}
+            };
+            return Reply{ error_response.dump() };
+        }
+    }
+
+    void ApiRouter::authenticate_token(const std::string& token, ClientState& client) const
+    {
+        auth::TokenClaims claims;
+        auth::TokenStatus status;
+        bool cached = token == client.auth_token && client.token_claims.expires_at != 0;
+        if (cached) {
+            // Same token as last time: its signature was checked, but it may have expired or its key been rotated out
+            claims = client.token_claims;
+            status = token_signer_.recheck(claims);
+        }
+        else {
+            status = token_signer_.verify(token, &claims);
+        }
+
+        if (status != auth::TokenStatus::Valid || claims.user_id <= 0) {
+            spdlog::warn("Rejected auth token: {}", auth::toString(status));
+            client.user_id = 0;
+            client.auth_token.clear();
+            client.token_claims = auth::TokenClaims{};
+            return;
+        }
+        if (cached) {
+            return;
+        }
+
+        client.user_id = claims.user_id;
+        client.auth_token = token;
+        client.token_claims = claims;
+        spdlog::info("User {} authenticated by token (key {})", client.user_id, claims.key_id);
+    }
+
+} // namespace game_server
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "api_handler.h"
+#include "auth/signed_token.h"
+#include "protocol/request_limits.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace game_server {
+
+    // Per-connection authentication state (HTTP keep-alive connection or WebSocket)
+    struct ClientState {
+        int user_id = 0;          // Authenticated user ID (0 = not authenticated)
+        std::string auth_token;   // Authentication token
+        // Claims of auth_token once its signature was verified (expires_at 0 = not verified yet);
+        // a repeated token skips the HMAC but still has its expiry and key re-checked
+        auth::TokenClaims token_claims;
+    };
+
+    // Routes JSON API requests to the registered handlers, shared by the HTTP and WebSocket endpoints
+    class ApiRouter {
+    public:
+        struct Reply {
+            std::string body;
+            bool rejected = false; // Request violated limits or was not valid JSON (not routed)
+        };
+
+        ApiRouter(std::map<std::string, std::shared_ptr<ApiHandler>>& api_handlers,
+            const auth::TokenSigner& token_signer,
+            const protocol::RequestLimits& limits);
+
+        // Parse within the request limits, authenticate any carried token and route by "action"
+        Reply dispatch(const std::string& request_data, ClientState& client) const;
+
+        const protocol::RequestLimits& limits() const { return limits_; }
+
+        // Count a request rejected for exceeding limits or bad framing; returns the running total for the reason
+        static std::uint64_t count_rejection(protocol::LimitViolation reason);
+        static std::uint64_t rejected_count(protocol::LimitViolation reason);
+
+        // Error body sent for rejected requests
+        static std::string rejection_body(protocol::LimitViolation reason);
+
+    private:
+        void authenticate_token(const std::string& token, ClientState& client) const;
+
+        std::map<std::string, std::shared_ptr<ApiHandler>>& api_handlers_;
+        const auth::TokenSigner& token_signer_;
+        const protocol::RequestLimits& limits_;
+    };
+
+} // namespace game_server
@@ -1,18 +1,15 @@
 #include "auth_api.h"
+#include "crypto/crypto_util.h"
 #include <spdlog/spdlog.h>
-#include <openssl/sha.h>
-#include <openssl/hmac.h>
-#include <iomanip>
-#include <sstream>
-#include <ctime>
 #include <pqxx/pqxx>
 
 namespace game_server {
 
     using json = nlohmann::json;
 
-    AuthApi::AuthApi(DbPool* db_pool)
-        : db_pool_(db_pool)
+    AuthApi::AuthApi(DbPool* db_pool, const auth::TokenSigner& token_signer)
+        : db_pool_(db_pool),
+        token_signer_(token_signer)
     {
     }
 
@@ -135,14 +132,15 @@ namespace game_server {
             // Get database connection
             auto conn = db_pool_->get_connection();
 
-            // Authenticate user
+            // Authenticate user (compare the stored hash in constant time)
             pqxx::work txn(*conn);
             pqxx::result result = txn.exec_params(
-                "SELECT user_id, username, rating, total_games, total_wins "
-                "FROM Users WHERE username = $1 AND password = $2",
-                username, hashed_password);
+                "SELECT user_id, username, rating, total_games, total_wins, password "
+                "FROM Users WHERE username = $1",
+                username);
 
-            if (result.empty()) {
+            if (result.empty() ||
+                !crypto::constantTimeEquals(result[0][5].as<std::string>(), hashed_password)) {
                 txn.abort();
                 json error_response = {
                     {"status", "error"},
@@ -161,6 +159,13 @@ namespace game_server {
 
             // Generate auth token
             std::string auth_token = generate_auth_token(user_id, username);
+            if (auth_token.empty()) {
+                json error_response = {
+                    {"status", "error"},
+                    {"message", "Failed to issue auth token"}
+                };
+                return error_response.dump();
+            }
 
             // Create success response
             json success_response = {
@@ -198,55 +203,23 @@ namespace game_server {
 
     std::string AuthApi::generate_auth_token(int user_id, const std::string& username)
     {
-        // NOTE: In production, use a proper JWT or token library
-        // This is a simplified example
-
-        std::stringstream ss;
-        std::time_t now = std::time(nullptr);
-
-        // Create payload
-        json payload = {
-            {"user_id", user_id},
-            {"username", username},
-            {"exp", now + 3600}, // Expires in 1 hour
-            {"iat", now}
-        };
-
-        // Simple hashing (use a secure library in production)
-        unsigned char hmac[SHA256_DIGEST_LENGTH];
-
-        // SECURITY NOTE: In production, this key should be stored securely in env variables
-        std::string secret_key = "your_secret_key_here";
-        std::string data_to_hash = payload.dump();
-
-        HMAC(EVP_sha256(), secret_key.c_str(), secret_key.length(),
-            reinterpret_cast<const unsigned char*>(data_to_hash.c_str()), data_to_hash.length(),
-            hmac, nullptr);
-
-        // Convert binary to hex string
-        std::stringstream signature;
-        for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-            signature << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hmac[i]);
+        // Signed binary token (key id, user id, expiry) shared with MatchingServer.
+        // Any server configured with the same keys can verify it without a database lookup.
+        try {
+            return token_signer_.issue(user_id).str();
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Failed to issue auth token for {}: {}", username, e.what());
+            return "";
         }
-
-        // Create token: base64(header).base64(payload).base64(signature)
-        // Simplified for this example: JSON payload + signature
-        return payload.dump() + "." + signature.str();
     }
 
     std::string AuthApi::hash_password(const std::string& password)
     {
         // SECURITY NOTE: In production, use bcrypt, scrypt, or Argon2 for secure password hashing
         // This is a basic SHA-256 example only suitable for demonstration
-        unsigned char hash[SHA256_DIGEST_LENGTH];
-        SHA256(reinterpret_cast<const unsigned char*>(password.c_str()), password.length(), hash);
-
-        std::stringstream ss;
-        for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-            ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
-        }
-
-        return ss.str();
+        auto hex = crypto::toHex(crypto::sha256(password));
+        return std::string(hex.data(), hex.size());
     }
 
 } // namespace game_server
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "api_handler.h"
 #include "../db/db_pool.h"
+#include "auth/signed_token.h"
 #include <string>
 #include <nlohmann/json.hpp>
 
@@ -9,7 +10,7 @@ namespace game_server {
 
     class AuthApi : public ApiHandler {
     public:
-        explicit AuthApi(DbPool* db_pool);
+        AuthApi(DbPool* db_pool, const auth::TokenSigner& token_signer);
 
         std::string handle_request(
             const nlohmann::json& request,
@@ -25,6 +26,7 @@ namespace game_server {
         std::string hash_password(const std::string& password);
 
         DbPool* db_pool_;
+        const auth::TokenSigner& token_signer_;
     };
 
 } // namespace game_server
\ No newline at end of file
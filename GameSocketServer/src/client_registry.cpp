@@ -0,0 +1,73 @@
+#include "client_registry.h"
+#include "websocket_session.h"
+#include <vector>
+
+namespace game_server {
+
+    std::shared_ptr<WebSocketSession> ClientRegistry::attach(int user_id, const std::shared_ptr<WebSocketSession>& session)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::weak_ptr<WebSocketSession>& entry = clients_[user_id];
+        std::shared_ptr<WebSocketSession> previous = entry.lock();
+        entry = session;
+        return previous == session ? nullptr : previous;
+    }
+
+    void ClientRegistry::detach(int user_id, const WebSocketSession* session)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = clients_.find(user_id);
+        if (it == clients_.end()) {
+            return;
+        }
+        // Called from the session destructor, where the entry has already expired
+        std::shared_ptr<WebSocketSession> current = it->second.lock();
+        if (!current || current.get() == session) {
+            clients_.erase(it);
+        }
+    }
+
+    bool ClientRegistry::push(int user_id, const std::string& message)
+    {
+        std::shared_ptr<WebSocketSession> session;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = clients_.find(user_id);
+            if (it != clients_.end()) {
+                session = it->second.lock();
+            }
+        }
+        if (!session) {
+            return false;
+        }
+        session->send(message);
+        return true;
+    }
+
+    std::size_t ClientRegistry::broadcast(const std::string& message)
+    {
+        std::vector<std::shared_ptr<WebSocketSession>> sessions;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sessions.reserve(clients_.size());
+            for (const auto& [user_id, entry] : clients_) {
+                if (auto session = entry.lock()) {
+                    sessions.push_back(std::move(session));
+                }
+            }
+        }
+        // Each session copies the message into its own queue; share one buffer instead
+        auto shared = std::make_shared<const std::string>(message);
+        for (const auto& session : sessions) {
+            session->send(shared);
+        }
+        return sessions.size();
+    }
+
+    std::size_t ClientRegistry::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return clients_.size();
+    }
+
+} // namespace game_server
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace game_server {
+
+    class WebSocketSession;
+
+    // Authenticated WebSocket connections by user, one persistent connection per game client.
+    // Used to push messages to a user without a pending request.
+    class ClientRegistry {
+    public:
+        // Register the connection for user_id; returns the connection it replaces (to be closed), if any
+        std::shared_ptr<WebSocketSession> attach(int user_id, const std::shared_ptr<WebSocketSession>& session);
+
+        // Remove the entry unless a newer connection has replaced it
+        void detach(int user_id, const WebSocketSession* session);
+
+        // Queue a message to the user's connection; false if the user is not connected
+        bool push(int user_id, const std::string& message);
+
+        // Queue a message to every connected user; returns the number of connections
+        std::size_t broadcast(const std::string& message);
+
+        std::size_t size() const;
+
+    private:
+        mutable std::mutex mutex_;
+        std::unordered_map<int, std::weak_ptr<WebSocketSession>> clients_;
+    };
+
+} // namespace game_server
@@ -4,6 +4,9 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <csignal>
+#include <fstream>
+#include <functional>
+#include <nlohmann/json.hpp>
 
 // Global server variable (for signal handler)
 std::unique_ptr<game_server::Server> server;
@@ -18,6 +21,29 @@ void signal_handler(int signal)
     exit(signal);
 }
 
+// Load the optional JSON config file (token signing keys, etc.)
+nlohmann::json load_config(const std::string& path)
+{
+    if (path.empty()) {
+        return nlohmann::json::object();
+    }
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        spdlog::warn("Config file {} not found, using defaults", path);
+        return nlohmann::json::object();
+    }
+
+    try {
+        nlohmann::json config = nlohmann::json::parse(file);
+        return config.is_object() ? config : nlohmann::json::object();
+    }
+    catch (const std::exception& e) {
+        spdlog::error("Failed to parse config file {}: {}", path, e.what());
+        return nlohmann::json::object();
+    }
+}
+
 int main(int argc, char* argv[])
 {
     try {
@@ -35,6 +61,7 @@ int main(int argc, char* argv[])
         short port = 8080;
         std::string db_connection_string =
             "dbname=GameData user=admin password=admin host=localhost port=5432";
+        std::string config_path;
 
         // Process command line arguments
         for (int i = 1; i < argc; ++i) {
@@ -45,11 +72,15 @@ int main(int argc, char* argv[])
             else if (arg == "--db" && i + 1 < argc) {
                 db_connection_string = argv[++i];
             }
+            else if (arg == "--config" && i + 1 < argc) {
+                config_path = argv[++i];
+            }
             else if (arg == "--help") {
                 std::cout << "Usage: " << argv[0] << " [options]\n"
                     << "Options:\n"
                     << "  --port PORT       Server port (default: 8080)\n"
                     << "  --db CONNSTRING   Database connection string\n"
+                    << "  --config PATH     JSON config file (token signing keys, request limits, websocket)\n"
                     << "  --help            Show this help message\n";
                 return 0;
             }
@@ -58,7 +89,22 @@ int main(int argc, char* argv[])
         // Create IO context and server
         boost::asio::io_context io_context;
         server = std::make_unique<game_server::Server>(
-            io_context, port, db_connection_string);
+            io_context, port, db_connection_string, load_config(config_path));
+
+#ifndef _WIN32
+        // SIGHUP reloads the config file and rotates token signing keys
+        boost::asio::signal_set reload_signals(io_context, SIGHUP);
+        std::function<void()> wait_reload;
+        wait_reload = [&]() {
+            reload_signals.async_wait([&](const boost::system::error_code& ec, int /*signal*/) {
+                if (ec) return;
+                spdlog::info("Received SIGHUP, reloading token signing keys");
+                server->reload_token_keys(load_config(config_path));
+                wait_reload();
+            });
+        };
+        wait_reload();
+#endif
 
         // Run server
         server->run();
@@ -7,18 +7,27 @@ namespace game_server {
 
     Server::Server(boost::asio::io_context& io_context,
         short port,
-        const std::string& db_connection_string)
+        const std::string& db_connection_string,
+        const nlohmann::json& config)
         : io_context_(io_context),
         acceptor_(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)),
+        token_signer_(auth::TokenKeyConfig::fromJson(config.value("sessionToken", nlohmann::json::object()))),
+        request_limits_(protocol::RequestLimits::fromJson(config.value("requestLimits", nlohmann::json::object()))),
+        router_(api_handlers_, token_signer_, request_limits_),
+        websocket_config_(WebSocketConfig::fromJson(config.value("websocket", nlohmann::json::object()))),
         running_(false)
     {
         // 데이터베이스 연결 풀 초기화
         db_pool_ = std::make_unique<DbPool>(db_connection_string, 5); // 5개의 연결 생성
 
         // API 핸들러 등록
-        api_handlers_["auth"] = std::make_shared<AuthApi>(db_pool_.get());
+        api_handlers_["auth"] = std::make_shared<AuthApi>(db_pool_.get(), token_signer_);
 
         std::cout << "Server initialized on port " << port << std::endl;
+        if (websocket_config_.enabled) {
+            std::cout << "WebSocket endpoint: " << websocket_config_.path
+                << (websocket_config_.permessage_deflate ? " (permessage-deflate)" : "") << std::endl;
+        }
     }
 
     Server::~Server()
@@ -42,13 +51,23 @@ namespace game_server {
         std::cout << "Server stopped" << std::endl;
     }
 
+    unsigned short Server::local_port() const
+    {
+        return acceptor_.local_endpoint().port();
+    }
+
+    void Server::reload_token_keys(const nlohmann::json& config)
+    {
+        token_signer_.rotate(auth::TokenKeyConfig::fromJson(config.value("sessionToken", nlohmann::json::object())));
+    }
+
     void Server::do_accept()
     {
         acceptor_.async_accept(
             [this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
                 if (!ec) {
                     // 새 세션 생성 및 시작
-                    std::make_shared<Session>(std::move(socket), api_handlers_)->start();
+                    std::make_shared<Session>(std::move(socket), router_, websocket_config_, clients_)->start();
                 }
 
                 // 계속해서 연결 수락 (서버가 실행 중인 경우)
@@ -7,6 +7,12 @@
 #include <functional>
 #include "db/db_pool.h"
 #include "api/api_handler.h"
+#include "auth/signed_token.h"
+#include "protocol/request_limits.h"
+#include "api/api_router.h"
+#include "client_registry.h"
+#include "websocket_session.h"
+#include <nlohmann/json.hpp>
 
 namespace game_server {
 
@@ -16,20 +22,38 @@ namespace game_server {
     public:
         Server(boost::asio::io_context& io_context,
             short port,
-            const std::string& db_connection_string);
+            const std::string& db_connection_string,
+            const nlohmann::json& config = nlohmann::json::object());
 
         ~Server();
 
         void run();
         void stop();
 
+        // Bound port (useful when constructed with port 0)
+        unsigned short local_port() const;
+
+        // Rotate token signing keys from the "sessionToken" config section
+        void reload_token_keys(const nlohmann::json& config);
+
+        // Connected WebSocket clients by user, for pushing messages without a request
+        ClientRegistry& clients() { return clients_; }
+
     private:
         void do_accept();
 
         boost::asio::io_context& io_context_;
         boost::asio::ip::tcp::acceptor acceptor_;
         std::unique_ptr<DbPool> db_pool_;
+        auth::TokenSigner token_signer_;
+        // Request size/depth/field limits from the "requestLimits" config section
+        protocol::RequestLimits request_limits_;
         std::map<std::string, std::shared_ptr<ApiHandler>> api_handlers_;
+        // Shared by HTTP requests and WebSocket messages
+        ApiRouter router_;
+        // "websocket" config section
+        WebSocketConfig websocket_config_;
+        ClientRegistry clients_;
         bool running_;
     };
 
@@ -1,4 +1,6 @@
 #include "session.h"
+#include "client_registry.h"
+#include <chrono>
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
@@ -6,198 +8,164 @@
 namespace game_server {
 
     using json = nlohmann::json;
+    namespace beast = boost::beast;
+    namespace http = boost::beast::http;
+    namespace websocket = boost::beast::websocket;
+
+    namespace {
+        // Request line + header fields bound (one read buffer in the previous implementation)
+        constexpr std::uint32_t kMaxHeaderBytes = 8192;
+        // Keep-alive connections with no complete request for this long are closed
+        constexpr std::chrono::seconds kIdleTimeout(30);
+    }
 
     Session::Session(boost::asio::ip::tcp::socket socket,
-        std::map<std::string, std::shared_ptr<ApiHandler>>& api_handlers)
-        : socket_(std::move(socket)),
-        api_handlers_(api_handlers),
-        user_id_(0)
+        const ApiRouter& router,
+        const WebSocketConfig& websocket,
+        ClientRegistry& clients)
+        : stream_(std::move(socket)),
+        router_(router),
+        websocket_(websocket),
+        clients_(clients)
     {
-        spdlog::info("New session created from {}:{}",
-            socket_.remote_endpoint().address().to_string(),
-            socket_.remote_endpoint().port());
+        boost::system::error_code ec;
+        auto endpoint = stream_.socket().remote_endpoint(ec);
+        spdlog::info("New session created from {}:{}", endpoint.address().to_string(), endpoint.port());
     }
 
     void Session::start()
     {
-        read_header();
+        read_request();
     }
 
-    void Session::read_header()
+    void Session::read_request()
     {
         auto self = shared_from_this();
 
-        // Read HTTP header or handle WebSocket protocol
-        // Here we assume HTTP-based JSON API for simplicity
-        socket_.async_read_some(
-            boost::asio::buffer(buffer_),
-            [this, self](boost::system::error_code ec, std::size_t length) {
-                if (!ec) {
-                    // Simple HTTP header parsing (find Content-Length)
-                    std::string header(buffer_.data(), length);
-                    std::size_t content_length = 0;
-
-                    // Find Content-Length header
-                    std::string cl_header = "Content-Length: ";
-                    auto pos = header.find(cl_header);
-                    if (pos != std::string::npos) {
-                        auto end_pos = header.find("\r\n", pos);
-                        if (end_pos != std::string::npos) {
-                            std::string length_str = header.substr(pos + cl_header.length(),
-                                end_pos - (pos + cl_header.length()));
-                            content_length = std::stoul(length_str);
-                        }
-                    }
-
-                    // Find body and header separator
-                    auto body_start = header.find("\r\n\r\n");
-                    if (body_start != std::string::npos) {
-                        body_start += 4; // Start of body after "\r\n\r\n"
-
-                        // Already received part of the body
-                        std::string body_part = header.substr(body_start);
-
-                        if (body_part.length() >= content_length) {
-                            // Body already fully received
-                            process_request(body_part.substr(0, content_length));
-                        }
-                        else {
-                            // Need to read more body data
-                            message_ = body_part;
-                            read_body(content_length - body_part.length());
-                        }
-                    }
-                }
-                else {
-                    handle_error("Error reading header: " + ec.message());
+        parser_.emplace();
+        parser_->header_limit(kMaxHeaderBytes);
+        parser_->body_limit(router_.limits().max_message_bytes);
+        stream_.expires_after(kIdleTimeout);
+
+        // Reads exactly one request; pipelined bytes after it remain in buffer_
+        http::async_read(stream_, buffer_, *parser_,
+            [this, self](beast::error_code ec, std::size_t /*length*/) {
+                if (ec) {
+                    handle_read_error(ec);
+                    return;
                 }
+                handle_request();
             });
     }
 
-    void Session::read_body(std::size_t remaining_length)
+    void Session::handle_request()
     {
-        auto self = shared_from_this();
+        http::request<http::string_body>& request = parser_->get();
 
-        socket_.async_read_some(
-            boost::asio::buffer(buffer_),
-            [this, self, remaining_length](boost::system::error_code ec, std::size_t length) {
-                if (!ec) {
-                    message_.append(buffer_.data(), length);
-
-                    if (length >= remaining_length) {
-                        // Body fully received
-                        process_request(message_);
-                    }
-                    else {
-                        // Need to read more
-                        read_body(remaining_length - length);
-                    }
-                }
-                else {
-                    handle_error("Error reading body: " + ec.message());
-                }
-            });
-    }
-
-    void Session::process_request(const std::string& request_data)
-    {
-        try {
-            // Parse JSON
-            json request = json::parse(request_data);
-
-            // Route to API
-            std::string action = request["action"];
-            std::string api_type;
-
-            if (action == "register" || action == "login") {
-                api_type = "auth";
-            }
-            else {
-                // Add routing for other API actions
-                spdlog::warn("Unknown action: {}", action);
+        if (websocket::is_upgrade(request)) {
+            if (!websocket_.enabled || request.target() != websocket_.path) {
+                spdlog::warn("Refused WebSocket upgrade to {}", std::string(request.target()));
                 json error_response = {
                     {"status", "error"},
-                    {"message", "Unknown action"}
+                    {"message", "WebSocket endpoint not found"}
                 };
-                write_response(error_response.dump());
+                write_response(http::status::not_found, error_response.dump(), false);
                 return;
             }
 
-            // Find appropriate API handler
-            auto handler_it = api_handlers_.find(api_type);
-            if (handler_it != api_handlers_.end()) {
-                // Forward request to API handler
-                std::string response = handler_it->second->handle_request(request, user_id_, auth_token_);
-
-                // Update authentication info (on successful login)
-                if (action == "login" && json::parse(response)["status"] == "success") {
-                    json resp_json = json::parse(response);
-                    user_id_ = resp_json["user_id"];
-                    if (resp_json.contains("token")) {
-                        auth_token_ = resp_json["token"];
-                    }
-                    spdlog::info("User {} logged in", user_id_);
-                }
-
-                write_response(response);
-            }
-            else {
-                spdlog::error("API handler not found for type: {}", api_type);
-                json error_response = {
-                    {"status", "error"},
-                    {"message", "Internal server error"}
-                };
-                write_response(error_response.dump());
-            }
-        }
-        catch (const std::exception& e) {
-            spdlog::error("Error processing request: {}", e.what());
-            json error_response = {
-                {"status", "error"},
-                {"message", "Invalid request format"}
-            };
-            write_response(error_response.dump());
+            // The connection now belongs to the WebSocket session
+            stream_.expires_never();
+            std::make_shared<WebSocketSession>(stream_.release_socket(), router_, websocket_, clients_)
+                ->run(parser_->release());
+            return;
         }
+
+        ApiRouter::Reply reply = router_.dispatch(request.body(), client_);
+        write_response(reply.rejected ? http::status::bad_request : http::status::ok,
+            std::move(reply.body), request.keep_alive());
     }
 
-    void Session::write_response(const std::string& response)
+    void Session::write_response(http::status status, std::string body, bool keep_alive)
     {
         auto self = shared_from_this();
 
-        // Create HTTP response header
-        std::string response_header =
-            "HTTP/1.1 200 OK\r\n"
-            "Content-Type: application/json\r\n"
-            "Content-Length: " + std::to_string(response.length()) + "\r\n"
-            "Connection: keep-alive\r\n"
-            "\r\n";
-
-        std::string full_response = response_header + response;
-
-        boost::asio::async_write(
-            socket_,
-            boost::asio::buffer(full_response),
-            [this, self](boost::system::error_code ec, std::size_t /*length*/) {
-                if (!ec) {
-                    // After response, wait for next request
-                    read_header();
+        response_ = {};
+        response_.result(status);
+        response_.version(11);
+        response_.set(http::field::server, "GameSocketServer");
+        response_.set(http::field::content_type, "application/json");
+        response_.keep_alive(keep_alive);
+        response_.body() = std::move(body);
+        response_.prepare_payload();
+
+        http::async_write(stream_, response_,
+            [this, self, keep_alive](beast::error_code ec, std::size_t /*length*/) {
+                if (ec) {
+                    handle_error("Error writing response: " + ec.message());
+                }
+                else if (!keep_alive) {
+                    close_socket();
                 }
                 else {
-                    handle_error("Error writing response: " + ec.message());
+                    // After response, handle the next pipelined request or wait for one
+                    read_request();
                 }
             });
     }
 
+    void Session::reject(protocol::LimitViolation reason, http::status status, const std::string& detail)
+    {
+        std::uint64_t count = ApiRouter::count_rejection(reason);
+        spdlog::warn("Rejected request: {} - {} ({} total)", protocol::toString(reason), detail, count);
+
+        // Framing can no longer be trusted, so answer and close instead of reading on
+        write_response(status, ApiRouter::rejection_body(reason), false);
+    }
+
+    void Session::handle_read_error(beast::error_code ec)
+    {
+        if (ec == http::error::end_of_stream || ec == boost::asio::error::eof ||
+            ec == boost::asio::error::connection_reset) {
+            spdlog::info("Client closed connection");
+            close_socket();
+        }
+        else if (ec == beast::error::timeout) {
+            spdlog::info("Closing idle connection");
+            close_socket();
+        }
+        else if (ec == http::error::header_limit) {
+            reject(protocol::LimitViolation::MessageTooLarge, http::status::request_header_fields_too_large,
+                "header exceeds " + std::to_string(kMaxHeaderBytes) + " bytes");
+        }
+        else if (ec == http::error::body_limit) {
+            reject(protocol::LimitViolation::MessageTooLarge, http::status::payload_too_large,
+                "body exceeds " + std::to_string(router_.limits().max_message_bytes) + " bytes");
+        }
+        else if (ec.category() == beast::http::make_error_code(http::error::bad_method).category()) {
+            // Malformed request line, header, Content-Length or chunk framing
+            reject(protocol::LimitViolation::Malformed, http::status::bad_request, ec.message());
+        }
+        else {
+            handle_error("Error reading request: " + ec.message());
+        }
+    }
+
     void Session::handle_error(const std::string& error_message)
     {
         // Log the error
         spdlog::error(error_message);
 
+        close_socket();
+    }
+
+    void Session::close_socket()
+    {
         // Clean up resources if needed
-        if (socket_.is_open()) {
+        auto& socket = stream_.socket();
+        if (socket.is_open()) {
             boost::system::error_code ec;
-            socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
-            socket_.close(ec);
+            socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+            socket.close(ec);
 
             if (ec) {
                 spdlog::error("Error closing socket: {}", ec.message());
@@ -205,4 +173,4 @@ namespace game_server {
         }
     }
 
-} // namespace game_server
\ No newline at end of file
+} // namespace game_server
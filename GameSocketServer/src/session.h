@@ -1,35 +1,48 @@
 #pragma once
 
 #include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
 #include <memory>
+#include <optional>
 #include <string>
-#include <deque>
-#include <map>
-#include <array>
-#include "api/api_handler.h"
+#include "api/api_router.h"
+#include "websocket_session.h"
 
 namespace game_server {
 
+    class ClientRegistry;
+
+    // HTTP/1.1 connection: JSON API requests over keep-alive (pipelined requests are answered in order),
+    // or a WebSocket upgrade handed off to WebSocketSession
     class Session : public std::enable_shared_from_this<Session> {
     public:
         Session(boost::asio::ip::tcp::socket socket,
-            std::map<std::string, std::shared_ptr<ApiHandler>>& api_handlers);
+            const ApiRouter& router,
+            const WebSocketConfig& websocket,
+            ClientRegistry& clients);
 
         void start();
 
     private:
-        void read_header();
-        void read_body(std::size_t content_length);
-        void process_request(const std::string& request_data);
-        void write_response(const std::string& response);
+        void read_request();
+        void handle_request();
+        void write_response(boost::beast::http::status status, std::string body, bool keep_alive);
+        // Count the rejection, answer with an error status and close the connection
+        void reject(protocol::LimitViolation reason, boost::beast::http::status status, const std::string& detail);
+        void handle_read_error(boost::beast::error_code ec);
         void handle_error(const std::string& error_message);
+        void close_socket();
 
-        boost::asio::ip::tcp::socket socket_;
-        std::map<std::string, std::shared_ptr<ApiHandler>>& api_handlers_;
-        std::array<char, 8192> buffer_;
-        std::string message_;
-        int user_id_; // Authenticated user ID (0 = not authenticated)
-        std::string auth_token_; // Authentication token
+        boost::beast::tcp_stream stream_;
+        boost::beast::flat_buffer buffer_;  // Bytes past the current request stay here for the next one
+        // Beast parsers handle one message each, so a fresh one is made per request
+        std::optional<boost::beast::http::request_parser<boost::beast::http::string_body>> parser_;
+        boost::beast::http::response<boost::beast::http::string_body> response_; // Owned until written
+        const ApiRouter& router_;
+        const WebSocketConfig& websocket_;
+        ClientRegistry& clients_;
+        ClientState client_;
     };
 
-} // namespace game_server
\ No newline at end of file
+} // namespace game_server
@@ -0,0 +1,207 @@
+#include "websocket_session.h"
+#include "client_registry.h"
+#include <algorithm>
+#include <iterator>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    namespace beast = boost::beast;
+    namespace http = boost::beast::http;
+    namespace websocket = boost::beast::websocket;
+    namespace net = boost::asio;
+
+    WebSocketConfig WebSocketConfig::fromJson(const nlohmann::json& config)
+    {
+        WebSocketConfig result;
+        if (!config.is_object()) return result;
+        result.enabled = config.value("enabled", result.enabled);
+        result.path = config.value("path", result.path);
+        result.permessage_deflate = config.value("permessageDeflate", result.permessage_deflate);
+        result.compression_level = std::clamp(config.value("compressionLevel", result.compression_level), 0, 9);
+        result.window_bits = std::clamp(config.value("windowBits", result.window_bits), 9, 15);
+        result.idle_timeout_seconds = std::max(1, config.value("idleTimeoutSeconds", result.idle_timeout_seconds));
+        result.max_queued_messages = std::max<std::size_t>(1, config.value("maxQueuedMessages", result.max_queued_messages));
+        return result;
+    }
+
+    WebSocketSession::WebSocketSession(net::ip::tcp::socket socket,
+        const ApiRouter& router,
+        const WebSocketConfig& config,
+        ClientRegistry& clients)
+        : ws_(std::move(socket)),
+        router_(router),
+        config_(config),
+        clients_(clients)
+    {
+    }
+
+    WebSocketSession::~WebSocketSession()
+    {
+        if (registered_user_id_ > 0) {
+            clients_.detach(registered_user_id_, this);
+        }
+    }
+
+    void WebSocketSession::run(http::request<http::string_body> upgrade)
+    {
+        // The websocket stream keeps its own handshake/idle timers, so the TCP layer must not time out
+        beast::get_lowest_layer(ws_).expires_never();
+
+        auto timeouts = websocket::stream_base::timeout::suggested(beast::role_type::server);
+        timeouts.idle_timeout = std::chrono::seconds(config_.idle_timeout_seconds);
+        timeouts.keep_alive_pings = true;
+        ws_.set_option(timeouts);
+
+        if (config_.permessage_deflate) {
+            websocket::permessage_deflate deflate;
+            deflate.server_enable = true;
+            deflate.compLevel = config_.compression_level;
+            deflate.server_max_window_bits = config_.window_bits;
+            ws_.set_option(deflate);
+        }
+
+        ws_.set_option(websocket::stream_base::decorator([](websocket::response_type& response) {
+            response.set(http::field::server, "GameSocketServer");
+        }));
+
+        // Same per-message bound as HTTP bodies; larger frames fail the read before being buffered
+        ws_.read_message_max(router_.limits().max_message_bytes);
+
+        auto self = shared_from_this();
+        ws_.async_accept(upgrade, [this, self](beast::error_code ec) {
+            if (ec) {
+                handle_error("accepting", ec);
+                return;
+            }
+            spdlog::info("WebSocket session opened from {}",
+                beast::get_lowest_layer(ws_).socket().remote_endpoint(ec).address().to_string());
+            read_message();
+        });
+    }
+
+    void WebSocketSession::read_message()
+    {
+        auto self = shared_from_this();
+        ws_.async_read(buffer_, [this, self](beast::error_code ec, std::size_t /*length*/) {
+            if (ec) {
+                handle_error("reading", ec);
+                return;
+            }
+            handle_message();
+            read_message();
+        });
+    }
+
+    void WebSocketSession::handle_message()
+    {
+        std::string request_data = beast::buffers_to_string(buffer_.data());
+        buffer_.consume(buffer_.size());
+
+        if (!ws_.got_text()) {
+            std::uint64_t count = ApiRouter::count_rejection(protocol::LimitViolation::Malformed);
+            spdlog::warn("Rejected request: binary WebSocket message ({} bytes, {} total)", request_data.size(), count);
+            enqueue(std::make_shared<const std::string>(ApiRouter::rejection_body(protocol::LimitViolation::Malformed)));
+            return;
+        }
+
+        ApiRouter::Reply reply = router_.dispatch(request_data, client_);
+
+        // Keep one persistent connection per authenticated user; a newer one replaces the old
+        if (client_.user_id != registered_user_id_) {
+            if (registered_user_id_ > 0) {
+                clients_.detach(registered_user_id_, this);
+            }
+            registered_user_id_ = client_.user_id;
+            if (registered_user_id_ > 0) {
+                if (auto previous = clients_.attach(registered_user_id_, shared_from_this())) {
+                    spdlog::info("User {} reconnected, closing previous WebSocket session", registered_user_id_);
+                    previous->close(websocket::close_code::policy_error, "replaced by a newer connection");
+                }
+            }
+        }
+
+        enqueue(std::make_shared<const std::string>(std::move(reply.body)));
+    }
+
+    void WebSocketSession::send(std::string message)
+    {
+        send(std::make_shared<const std::string>(std::move(message)));
+    }
+
+    void WebSocketSession::send(std::shared_ptr<const std::string> message)
+    {
+        // Run on the connection's executor so the queue is only touched there
+        net::post(ws_.get_executor(), [self = shared_from_this(), message = std::move(message)]() mutable {
+            self->enqueue(std::move(message));
+        });
+    }
+
+    void WebSocketSession::enqueue(std::shared_ptr<const std::string> message)
+    {
+        if (closing_) {
+            return;
+        }
+        if (write_queue_.size() >= config_.max_queued_messages) {
+            // The client is not reading; drop it rather than buffer without bound
+            spdlog::warn("WebSocket client {} has {} pending messages, closing", registered_user_id_, write_queue_.size());
+            closing_ = true;
+            // The front message is the one being written; its buffer must stay alive until the write
+            // handler runs (with operation_aborted after the close below), so only the rest is dropped
+            if (!write_queue_.empty()) {
+                write_queue_.erase(std::next(write_queue_.begin()), write_queue_.end());
+            }
+            beast::get_lowest_layer(ws_).close();
+            return;
+        }
+
+        write_queue_.push_back(std::move(message));
+        if (write_queue_.size() == 1) {
+            do_write();
+        }
+    }
+
+    void WebSocketSession::do_write()
+    {
+        auto self = shared_from_this();
+        ws_.text(true);
+        ws_.async_write(net::buffer(*write_queue_.front()), [this, self](beast::error_code ec, std::size_t /*length*/) {
+            if (ec) {
+                handle_error("writing", ec);
+                return;
+            }
+            write_queue_.pop_front();
+            if (!write_queue_.empty()) {
+                do_write();
+            }
+        });
+    }
+
+    void WebSocketSession::close(websocket::close_code code, const std::string& reason)
+    {
+        net::post(ws_.get_executor(), [self = shared_from_this(), code, reason]() {
+            if (self->closing_) {
+                return;
+            }
+            self->closing_ = true;
+            // The pending read completes with websocket::error::closed once the peer answers
+            self->ws_.async_close(websocket::close_reason(code, reason), [self](beast::error_code /*ec*/) {});
+        });
+    }
+
+    void WebSocketSession::handle_error(const char* operation, beast::error_code ec)
+    {
+        if (ec == websocket::error::closed || ec == net::error::operation_aborted || ec == net::error::eof) {
+            spdlog::info("WebSocket session closed (user {})", registered_user_id_);
+            return;
+        }
+        if (ec == websocket::error::message_too_big) {
+            std::uint64_t count = ApiRouter::count_rejection(protocol::LimitViolation::MessageTooLarge);
+            spdlog::warn("Rejected request: message_too_large - WebSocket message over {} bytes ({} total)",
+                router_.limits().max_message_bytes, count);
+            return;
+        }
+        spdlog::error("Error {} WebSocket: {}", operation, ec.message());
+    }
+
+} // namespace game_server
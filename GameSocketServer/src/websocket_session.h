@@ -0,0 +1,69 @@
+#pragma once
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/websocket.hpp>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "api/api_router.h"
+
+namespace game_server {
+
+    class ClientRegistry;
+
+    // "websocket" config section
+    struct WebSocketConfig {
+        bool enabled = true;
+        std::string path = "/ws";              // Upgrade requests to other targets are refused
+        bool permessage_deflate = true;        // Offer permessage-deflate (RFC 7692)
+        int compression_level = 6;             // Deflate level 0..9
+        int window_bits = 15;                  // Server max window bits 9..15, lower uses less memory per connection
+        int idle_timeout_seconds = 300;        // Silent connections are pinged halfway and closed at the limit
+        std::size_t max_queued_messages = 1024; // Outgoing messages a slow client may have pending before it is dropped
+
+        static WebSocketConfig fromJson(const nlohmann::json& config);
+    };
+
+    // Persistent WebSocket connection for a game client
+    // Each text message is one JSON API request answered with one message; replies and
+    // server pushes share the outgoing queue, so they are written in order.
+    class WebSocketSession : public std::enable_shared_from_this<WebSocketSession> {
+    public:
+        WebSocketSession(boost::asio::ip::tcp::socket socket,
+            const ApiRouter& router,
+            const WebSocketConfig& config,
+            ClientRegistry& clients);
+        ~WebSocketSession();
+
+        // Complete the handshake for an upgrade request already read by the HTTP session
+        void run(boost::beast::http::request<boost::beast::http::string_body> upgrade);
+
+        // Queue a text message; safe to call from any thread
+        void send(std::string message);
+        void send(std::shared_ptr<const std::string> message);
+
+        // Close with a reason (e.g. replaced by a newer connection); safe to call from any thread
+        void close(boost::beast::websocket::close_code code, const std::string& reason);
+
+    private:
+        void read_message();
+        void handle_message();
+        void enqueue(std::shared_ptr<const std::string> message);
+        void do_write();
+        void handle_error(const char* operation, boost::beast::error_code ec);
+
+        boost::beast::websocket::stream<boost::beast::tcp_stream> ws_;
+        boost::beast::flat_buffer buffer_;
+        std::deque<std::shared_ptr<const std::string>> write_queue_;
+        const ApiRouter& router_;
+        const WebSocketConfig& config_;
+        ClientRegistry& clients_;
+        ClientState client_;
+        int registered_user_id_ = 0;
+        bool closing_ = false;
+    };
+
+} // namespace game_server
@@ -0,0 +1,429 @@
+﻿// bench/micro_bench.cpp
+// 매칭 서버 마이크로벤치마크
+// JSON 요청/응답 처리, 비밀번호 해시, 입력 검증, DB 풀, 브로드캐스트 전송 비용을 측정
+// 세션 읽기/쓰기 완료 핸들러의 연산당 힙 할당 수도 세어, HandlerMemory 경로가 0이 아니면 실패(종료 코드 1)로 보고
+// 사용법: MatchingBench [--filter 이름] [--json 결과.json] [--min-time 초] [--repetitions 횟수]
+//        BENCH_DB_URL(libpq 연결 문자열)을 지정하면 DB 풀 항목도 실행
+#include "bench/bench_harness.h"
+#include "core/session.h"
+#include "util/db_pool.h"
+#include "util/password_util.h"
+#include "util/validation.h"
+#include "util/utf8.h"
+#include "util/handler_allocator.h"
+#include "crypto/crypto_util.h"
+#include "protocol/request_limits.h"
+#include <boost/asio.hpp>
+#include <openssl/sha.h>
+#include <pqxx/pqxx>
+#include <spdlog/spdlog.h>
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <new>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace game_server;
+using bench::doNotOptimize;
+
+namespace {
+    // 측정 구간에서만 세는 전역 operator new 호출 수 (측정하는 스레드 기준)
+    thread_local bool g_count_allocations = false;
+    thread_local std::uint64_t g_allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    if (g_count_allocations) {
+        ++g_allocations;
+    }
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+// 인라인되면 GCC가 operator new로 받은 포인터를 free한다고 -Wmismatched-new-delete 경고를 냄
+[[gnu::noinline]] void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+
+    // 실제 클라이언트가 보내는 요청 형태
+    const std::string kLoginRequest =
+        R"({"action":"login","userName":"player1234","password":"correct-horse-battery"})";
+    const std::string kCreateRoomRequest =
+        R"({"action":"createRoom","roomName":"즐거운 방 123","maxPlayers":8})";
+
+    json makeListRoomsResponse(int rooms) {
+        json response = {
+            {"action", "listRooms"},
+            {"status", "success"},
+            {"message", "방 목록을 성공적으로 가져왔습니다"},
+            {"rooms", json::array()}
+        };
+        for (int i = 0; i < rooms; ++i) {
+            response["rooms"].push_back({
+                {"roomId", 1000 + i},
+                {"roomName", "방" + std::to_string(i)},
+                {"hostId", 50 + i},
+                {"ipAddress", "10.0.0.12"},
+                {"port", 40000 + i},
+                {"maxPlayers", 8},
+                {"status", "WAITING"},
+                {"currentPlayers", i % 8}
+            });
+        }
+        return response;
+    }
+
+    json makeCcuList(int users) {
+        json broadcast = { {"action", "CCUList"}, {"users", json::array()} };
+        for (int i = 0; i < users; ++i) {
+            broadcast["users"].push_back({ {"userId", i + 1}, {"nickName", "user_" + std::to_string(i)} });
+        }
+        return broadcast;
+    }
+
+    // crypto 모듈 도입 전 방식 (SHA-256 + stringstream 16진수 변환 + 문자열 == 비교), 개선 폭 비교용
+    std::string legacyStreamHash(const std::string& password) {
+        unsigned char hash[SHA256_DIGEST_LENGTH];
+        SHA256(reinterpret_cast<const unsigned char*>(password.c_str()), password.length(), hash);
+        std::stringstream ss;
+        for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
+            ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(hash[i]);
+        }
+        return ss.str();
+    }
+
+    void benchJson(bench::Runner& runner) {
+        runner.run("json/parse login request", [&]() {
+            doNotOptimize(json::parse(kLoginRequest));
+            });
+        runner.run("json/parse createRoom request", [&]() {
+            doNotOptimize(json::parse(kCreateRoomRequest));
+            });
+
+        // 제한 검사 파싱(Session::parse_request)의 정상 요청 비용과, 깊게 중첩된 악성 요청을 기본 제한에서 거부하는 비용
+        const protocol::RequestLimits limits;
+        runner.run("json/parseBounded login request", [&]() {
+            json request;
+            doNotOptimize(protocol::parseBounded(kLoginRequest.data(), kLoginRequest.data() + kLoginRequest.size(), limits, request));
+            doNotOptimize(request);
+            });
+        const std::string nested = std::string(2000, '[') + std::string(2000, ']');
+        runner.run("json/parse nested 2000 (unbounded)", [&]() {
+            doNotOptimize(json::parse(nested));
+            });
+        runner.run("json/parseBounded nested 2000 (rejected)", [&]() {
+            json request;
+            doNotOptimize(protocol::parseBounded(nested.data(), nested.data() + nested.size(), limits, request));
+            });
+
+        json login_response = {
+            {"action", "login"}, {"status", "success"}, {"message", "로그인에 성공하였습니다."},
+            {"userId", 1234}, {"userName", "player1234"}, {"nickName", "플레이어1234"},
+            {"createdAt", "2025-04-12 10:00:00+09"}, {"lastLogin", "2025-04-12 10:00:00+09"},
+            {"sessionToken", "AQABAAAE0mf7c2AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA"}
+        };
+        runner.run("json/dump login response", [&]() {
+            doNotOptimize(login_response.dump());
+            });
+
+        json list_rooms = makeListRoomsResponse(20);
+        std::string list_rooms_text = list_rooms.dump();
+        runner.run("json/dump listRooms response (20 rooms)", [&]() {
+            doNotOptimize(list_rooms.dump());
+            });
+        runner.run("json/parse listRooms response (20 rooms)", [&]() {
+            doNotOptimize(json::parse(list_rooms_text));
+            });
+
+        runner.run("json/build+dump chat broadcast", [&]() {
+            json broadcast = { {"action", "chat"}, {"nickName", "플레이어1234"}, {"message", "안녕하세요 같이 하실 분"} };
+            doNotOptimize(broadcast.dump());
+            });
+
+        json ccu = makeCcuList(200);
+        runner.run("json/dump CCUList (200 users)", [&]() {
+            doNotOptimize(ccu.dump());
+            });
+    }
+
+    void benchPassword(bench::Runner& runner) {
+        const std::string password = "correct-horse-battery";
+
+        // 하드웨어별 scrypt 비용 조정용 (기본값 ln=14, 로그인 1회의 검증 비용과 같음)
+        for (std::uint32_t log_n : { 12u, 14u, 15u }) {
+            PasswordHashConfig config;
+            config.log_n = log_n;
+            PasswordUtil::configure(config);
+            runner.run("password/scrypt hash ln=" + std::to_string(log_n) + " r=8 p=1", [&]() {
+                doNotOptimize(PasswordUtil::hashPassword(password));
+                });
+        }
+        PasswordUtil::configure(PasswordHashConfig{});
+
+        std::string scrypt_hash = PasswordUtil::hashPassword(password);
+        runner.run("password/scrypt verify (default cost)", [&]() {
+            doNotOptimize(PasswordUtil::verifyPassword(password, scrypt_hash));
+            });
+
+        // 이전 SHA-256 형식 검증: 공용 crypto 모듈 사용 전후
+        std::string legacy_hash = legacyStreamHash(password);
+        runner.run("password/legacy sha256 verify (stringstream, before)", [&]() {
+            doNotOptimize(legacyStreamHash(password) == legacy_hash);
+            });
+        runner.run("password/legacy sha256 verify (crypto util)", [&]() {
+            doNotOptimize(PasswordUtil::verifyPassword(password, legacy_hash));
+            });
+
+        runner.run("crypto/sha256 + hex (stack buffer)", [&]() {
+            doNotOptimize(crypto::toHex(crypto::sha256(password)));
+            });
+        runner.run("crypto/constantTimeEquals 64B", [&]() {
+            doNotOptimize(crypto::constantTimeEquals(legacy_hash, legacy_hash));
+            });
+    }
+
+    // utf8 검증기 도입 전 방식 (호출마다 std::regex 생성), 개선 폭 비교용
+    bool legacyRegexNickName(const std::string& str) {
+        if (str.size() > 24) return false;
+        std::regex pattern("^[가-힣A-Za-z0-9]+$");
+        return std::regex_match(str, pattern);
+    }
+
+    void benchValidation(bench::Runner& runner) {
+        const std::string nick_hangul = "플레이어Player1";
+        const std::string nick_ascii = "PlayerOne2024";
+        const std::string room = "즐거운 방 123";
+        const std::string user = "player1234";
+
+        runner.run("validation/nickname regex hangul+ascii (before)", [&]() {
+            doNotOptimize(legacyRegexNickName(nick_hangul));
+            });
+        runner.run("validation/nickname regex ascii (before)", [&]() {
+            doNotOptimize(legacyRegexNickName(nick_ascii));
+            });
+        runner.run("validation/isValidNickName hangul+ascii", [&]() {
+            doNotOptimize(isValidNickName(nick_hangul));
+            });
+        runner.run("validation/isValidNickName ascii", [&]() {
+            doNotOptimize(isValidNickName(nick_ascii));
+            });
+        runner.run("validation/isValidRoomName", [&]() {
+            doNotOptimize(isValidRoomName(room));
+            });
+        runner.run("validation/isValidUserName", [&]() {
+            doNotOptimize(isValidUserName(user));
+            });
+
+        // 길이 제한 없는 검사 자체의 처리량 (ASCII 구간은 16바이트씩, 한글은 표 기반 디코딩)
+        std::string ascii_text(4096, 'a');
+        std::string hangul_text;
+        for (int i = 0; i < 1024; ++i) hangul_text += "한";
+        runner.run("utf8/consistsOf ascii 4KB", [&]() {
+            doNotOptimize(utf8::consistsOf(ascii_text, utf8::kAsciiAlnum));
+            });
+        runner.run("utf8/consistsOf hangul 3KB", [&]() {
+            doNotOptimize(utf8::consistsOf(hangul_text, utf8::kHangulSyllable));
+            });
+        runner.run("utf8/isValid ascii 4KB", [&]() {
+            doNotOptimize(utf8::isValid(ascii_text));
+            });
+    }
+
+    void benchDbPool(bench::Runner& runner) {
+        const char* url = std::getenv("BENCH_DB_URL");
+        if (!url || !*url) {
+            runner.skip("dbpool/acquire+release", "BENCH_DB_URL 미지정");
+            runner.skip("dbpool/acquire+SELECT 1+release", "BENCH_DB_URL 미지정");
+            return;
+        }
+        if (!runner.enabled("dbpool/")) return;
+
+        DbPool pool(url, 4);
+        runner.run("dbpool/acquire+release", [&]() {
+            auto conn = pool.get_connection();
+            doNotOptimize(conn.get());
+            pool.return_connection(std::move(conn));
+            });
+        runner.run("dbpool/acquire+SELECT 1+release", [&]() {
+            auto conn = pool.get_connection();
+            {
+                pqxx::nontransaction ntx(*conn);
+                doNotOptimize(ntx.exec("SELECT 1").size());
+            }
+            pool.return_connection(std::move(conn));
+            });
+    }
+
+    // 대기실 브로드캐스트(Server::broadcastActiveUser)와 같은 경로로 세션 N개에 같은 메시지를 보내고 모두 전송될 때까지 측정
+    // 세션은 루프백 연결의 서버 쪽 소켓으로 만들고, 클라이언트 쪽은 받은 바이트 수만 센다.
+    void benchBroadcast(bench::Runner& runner, std::size_t fanout) {
+        std::string name = "broadcast/chat fan-out " + std::to_string(fanout) + " sessions";
+        if (!runner.enabled(name)) return;
+
+        boost::asio::io_context io_context;
+        boost::asio::ip::tcp::acceptor acceptor(io_context,
+            boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0));
+        std::map<std::string, std::shared_ptr<Controller>> controllers;
+
+        std::vector<std::shared_ptr<Session>> sessions;
+        std::vector<std::unique_ptr<boost::asio::ip::tcp::socket>> clients;
+        std::vector<std::array<char, 16384>> buffers(fanout);
+        std::size_t received = 0;
+
+        std::function<void(std::size_t)> drain = [&](std::size_t index) {
+            clients[index]->async_read_some(boost::asio::buffer(buffers[index]),
+                [&, index](boost::system::error_code ec, std::size_t length) {
+                    if (ec) return;
+                    received += length;
+                    drain(index);
+                });
+        };
+
+        for (std::size_t i = 0; i < fanout; ++i) {
+            auto client = std::make_unique<boost::asio::ip::tcp::socket>(io_context);
+            client->connect(acceptor.local_endpoint());
+            boost::asio::ip::tcp::socket server_side = acceptor.accept();
+            // 서버 없이 만든 세션 (등록/정리 없이 쓰기 경로만 사용)
+            sessions.push_back(std::allocate_shared<Session>(SessionAllocator(), std::move(server_side), controllers, nullptr));
+            clients.push_back(std::move(client));
+            drain(i);
+        }
+
+        json broadcast = { {"action", "chat"}, {"nickName", "플레이어1234"}, {"message", "안녕하세요 같이 하실 분"} };
+        std::string message = broadcast.dump();
+        std::size_t expected = 0;
+
+        runner.run(name, [&]() {
+            for (const auto& session : sessions) {
+                session->write_broadcast(message);
+            }
+            expected += message.size() * sessions.size();
+            while (received < expected) {
+                io_context.run_one();
+            }
+            }, fanout);
+
+        // 쓰기가 모두 끝났으므로 세션을 먼저 정리한 뒤 클라이언트 소켓을 닫음
+        sessions.clear();
+        for (auto& client : clients) {
+            boost::system::error_code ignored;
+            client->close(ignored);
+        }
+        io_context.poll();
+    }
+
+    // 세션의 읽기 대기(Session::async_receive)와 응답 쓰기(Session::do_write)를 같은 방식으로 1회씩 돌리는 비용과 힙 할당 수
+    // 클라이언트가 요청을 보내면 서버 쪽이 async_wait로 깨어나 읽고 async_write로 응답, 클라이언트가 응답을 모두 받으면 1회
+    // wrap은 핸들러를 감싸는 방식 (HandlerMemory 사용 여부), 측정 후 연산당 할당 수를 반환
+    template <class Wrap>
+    double benchHandlerRoundTrip(bench::Runner& runner, const std::string& name, Wrap wrap) {
+        if (!runner.enabled(name)) return 0;
+
+        boost::asio::io_context io_context;
+        boost::asio::ip::tcp::acceptor acceptor(io_context,
+            boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0));
+        boost::asio::ip::tcp::socket client(io_context);
+        client.connect(acceptor.local_endpoint());
+        boost::asio::ip::tcp::socket server_side = acceptor.accept();
+        server_side.non_blocking(true);
+        server_side.set_option(boost::asio::ip::tcp::no_delay(true));
+        client.set_option(boost::asio::ip::tcp::no_delay(true));
+
+        HandlerMemory read_memory;
+        HandlerMemory write_memory;
+        std::array<char, 64> request{};
+        std::array<char, 64> received{};
+        std::array<char, 64> response{};
+        bool written = false;
+
+        auto roundTrip = [&]() {
+            // 직전 왕복에서 할 일이 없어져 멈춘 io_context를 다시 실행 가능하게 함
+            io_context.restart();
+            written = false;
+            boost::asio::write(client, boost::asio::buffer(request));
+            server_side.async_wait(boost::asio::ip::tcp::socket::wait_read, wrap(read_memory,
+                [&](boost::system::error_code ec) {
+                    if (ec) throw boost::system::system_error(ec);
+                    server_side.read_some(boost::asio::buffer(received), ec);
+                    boost::asio::async_write(server_side, boost::asio::buffer(response), wrap(write_memory,
+                        [&](boost::system::error_code ec, std::size_t /*length*/) {
+                            if (ec) throw boost::system::system_error(ec);
+                            written = true;
+                        }));
+                }));
+            while (!written) {
+                io_context.run_one();
+            }
+            boost::asio::read(client, boost::asio::buffer(received));
+        };
+
+        runner.run(name, roundTrip);
+
+        // 시간 측정으로 충분히 예열된 뒤 고정 횟수만큼 할당 수를 셈
+        constexpr int kCountedRoundTrips = 10000;
+        g_allocations = 0;
+        g_count_allocations = true;
+        for (int i = 0; i < kCountedRoundTrips; ++i) {
+            roundTrip();
+        }
+        g_count_allocations = false;
+
+        double allocationsPerOp = static_cast<double>(g_allocations) / kCountedRoundTrips;
+        runner.addMetric(name, "allocationsPerOp", allocationsPerOp);
+        return allocationsPerOp;
+    }
+
+    // 핸들러를 그대로 넘기는 경우(Asio 기본 할당)와 세션처럼 HandlerMemory로 감싸는 경우를 비교
+    // HandlerMemory 경로는 연산당 할당이 0이어야 하므로 아니면 false
+    bool benchHandlerAllocations(bench::Runner& runner) {
+        benchHandlerRoundTrip(runner, "handler/read+write round trip default alloc",
+            [](HandlerMemory& /*memory*/, auto handler) { return handler; });
+
+        const std::string name = "handler/read+write round trip HandlerMemory";
+        double allocationsPerOp = benchHandlerRoundTrip(runner, name,
+            [](HandlerMemory& memory, auto handler) { return makeCustomAllocHandler(memory, std::move(handler)); });
+        if (allocationsPerOp > 0) {
+            std::fprintf(stderr, "%s: 연산당 힙 할당 %.2f회 (0이어야 함)\n", name.c_str(), allocationsPerOp);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // PasswordUtil::configure 등의 정보 로그가 결과 출력과 섞이지 않도록 경고 이상만 출력
+    spdlog::set_level(spdlog::level::warn);
+
+    bench::Runner runner("matching-micro", argc, argv);
+    bool handlerAllocationsOk = true;
+    try {
+        benchJson(runner);
+        benchValidation(runner);
+        benchPassword(runner);
+        benchBroadcast(runner, 100);
+        benchBroadcast(runner, 1000);
+        handlerAllocationsOk = benchHandlerAllocations(runner);
+        benchDbPool(runner);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "벤치마크 오류: %s\n", e.what());
+        return 1;
+    }
+    int result = runner.finish();
+    return handlerAllocationsOk ? result : 1;
+}
@@ -0,0 +1,108 @@
+#!/bin/bash
+# 매칭 서버 벤치마크 일괄 실행
+# 1. 일회성 PostgreSQL을 띄우고 db-init.sql/init.sql 적재 (common/bench/local_postgres.sh)
+# 2. 마이크로벤치마크 (MatchingBench, DB 풀 항목 포함)
+# 3. 매크로벤치마크: 벤치마크용 설정으로 서버를 띄우고 LoadGenerator로 부하를 건 뒤 액션별 지연 시간 기록
+# 결과는 bench/results/<커밋>/ 아래 JSON으로 저장되며, common/bench/compare.py로 두 커밋을 비교한다.
+# --memory를 지정하면 PostgreSQL 없이 메모리 리포지토리로 서버를 띄워 소켓/JSON/디스패치 계층만 측정한다 (DB 풀 항목은 건너뜀).
+# --reconnect를 지정하면 매크로벤치마크 중간에 모든 사용자를 끊고 한꺼번에 재접속시켜 accept 처리량과 connect 지연 시간을 함께 기록한다.
+# 사용법: bench/run_bench.sh [--users N] [--duration S] [--micro-only] [--memory] [--reconnect]   (MatchingServer 디렉토리에서 make all loadgen bench 후 실행)
+
+set -e
+
+cd "$(dirname "$0")/.."
+
+USERS=500
+DURATION=30
+MICRO_ONLY=0
+MEMORY=0
+RECONNECT=0
+while [ $# -gt 0 ]; do
+    case "$1" in
+        --users) USERS="$2"; shift 2 ;;
+        --duration) DURATION="$2"; shift 2 ;;
+        --micro-only) MICRO_ONLY=1; shift ;;
+        --memory) MEMORY=1; shift ;;
+        --reconnect) RECONNECT=1; shift ;;
+        *) echo "알 수 없는 옵션: $1" >&2; exit 1 ;;
+    esac
+done
+
+BIN_DIR=./build/bin
+PG_SCRIPT=../common/bench/local_postgres.sh
+COMMIT="$(git rev-parse --short HEAD 2>/dev/null || echo unknown)"
+if [ -n "$(git status --porcelain -- . ../common 2>/dev/null)" ]; then
+    COMMIT="$COMMIT-dirty"
+fi
+RESULT_DIR="./bench/results/$COMMIT"
+mkdir -p "$RESULT_DIR"
+export BENCH_COMMIT="$COMMIT"
+
+SERVER_PID=""
+cleanup() {
+    if [ -n "$SERVER_PID" ]; then
+        kill -TERM "$SERVER_PID" 2>/dev/null || true
+        wait "$SERVER_PID" 2>/dev/null || true
+    fi
+    if [ "$MEMORY" = 0 ]; then
+        bash "$PG_SCRIPT" stop
+    fi
+}
+trap cleanup EXIT
+
+if [ "$MEMORY" = 0 ]; then
+    echo "===== 일회성 PostgreSQL 시작 ====="
+    eval "$(bash "$PG_SCRIPT" start)"
+fi
+
+echo "===== 마이크로벤치마크 ====="
+"$BIN_DIR/MatchingBench" --json "$RESULT_DIR/micro.json"
+MACRO_NAME=macro
+if [ "$MEMORY" = 1 ]; then
+    MACRO_NAME=macro-memory
+fi
+# 재접속 폭주는 램프업(5초)이 끝나고 부하가 안정된 뒤 전체 시간의 절반 시점에 전체 사용자를 동시에 재접속
+RECONNECT_ARGS=()
+if [ "$RECONNECT" = 1 ]; then
+    MACRO_NAME="$MACRO_NAME-reconnect"
+    RECONNECT_ARGS=(--reconnect-at "$((DURATION / 2))" --reconnect-burst 0)
+fi
+
+if [ "$MICRO_ONLY" = 1 ]; then
+    exit 0
+fi
+
+echo "===== 매크로벤치마크 (사용자 $USERS명, ${DURATION}초) ====="
+# 부하 생성기가 제한에 걸리지 않도록 요청 수 제한을 끄고, 로그와 관리 포트도 측정에 영향이 없도록 줄인 설정
+BENCH_CONFIG="$RESULT_DIR/server-config.json"
+python3 - "$BENCH_CONFIG" "$RESULT_DIR/slow_traces.json" "$MEMORY" <<'EOF'
+import json, sys
+with open("src/config/config.json", encoding="utf-8-sig") as f:
+    config = json.load(f)
+config["rateLimit"]["enabled"] = False
+config["admin"]["enabled"] = False
+config["logging"]["level"] = "warn"
+config["tracing"]["exportPath"] = sys.argv[2]
+if sys.argv[3] == "1":
+    config["repository"]["backend"] = "memory"
+with open(sys.argv[1], "w", encoding="utf-8") as f:
+    json.dump(config, f, indent=2, ensure_ascii=False)
+EOF
+
+SERVER_PORT=18080 SERVER_VERSION=1.0.0 CONFIG_PATH="$BENCH_CONFIG" \
+    SESSION_TOKEN_KEY_1="bench-session-token-key-0123456789abcdef" \
+    "$BIN_DIR/MatchingServer" > "$RESULT_DIR/server.log" 2>&1 &
+SERVER_PID=$!
+
+for _ in $(seq 1 50); do
+    if (echo > /dev/tcp/127.0.0.1/18080) 2>/dev/null; then
+        break
+    fi
+    sleep 0.2
+done
+
+ulimit -n 65536 2>/dev/null || true
+"$BIN_DIR/LoadGenerator" tools/load_generator/scenario.json \
+    --port 18080 --users "$USERS" --duration "$DURATION" --ramp 5 "${RECONNECT_ARGS[@]}" --report "$RESULT_DIR/$MACRO_NAME.json"
+
+echo "결과: $RESULT_DIR"
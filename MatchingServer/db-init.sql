@@ -68,7 +68,8 @@ CREATE TABLE games (
 );
 
 -- 인덱스 생성 (자주 조회되는 필드)
-CREATE INDEX idx_users_username ON users(user_name);
+-- 로그인 조회는 대소문자를 구분하지 않으므로 LOWER(user_name) 식 인덱스 사용 (대소문자만 다른 아이디 중복도 방지)
+CREATE UNIQUE INDEX idx_users_username_lower ON users (LOWER(user_name));
 CREATE INDEX idx_users_nickname ON users(nick_name);
 CREATE INDEX idx_rooms_status ON rooms(status);
 CREATE INDEX idx_rooms_created_at ON rooms(created_at); -- 생성 시간 기준 정렬
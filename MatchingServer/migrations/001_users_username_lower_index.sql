@@ -0,0 +1,48 @@
+-- 001: 대소문자 구분 없는 아이디 조회를 인덱스로 처리
+-- findByUsername은 LOWER(user_name)으로 비교하므로 user_name 단순 인덱스를 사용하지 못하고 전체 테이블을 스캔함
+-- 운영 중인 DB에 적용: psql -U admin -d gamedata -v ON_ERROR_STOP=1 -f migrations/001_users_username_lower_index.sql
+-- ON_ERROR_STOP이 없으면 psql은 오류가 난 문장을 건너뛰고 다음 단계를 계속 실행함 (아래에서도 켜 두지만 명령줄에도 지정)
+-- CONCURRENTLY는 트랜잭션 안에서 실행할 수 없으므로 -1(single transaction) 옵션 없이 실행
+
+\set ON_ERROR_STOP on
+
+-- 1. 대소문자만 다른 중복 아이디가 있으면 유니크 인덱스 생성이 실패하므로 먼저 확인, 있으면 중단
+--    중복 목록 확인: SELECT LOWER(user_name), array_agg(user_name) FROM users GROUP BY 1 HAVING COUNT(*) > 1;
+DO
+$$
+DECLARE
+    duplicate_names TEXT;
+BEGIN
+    SELECT string_agg(normalized_name, ', ')
+    INTO duplicate_names
+    FROM (
+        SELECT LOWER(user_name) AS normalized_name
+        FROM users
+        GROUP BY LOWER(user_name)
+        HAVING COUNT(*) > 1
+    ) duplicates;
+
+    IF duplicate_names IS NOT NULL THEN
+        RAISE EXCEPTION '대소문자만 다른 중복 아이디가 있어 인덱스를 만들 수 없습니다: %', duplicate_names;
+    END IF;
+END
+$$;
+
+-- 2. 이전 실행에서 CONCURRENTLY 생성이 중간에 실패하면 INVALID 인덱스가 남음
+--    IF NOT EXISTS는 INVALID 인덱스도 있는 것으로 보고 건너뛰므로 먼저 제거
+SELECT 'DROP INDEX CONCURRENTLY ' || quote_ident(n.nspname) || '.' || quote_ident(c.relname)
+FROM pg_index i
+JOIN pg_class c ON c.oid = i.indexrelid
+JOIN pg_namespace n ON n.oid = c.relnamespace
+WHERE c.relname = 'idx_users_username_lower'
+  AND n.nspname = current_schema()
+  AND NOT i.indisvalid
+\gexec
+
+-- 3. 쓰기를 막지 않고 식 인덱스 생성
+CREATE UNIQUE INDEX CONCURRENTLY IF NOT EXISTS idx_users_username_lower ON users (LOWER(user_name));
+
+-- 4. user_name UNIQUE 제약의 인덱스와 중복되는 기존 인덱스 제거
+DROP INDEX CONCURRENTLY IF EXISTS idx_users_username;
+
+ANALYZE users;
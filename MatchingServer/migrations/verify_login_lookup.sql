@@ -0,0 +1,29 @@
+-- 로그인 조회(UserRepository::findByUsername)가 idx_users_username_lower 인덱스를 사용하는지 EXPLAIN으로 확인
+-- 실행: psql -U admin -d gamedata -v ON_ERROR_STOP=1 -f migrations/verify_login_lookup.sql
+-- 행 수가 적은 테이블은 플래너가 순차 스캔을 고를 수 있으므로 순차 스캔을 끄고 인덱스 사용 가능 여부를 확인
+
+BEGIN;
+SET LOCAL enable_seqscan = off;
+
+DO
+$$
+DECLARE
+    plan_line TEXT;
+    plan_text TEXT := '';
+BEGIN
+    FOR plan_line IN
+        EXECUTE 'EXPLAIN SELECT user_id, user_name, password_hash, nick_name, created_at, last_login '
+             || 'FROM users WHERE LOWER(user_name) = $1' USING 'verify_user'
+    LOOP
+        plan_text := plan_text || plan_line || E'\n';
+    END LOOP;
+
+    RAISE NOTICE '%', plan_text;
+
+    IF plan_text NOT LIKE '%idx_users_username_lower%' THEN
+        RAISE EXCEPTION '로그인 조회가 idx_users_username_lower 인덱스를 사용하지 않습니다';
+    END IF;
+END
+$$;
+
+ROLLBACK;
@@ -2,6 +2,7 @@
 // 인증 컨트롤러 구현 파일
 // 사용자 등록 및 로그인 요청을 처리하는 컨트롤러
 #include "auth_controller.h"
+#include "../util/tracing.h"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
@@ -9,11 +10,53 @@ namespace game_server {
 
     using json = nlohmann::json;
 
-    AuthController::AuthController(std::shared_ptr<AuthService> authService)
-        : authService_(authService) {
+    AuthController::AuthController(std::shared_ptr<AuthService> authService, WorkerPool* hashPool)
+        : authService_(authService), hashPool_(hashPool) {
+    }
+
+    void AuthController::handleRequestAsync(json& request, Completion completion) {
+        std::string action = request["action"];
+        if (!hashPool_ || (action != "register" && action != "login" && action != "SSAFYlogin")) {
+            completion(handleRequest(request));
+            return;
+        }
+
+        // 해시 계산과 DB 조회는 io 스레드 밖에서 처리
+        // 요청 추적은 completion이 호출될 때까지 세션이 소유하므로 포인터만 넘김
+        Trace* trace = Trace::current();
+        auto queued_at = std::chrono::steady_clock::now();
+        auto accepted = hashPool_->submit([this, request, completion, trace, queued_at]() mutable {
+            TraceScope trace_scope(trace);
+            if (trace) {
+                trace->addSpan("worker.queue", queued_at, std::chrono::steady_clock::now());
+            }
+            json response;
+            try {
+                response = handleRequest(request);
+            }
+            catch (const std::exception& e) {
+                spdlog::error("인증 요청 처리 중 오류: {}", e.what());
+                response = {
+                    {"status", "error"},
+                    {"message", "잘못된 요청 형식"}
+                };
+            }
+            completion(std::move(response));
+            });
+
+        if (!accepted) {
+            spdlog::warn("인증 워커 대기열이 가득 차 요청을 거절합니다, 액션 : {}", action);
+            json error_response = {
+                {"action", action},
+                {"status", "error"},
+                {"message", "요청이 많아 처리할 수 없습니다. 잠시 후 다시 시도해주세요"}
+            };
+            completion(error_response);
+        }
     }
 
     nlohmann::json AuthController::handleRequest(json& request) {
+        ScopedSpan span("AuthController.handleRequest");
         // 요청의 action 필드에 따라 적절한 핸들러 호출
         std::string action = request["action"];
 
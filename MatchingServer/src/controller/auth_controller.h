@@ -2,16 +2,19 @@
 #pragma once
 #include "controller.h"
 #include "../service/auth_service.h"
+#include "../util/worker_pool.h"
 #include <memory>
 
 namespace game_server {
 
     class AuthController : public Controller {
     public:
-        explicit AuthController(std::shared_ptr<AuthService> authService);
+        // hashPool이 있으면 비밀번호 해시가 필요한 요청(회원가입, 로그인)을 워커 풀에서 처리
+        explicit AuthController(std::shared_ptr<AuthService> authService, WorkerPool* hashPool = nullptr);
         ~AuthController() override = default;
 
         nlohmann::json handleRequest(nlohmann::json& request) override;
+        void handleRequestAsync(nlohmann::json& request, Completion completion) override;
 
     private:
         nlohmann::json handleRegister(nlohmann::json& request);
@@ -20,6 +23,7 @@ namespace game_server {
         nlohmann::json handleUpdateNickName(nlohmann::json& request);
 
         std::shared_ptr<AuthService> authService_;
+        WorkerPool* hashPool_;
     };
 
 } // namespace game_server
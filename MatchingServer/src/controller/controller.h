@@ -1,5 +1,6 @@
 ﻿// controller/controller.h
 #pragma once
+#include <functional>
 #include <string>
 #include <nlohmann/json.hpp>
 
@@ -10,6 +11,14 @@ namespace game_server {
         virtual ~Controller() = default;
 
         virtual nlohmann::json handleRequest(nlohmann::json& request) = 0;
+
+        // 응답 완료 콜백, 워커 스레드에서 호출될 수 있으므로 호출자가 io 스레드로 넘겨서 처리
+        using Completion = std::function<void(nlohmann::json response)>;
+
+        // 기본 구현은 호출 스레드에서 바로 처리, 무거운 작업이 있는 컨트롤러는 워커 풀에서 처리 후 completion 호출
+        virtual void handleRequestAsync(nlohmann::json& request, Completion completion) {
+            completion(handleRequest(request));
+        }
     };
 
 } // namespace game_server
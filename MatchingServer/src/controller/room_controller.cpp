@@ -2,6 +2,7 @@
 // 방 컨트롤러 구현 파일
 // 방 생성, 참가, 목록 조회 등의 요청을 처리하는 컨트롤러
 #include "room_controller.h"
+#include "../util/tracing.h"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 
@@ -14,6 +15,7 @@ namespace game_server {
     }
 
     nlohmann::json RoomController::handleRequest(json& request) {
+        ScopedSpan span("RoomController.handleRequest");
         // 요청의 action 필드에 따라 적절한 핸들러 호출
         std::string action = request["action"];
 
@@ -0,0 +1,163 @@
+﻿// core/admin_server.cpp
+// 관리용 HTTP 엔드포인트 구현 파일
+#include "admin_server.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <istream>
+
+namespace game_server {
+
+    namespace {
+        // 요청 헤더 최대 크기, 스크레이프 요청은 수백 바이트 수준
+        constexpr std::size_t kMaxRequestBytes = 4096;
+        constexpr std::chrono::seconds kRequestTimeout{ 5 };
+    }
+
+    AdminConfig AdminConfig::fromJson(const json& config) {
+        AdminConfig result;
+        if (!config.is_object()) return result;
+        result.enabled = config.value("enabled", result.enabled);
+        result.bind_address = config.value("bindAddress", result.bind_address);
+        result.port = config.value("port", result.port);
+        return result;
+    }
+
+    // 요청 하나를 읽고 응답한 뒤 닫히는 연결
+    class AdminServer::Connection : public std::enable_shared_from_this<AdminServer::Connection> {
+    public:
+        Connection(boost::asio::ip::tcp::socket socket,
+            std::shared_ptr<std::map<std::string, Handler>> routes)
+            : socket_(std::move(socket)),
+            timer_(socket_.get_executor()),
+            request_(kMaxRequestBytes),
+            routes_(std::move(routes))
+        {
+        }
+
+        void start() {
+            auto self(shared_from_this());
+            // 요청을 끝까지 보내지 않는 연결이 남지 않도록 제한 시간 적용
+            timer_.expires_after(kRequestTimeout);
+            timer_.async_wait([this, self](const boost::system::error_code& ec) {
+                if (!ec) {
+                    boost::system::error_code ignored;
+                    socket_.close(ignored);
+                }
+                });
+
+            boost::asio::async_read_until(socket_, request_, "\r\n\r\n",
+                [this, self](const boost::system::error_code& ec, std::size_t /*length*/) {
+                    if (ec) {
+                        timer_.cancel();
+                        return;
+                    }
+                    respond();
+                });
+        }
+
+    private:
+        void respond() {
+            std::istream stream(&request_);
+            std::string method, target;
+            stream >> method >> target;
+            std::string path = target.substr(0, target.find('?'));
+
+            int status = 200;
+            const char* reason = "OK";
+            Response response;
+            auto it = routes_->find(path);
+            if (method != "GET") {
+                status = 405;
+                reason = "Method Not Allowed";
+                response = { "text/plain; charset=utf-8", "method not allowed\n" };
+            }
+            else if (it == routes_->end()) {
+                status = 404;
+                reason = "Not Found";
+                response = { "text/plain; charset=utf-8", "not found\n" };
+            }
+            else {
+                try {
+                    response = it->second();
+                }
+                catch (const std::exception& e) {
+                    spdlog::error("관리 요청 처리 중 오류, 경로 : {}, 오류 : {}", path, e.what());
+                    status = 500;
+                    reason = "Internal Server Error";
+                    response = { "text/plain; charset=utf-8", "internal error\n" };
+                }
+            }
+
+            response_ = "HTTP/1.0 " + std::to_string(status) + " " + reason + "\r\n";
+            response_ += "Content-Type: " + response.content_type + "\r\n";
+            response_ += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+            response_ += "Connection: close\r\n\r\n";
+            response_ += response.body;
+
+            auto self(shared_from_this());
+            boost::asio::async_write(socket_, boost::asio::buffer(response_),
+                [this, self](const boost::system::error_code& /*ec*/, std::size_t /*length*/) {
+                    timer_.cancel();
+                    boost::system::error_code ignored;
+                    socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+                    socket_.close(ignored);
+                });
+        }
+
+        boost::asio::ip::tcp::socket socket_;
+        boost::asio::steady_timer timer_;
+        boost::asio::streambuf request_;
+        std::string response_;
+        std::shared_ptr<std::map<std::string, Handler>> routes_;
+    };
+
+    AdminServer::AdminServer(boost::asio::io_context& io_context, const AdminConfig& config)
+        : io_context_(io_context),
+        config_(config),
+        acceptor_(io_context),
+        routes_(std::make_shared<std::map<std::string, Handler>>())
+    {
+    }
+
+    AdminServer::~AdminServer() {
+        stop();
+    }
+
+    void AdminServer::addRoute(const std::string& path, Handler handler) {
+        (*routes_)[path] = std::move(handler);
+    }
+
+    void AdminServer::start() {
+        boost::asio::ip::tcp::endpoint endpoint(
+            boost::asio::ip::make_address(config_.bind_address), static_cast<unsigned short>(config_.port));
+        acceptor_.open(endpoint.protocol());
+        acceptor_.set_option(boost::asio::socket_base::reuse_address(true));
+        acceptor_.bind(endpoint);
+        acceptor_.listen();
+        spdlog::info("관리용 엔드포인트 시작, 주소 : {}:{}", config_.bind_address, config_.port);
+        do_accept();
+    }
+
+    void AdminServer::stop() {
+        if (acceptor_.is_open()) {
+            boost::system::error_code ignored;
+            acceptor_.close(ignored);
+        }
+    }
+
+    void AdminServer::do_accept() {
+        acceptor_.async_accept(
+            [this](const boost::system::error_code& ec, boost::asio::ip::tcp::socket socket) {
+                if (ec) {
+                    if (ec != boost::asio::error::operation_aborted) {
+                        spdlog::warn("관리용 연결 수락 오류: {}", ec.message());
+                        do_accept();
+                    }
+                    return;
+                }
+                std::make_shared<Connection>(std::move(socket), routes_)->start();
+                do_accept();
+            });
+    }
+
+} // namespace game_server
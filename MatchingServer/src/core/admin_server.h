@@ -0,0 +1,53 @@
+﻿// core/admin_server.h
+#pragma once
+#include <boost/asio.hpp>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    // 관리용 포트 설정 (config.json의 "admin" 섹션)
+    struct AdminConfig {
+        bool enabled = false;
+        std::string bind_address = "127.0.0.1";  // 외부에 노출하지 않도록 기본은 루프백
+        int port = 9100;
+
+        static AdminConfig fromJson(const json& config);
+    };
+
+    // 게임 포트와 분리된 관리용 HTTP 엔드포인트 (메트릭 스크레이프 등)
+    // GET 요청 하나를 읽어 경로에 등록된 핸들러의 결과를 응답하고 연결을 닫는 최소한의 HTTP/1.0 서버
+    // 게임 세션과 같은 io_context에서 동작하므로 핸들러는 io 스레드에서 호출된다.
+    class AdminServer {
+    public:
+        struct Response {
+            std::string content_type;
+            std::string body;
+        };
+        using Handler = std::function<Response()>;
+
+        AdminServer(boost::asio::io_context& io_context, const AdminConfig& config);
+        ~AdminServer();
+
+        void addRoute(const std::string& path, Handler handler);
+        void start();
+        void stop();
+
+    private:
+        class Connection;
+
+        void do_accept();
+
+        boost::asio::io_context& io_context_;
+        AdminConfig config_;
+        boost::asio::ip::tcp::acceptor acceptor_;
+        // 응답 중인 연결이 서버보다 오래 살 수 있으므로 공유
+        std::shared_ptr<std::map<std::string, Handler>> routes_;
+    };
+
+} // namespace game_server
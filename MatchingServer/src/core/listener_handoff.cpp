@@ -0,0 +1,256 @@
+﻿// core/listener_handoff.cpp
+// 리스닝 소켓 인계 구현 파일
+// 유닉스 도메인 소켓과 SCM_RIGHTS로 기존 프로세스의 리스닝 소켓을 새 프로세스에 전달
+#include "listener_handoff.h"
+#include <spdlog/spdlog.h>
+#include <cstring>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS) && !defined(_WIN32)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace game_server {
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS) && !defined(_WIN32)
+
+    namespace {
+        // 한 번에 넘길 수 있는 최대 fd 수 (acceptor 수 상한)
+        constexpr std::size_t kMaxHandoffFds = 64;
+        constexpr char kHandoffMagic[4] = { 'L', 'F', 'D', 'S' };
+
+        bool sendFds(int unix_fd, const std::vector<int>& fds) {
+            if (fds.empty() || fds.size() > kMaxHandoffFds) return false;
+
+            struct iovec iov;
+            iov.iov_base = const_cast<char*>(kHandoffMagic);
+            iov.iov_len = sizeof(kHandoffMagic);
+
+            std::vector<char> control(CMSG_SPACE(sizeof(int) * fds.size()), 0);
+            struct msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control.data();
+            msg.msg_controllen = control.size();
+
+            struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_RIGHTS;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+            std::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+
+            return ::sendmsg(unix_fd, &msg, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(kHandoffMagic));
+        }
+
+        std::vector<int> recvFds(int unix_fd) {
+            std::vector<int> fds;
+            char magic[sizeof(kHandoffMagic)];
+            struct iovec iov;
+            iov.iov_base = magic;
+            iov.iov_len = sizeof(magic);
+
+            std::vector<char> control(CMSG_SPACE(sizeof(int) * kMaxHandoffFds), 0);
+            struct msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control.data();
+            msg.msg_controllen = control.size();
+
+            ssize_t received = ::recvmsg(unix_fd, &msg, MSG_CMSG_CLOEXEC);
+            if (received != static_cast<ssize_t>(sizeof(magic)) ||
+                std::memcmp(magic, kHandoffMagic, sizeof(magic)) != 0) {
+                return fds;
+            }
+
+            for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+                if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+                std::size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                fds.resize(count);
+                std::memcpy(fds.data(), CMSG_DATA(cmsg), sizeof(int) * count);
+            }
+            return fds;
+        }
+
+        // 인계 요청을 보낸 프로세스가 같은 사용자로 실행 중인지 확인 (SO_PEERCRED)
+        bool isSameUser(int unix_fd, uid_t& peer_uid) {
+            struct ucred credentials;
+            socklen_t length = sizeof(credentials);
+            if (::getsockopt(unix_fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0 ||
+                length != sizeof(credentials)) {
+                return false;
+            }
+            peer_uid = credentials.uid;
+            return peer_uid == ::geteuid();
+        }
+    }
+
+    ListenerHandoff::ListenerHandoff(boost::asio::io_context& io_context,
+        std::string socket_path,
+        FdProvider fd_provider,
+        HandedOffCallback on_handed_off)
+        : io_context_(io_context),
+        socket_path_(std::move(socket_path)),
+        fd_provider_(std::move(fd_provider)),
+        on_handed_off_(std::move(on_handed_off)),
+        acceptor_(io_context)
+    {
+    }
+
+    ListenerHandoff::~ListenerHandoff() {
+        stop();
+    }
+
+    bool ListenerHandoff::supported() {
+        return true;
+    }
+
+    void ListenerHandoff::start() {
+        boost::system::error_code ec;
+
+        // 이전 프로세스가 남긴 소켓 파일 제거 (인계를 이미 받은 뒤이므로 안전)
+        ::unlink(socket_path_.c_str());
+
+        boost::asio::local::stream_protocol::endpoint endpoint(socket_path_);
+        acceptor_.open(endpoint.protocol(), ec);
+        if (!ec) acceptor_.bind(endpoint, ec);
+        // 다른 사용자가 접속해 리스닝 소켓을 가로채지 못하도록 소유자만 접근 가능하게 함 (listen 전에 적용)
+        if (!ec && ::chmod(socket_path_.c_str(), S_IRUSR | S_IWUSR) != 0) {
+            ec.assign(errno, boost::system::system_category());
+        }
+        if (!ec) acceptor_.listen(1, ec);
+        if (ec) {
+            spdlog::error("리스닝 소켓 인계 경로 {}를 열지 못했습니다: {}", socket_path_, ec.message());
+            boost::system::error_code close_ec;
+            acceptor_.close(close_ec);
+            ::unlink(socket_path_.c_str());
+            return;
+        }
+
+        spdlog::info("리스닝 소켓 인계 요청 대기 중, 경로 : {}", socket_path_);
+        do_accept();
+    }
+
+    void ListenerHandoff::stop() {
+        if (!acceptor_.is_open()) return;
+        boost::system::error_code ec;
+        acceptor_.close(ec);
+
+        // 인계한 경우 소켓 파일은 새 프로세스가 사용하므로 지우지 않음
+        if (!handed_off_) {
+            ::unlink(socket_path_.c_str());
+        }
+    }
+
+    void ListenerHandoff::do_accept() {
+        acceptor_.async_accept(
+            [this](boost::system::error_code ec, boost::asio::local::stream_protocol::socket socket) {
+                if (ec) {
+                    if (ec != boost::asio::error::operation_aborted) {
+                        spdlog::error("리스닝 소켓 인계 요청 수락 오류: {}", ec.message());
+                    }
+                    return;
+                }
+
+                // 파일 권한과 별개로 상대 프로세스의 uid를 확인하여 다른 사용자에게는 fd를 넘기지 않음
+                uid_t peer_uid = static_cast<uid_t>(-1);
+                if (!isSameUser(socket.native_handle(), peer_uid)) {
+                    spdlog::warn("다른 사용자(uid {})의 리스닝 소켓 인계 요청을 거부하였습니다",
+                        peer_uid == static_cast<uid_t>(-1) ? std::string("알 수 없음") : std::to_string(peer_uid));
+                    do_accept();
+                    return;
+                }
+
+                std::vector<int> fds = fd_provider_();
+                if (!sendFds(socket.native_handle(), fds)) {
+                    spdlog::error("리스닝 소켓 {}개 인계에 실패하였습니다: {}", fds.size(), std::strerror(errno));
+                    do_accept();
+                    return;
+                }
+
+                spdlog::info("새 프로세스에 리스닝 소켓 {}개를 인계하였습니다", fds.size());
+                handed_off_ = true;
+                boost::system::error_code close_ec;
+                acceptor_.close(close_ec);
+                if (on_handed_off_) {
+                    on_handed_off_();
+                }
+            });
+    }
+
+    std::vector<int> ListenerHandoff::receive(const std::string& socket_path, std::chrono::milliseconds timeout) {
+        std::vector<int> fds;
+        if (socket_path.empty() || socket_path.size() >= sizeof(sockaddr_un::sun_path)) return fds;
+
+        int unix_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (unix_fd < 0) return fds;
+
+        struct sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        // 기존 프로세스가 없으면(파일 없음/연결 거부) 새로 바인딩하도록 빈 결과 반환
+        if (::connect(unix_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(unix_fd);
+            return fds;
+        }
+
+        struct pollfd pfd;
+        pfd.fd = unix_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (::poll(&pfd, 1, static_cast<int>(timeout.count())) == 1) {
+            fds = recvFds(unix_fd);
+        }
+        ::close(unix_fd);
+
+        if (fds.empty()) {
+            spdlog::warn("기존 프로세스로부터 리스닝 소켓을 넘겨받지 못했습니다, 새로 바인딩합니다");
+        }
+        else {
+            spdlog::info("기존 프로세스로부터 리스닝 소켓 {}개를 넘겨받았습니다", fds.size());
+        }
+        return fds;
+    }
+
+#else
+
+    ListenerHandoff::ListenerHandoff(boost::asio::io_context& io_context,
+        std::string socket_path,
+        FdProvider fd_provider,
+        HandedOffCallback on_handed_off)
+        : io_context_(io_context),
+        socket_path_(std::move(socket_path)),
+        fd_provider_(std::move(fd_provider)),
+        on_handed_off_(std::move(on_handed_off))
+    {
+    }
+
+    ListenerHandoff::~ListenerHandoff() = default;
+
+    bool ListenerHandoff::supported() {
+        return false;
+    }
+
+    void ListenerHandoff::start() {
+        spdlog::warn("이 플랫폼에서는 리스닝 소켓 인계를 지원하지 않습니다");
+    }
+
+    void ListenerHandoff::stop() {
+    }
+
+    void ListenerHandoff::do_accept() {
+    }
+
+    std::vector<int> ListenerHandoff::receive(const std::string& /*socket_path*/, std::chrono::milliseconds /*timeout*/) {
+        return {};
+    }
+
+#endif
+
+} // namespace game_server
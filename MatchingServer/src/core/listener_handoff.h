@@ -0,0 +1,48 @@
+﻿// core/listener_handoff.h
+#pragma once
+#include <boost/asio.hpp>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace game_server {
+
+    // 무중단 재시작을 위한 리스닝 소켓 인계
+    // 기존 프로세스는 유닉스 도메인 소켓(socketPath)에서 인계 요청을 기다리고,
+    // 새 프로세스가 접속하면 리스닝 소켓 fd를 SCM_RIGHTS로 넘긴 뒤 드레인에 들어간다.
+    // 리스닝 소켓이 닫히지 않으므로 배포 중에도 백로그의 연결이 유실되지 않는다. (리눅스 전용)
+    class ListenerHandoff {
+    public:
+        using FdProvider = std::function<std::vector<int>()>;
+        using HandedOffCallback = std::function<void()>;
+
+        ListenerHandoff(boost::asio::io_context& io_context,
+            std::string socket_path,
+            FdProvider fd_provider,
+            HandedOffCallback on_handed_off);
+        ~ListenerHandoff();
+
+        // 인계 요청 대기 시작
+        void start();
+        void stop();
+
+        // 새 프로세스: 기존 프로세스로부터 리스닝 소켓 fd를 넘겨받음, 기존 프로세스가 없으면 빈 벡터
+        static std::vector<int> receive(const std::string& socket_path, std::chrono::milliseconds timeout);
+
+        static bool supported();
+
+    private:
+        void do_accept();
+
+        boost::asio::io_context& io_context_;
+        std::string socket_path_;
+        FdProvider fd_provider_;
+        HandedOffCallback on_handed_off_;
+        bool handed_off_ = false;
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS) && !defined(_WIN32)
+        boost::asio::local::stream_protocol::acceptor acceptor_;
+#endif
+    };
+
+} // namespace game_server
@@ -0,0 +1,127 @@
+﻿// core/mirror_channel.cpp
+// 미러 서버 명령 채널 구현
+// 요청 ID 부여, 응답 대기 목록, 타임아웃 및 ack/nack 처리를 담당
+#include "mirror_channel.h"
+#include <spdlog/spdlog.h>
+#include <vector>
+
+namespace game_server {
+
+    MirrorChannel::MirrorChannel(boost::asio::io_context& io_context,
+        Writer writer,
+        std::chrono::milliseconds timeout)
+        : io_context_(io_context),
+        writer_(std::move(writer)),
+        timeout_(timeout)
+    {
+    }
+
+    MirrorChannel::~MirrorChannel() {
+        failAll("미러 채널 종료");
+    }
+
+    std::uint64_t MirrorChannel::send(json command, Callback callback) {
+        std::uint64_t request_id;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            request_id = next_request_id_++;
+
+            PendingRequest pending;
+            pending.callback = std::move(callback);
+            pending.timer = std::make_unique<boost::asio::steady_timer>(io_context_, timeout_);
+            pending.sent_at = std::chrono::steady_clock::now();
+            // 만료된 뒤 핸들러가 실행 대기 중일 때 채널이 소멸될 수 있으므로 weak_ptr로 생존 여부를 확인
+            pending.timer->async_wait([weak_self = weak_from_this(), request_id](const boost::system::error_code& ec) {
+                if (ec == boost::asio::error::operation_aborted) return;
+                if (auto self = weak_self.lock()) {
+                    self->on_timeout(request_id);
+                }
+                });
+            pending_.emplace(request_id, std::move(pending));
+        }
+
+        // 미러 세션의 쓰기 큐를 통해 전송하므로 명령은 보낸 순서대로 도착한다
+        command["requestId"] = request_id;
+        writer_(command.dump());
+        spdlog::debug("미러 명령 전송, 요청 ID : {}, 액션 : {}", request_id, command.value("action", ""));
+        return request_id;
+    }
+
+    bool MirrorChannel::handleReply(const json& reply) {
+        if (!reply.contains("requestId")) {
+            spdlog::warn("requestId가 없는 미러 응답을 무시합니다: {}", reply.dump());
+            return false;
+        }
+
+        std::uint64_t request_id = reply["requestId"].get<std::uint64_t>();
+        PendingRequest pending;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            auto it = pending_.find(request_id);
+            if (it == pending_.end()) {
+                spdlog::warn("대기 중이 아닌 미러 응답을 무시합니다, 요청 ID : {} (타임아웃 이후 도착)", request_id);
+                return false;
+            }
+            pending = std::move(it->second);
+            pending_.erase(it);
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - pending.sent_at);
+        bool success = reply.value("action", "") == "ack";
+        spdlog::debug("미러 응답 수신, 요청 ID : {}, 결과 : {}, 소요 시간 : {}ms",
+            request_id, success ? "ack" : "nack", elapsed.count());
+
+        if (pending.callback) {
+            pending.callback(success, reply);
+        }
+        return true;
+    }
+
+    void MirrorChannel::failAll(const std::string& reason) {
+        std::map<std::uint64_t, PendingRequest> failed;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            failed.swap(pending_);
+        }
+
+        for (auto& [request_id, pending] : failed) {
+            spdlog::warn("미러 요청 ID : {} 실패 처리 : {}", request_id, reason);
+            if (pending.callback) {
+                json reply = {
+                    {"action", "nack"},
+                    {"requestId", request_id},
+                    {"message", reason}
+                };
+                pending.callback(false, reply);
+            }
+        }
+    }
+
+    std::size_t MirrorChannel::pendingCount() {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        return pending_.size();
+    }
+
+    void MirrorChannel::on_timeout(std::uint64_t request_id) {
+        PendingRequest pending;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            auto it = pending_.find(request_id);
+            if (it == pending_.end()) return;
+            pending = std::move(it->second);
+            pending_.erase(it);
+        }
+
+        spdlog::error("미러 요청 ID : {}가 {}ms 내에 응답하지 않았습니다", request_id, timeout_.count());
+        if (pending.callback) {
+            json reply = {
+                {"action", "nack"},
+                {"requestId", request_id},
+                {"message", "미러 서버 응답 시간 초과"}
+            };
+            pending.callback(false, reply);
+        }
+    }
+
+} // namespace game_server
@@ -0,0 +1,59 @@
+﻿// core/mirror_channel.h
+#pragma once
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    // 미러 서버로 보내는 명령(setRoom 등)을 요청 ID로 추적하는 RPC 채널
+    // 미러 세션 하나당 하나씩 생성되며, 미러 서버는 같은 requestId로 ack/nack를 응답한다.
+    // 타임아웃 핸들러가 채널보다 늦게 실행될 수 있으므로 shared_ptr로만 생성한다 (핸들러는 weak_ptr로 확인).
+    class MirrorChannel : public std::enable_shared_from_this<MirrorChannel> {
+    public:
+        // success == false 인 경우 reply에 실패 사유(message)가 담긴다
+        using Callback = std::function<void(bool success, const json& reply)>;
+        using Writer = std::function<void(const std::string& message)>;
+
+        MirrorChannel(boost::asio::io_context& io_context,
+            Writer writer,
+            std::chrono::milliseconds timeout);
+        ~MirrorChannel();
+
+        // 명령에 requestId를 부여해 전송하고 응답 대기 목록에 등록
+        std::uint64_t send(json command, Callback callback);
+
+        // 미러 서버의 ack/nack 메시지 처리, 대응하는 요청이 없으면 false
+        bool handleReply(const json& reply);
+
+        // 미러 연결 종료 시 대기 중인 모든 요청을 실패 처리
+        void failAll(const std::string& reason);
+
+        std::size_t pendingCount();
+
+    private:
+        struct PendingRequest {
+            Callback callback;
+            std::unique_ptr<boost::asio::steady_timer> timer;
+            std::chrono::steady_clock::time_point sent_at;
+        };
+
+        void on_timeout(std::uint64_t request_id);
+
+        boost::asio::io_context& io_context_;
+        Writer writer_;
+        std::chrono::milliseconds timeout_;
+        std::uint64_t next_request_id_ = 1;
+        std::map<std::uint64_t, PendingRequest> pending_;
+        std::mutex pending_mutex_;
+    };
+
+} // namespace game_server
@@ -0,0 +1,189 @@
+﻿// core/rate_limiter.cpp
+// 요청 수 제한 구현 파일
+// 세션, IP, 액션 분류별 토큰 버킷으로 과도한 요청을 컨트롤러 진입 전에 차단
+#include "rate_limiter.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    namespace {
+        TokenBucketConfig parseBucket(const json& section, const TokenBucketConfig& fallback) {
+            TokenBucketConfig config = fallback;
+            if (!section.is_object()) return config;
+            config.rate = section.value("rate", fallback.rate);
+            config.burst = section.value("burst", fallback.burst);
+            if (config.burst < 1.0) config.burst = 1.0;
+            return config;
+        }
+    }
+
+    TokenBucket::TokenBucket(const TokenBucketConfig& config)
+        : config_(config),
+        tokens_(config.burst),
+        last_refill_(std::chrono::steady_clock::now())
+    {
+    }
+
+    bool TokenBucket::available(std::chrono::steady_clock::time_point now, double cost) {
+        if (config_.unlimited()) return true;
+
+        std::chrono::duration<double> elapsed = now - last_refill_;
+        tokens_ = std::min(config_.burst, tokens_ + elapsed.count() * config_.rate);
+        last_refill_ = now;
+
+        return tokens_ >= cost;
+    }
+
+    void TokenBucket::consume(double cost) {
+        if (config_.unlimited()) return;
+        tokens_ -= cost;
+    }
+
+    bool TokenBucket::isFull(std::chrono::steady_clock::time_point now) const {
+        if (config_.unlimited()) return true;
+        std::chrono::duration<double> elapsed = now - last_refill_;
+        return tokens_ + elapsed.count() * config_.rate >= config_.burst;
+    }
+
+    RateLimiter::RateLimiter(const json& config) {
+        // 기본값: 정상 클라이언트의 핑(수 초 간격)과 방 조회에는 여유가 있는 수준
+        session_config_ = { 10.0, 30.0 };
+        ip_config_ = { 30.0, 60.0 };
+        action_configs_ = {
+            {"auth", { 0.5, 5.0 }},
+            {"roomQuery", { 2.0, 5.0 }},
+            {"roomMutation", { 1.0, 5.0 }},
+            {"chat", { 1.0, 5.0 }},
+            {"ping", { 2.0, 5.0 }},
+            {"misc", { 2.0, 10.0 }}
+        };
+
+        if (config.is_object()) {
+            enabled_ = config.value("enabled", true);
+            session_config_ = parseBucket(config.value("session", json::object()), session_config_);
+            ip_config_ = parseBucket(config.value("ip", json::object()), ip_config_);
+            json actions = config.value("actions", json::object());
+            for (auto& [name, bucket] : action_configs_) {
+                if (actions.contains(name)) {
+                    bucket = parseBucket(actions[name], bucket);
+                }
+            }
+        }
+
+        Metrics& metrics = Metrics::instance();
+        const char* help = "요청 수 제한 확인 결과별 요청 수";
+        allowed_metric_ = metrics.counter("matching_rate_limit_requests_total", help, "result=\"allowed\"");
+        rejected_session_metric_ = metrics.counter("matching_rate_limit_requests_total", help, "result=\"session\"");
+        rejected_ip_metric_ = metrics.counter("matching_rate_limit_requests_total", help, "result=\"ip\"");
+        for (const auto& [cls, bucket] : action_configs_) {
+            rejected_action_metrics_.emplace(cls, metrics.counter("matching_rate_limit_requests_total", help,
+                "result=\"action\",class=\"" + cls + "\""));
+        }
+
+        spdlog::info("요청 수 제한 {} (세션 {}/s, IP {}/s)",
+            enabled_ ? "활성화" : "비활성화", session_config_.rate, ip_config_.rate);
+    }
+
+    std::string RateLimiter::actionClass(const std::string& action) {
+        if (action == "register" || action == "login" || action == "SSAFYlogin" || action == "updateNickName" ||
+            action == "resume") {
+            return "auth";
+        }
+        if (action == "listRooms" || action == "CCU" || action == "roomCapacity") {
+            return "roomQuery";
+        }
+        if (action == "createRoom" || action == "joinRoom" || action == "exitRoom") {
+            return "roomMutation";
+        }
+        if (action == "chat") {
+            return "chat";
+        }
+        if (action == "alivePing") {
+            return "ping";
+        }
+        return "misc";
+    }
+
+    RateLimitResult RateLimiter::check(SessionBuckets& buckets, const RemoteAddress& ipAddress, const std::string& action) {
+        if (!enabled_) return RateLimitResult::Allowed;
+
+        auto now = std::chrono::steady_clock::now();
+        if (!buckets.initialized) {
+            buckets.session = TokenBucket(session_config_);
+            buckets.initialized = true;
+        }
+
+        std::string cls = actionClass(action);
+        auto action_it = buckets.actions.find(cls);
+        if (action_it == buckets.actions.end()) {
+            action_it = buckets.actions.emplace(cls, TokenBucket(action_configs_[cls])).first;
+        }
+
+        if (!buckets.session.available(now)) {
+            rejected_session_++;
+            rejected_session_metric_.add();
+            return RateLimitResult::SessionLimited;
+        }
+
+        {
+            // IP 버킷은 세션 간에 공유되므로 확인부터 차감까지 락 유지
+            std::lock_guard<std::mutex> lock(ip_buckets_mutex_);
+            auto it = ip_buckets_.find(ipAddress);
+            if (it == ip_buckets_.end()) {
+                it = ip_buckets_.emplace(ipAddress, TokenBucket(ip_config_)).first;
+            }
+            if (!it->second.available(now)) {
+                rejected_ip_++;
+                rejected_ip_metric_.add();
+                return RateLimitResult::IpLimited;
+            }
+
+            if (!action_it->second.available(now)) {
+                rejected_action_++;
+                rejected_action_metrics_.at(cls).add();
+                std::lock_guard<std::mutex> class_lock(rejected_by_class_mutex_);
+                rejected_by_class_[cls]++;
+                return RateLimitResult::ActionLimited;
+            }
+
+            it->second.consume();
+        }
+        buckets.session.consume();
+        action_it->second.consume();
+
+        allowed_++;
+        allowed_metric_.add();
+        return RateLimitResult::Allowed;
+    }
+
+    void RateLimiter::pruneIdleIps() {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(ip_buckets_mutex_);
+        for (auto it = ip_buckets_.begin(); it != ip_buckets_.end();) {
+            // 가득 찬 버킷은 새로 만든 버킷과 동일하므로 제거해도 무방
+            if (it->second.isFull(now)) {
+                it = ip_buckets_.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    json RateLimiter::counters() {
+        json result = {
+            {"allowed", allowed_.load()},
+            {"rejectedSession", rejected_session_.load()},
+            {"rejectedIp", rejected_ip_.load()},
+            {"rejectedAction", rejected_action_.load()},
+            {"rejectedByClass", json::object()}
+        };
+        std::lock_guard<std::mutex> lock(rejected_by_class_mutex_);
+        for (const auto& [cls, count] : rejected_by_class_) {
+            result["rejectedByClass"][cls] = count;
+        }
+        return result;
+    }
+
+} // namespace game_server
@@ -0,0 +1,98 @@
+﻿// core/rate_limiter.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include "session_identity.h"
+#include "../util/metrics.h"
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    // 초당 rate개씩 채워지고 최대 burst개까지 쌓이는 토큰 버킷
+    struct TokenBucketConfig {
+        double rate = 0.0;
+        double burst = 0.0;
+
+        bool unlimited() const { return rate <= 0.0; }
+    };
+
+    class TokenBucket {
+    public:
+        TokenBucket() = default;
+        explicit TokenBucket(const TokenBucketConfig& config);
+
+        // 현재 시각까지 충전한 뒤 cost개를 뺄 수 있는지 확인 (차감하지 않음)
+        bool available(std::chrono::steady_clock::time_point now, double cost = 1.0);
+        // available이 true를 돌려준 직후에만 호출
+        void consume(double cost = 1.0);
+        bool isFull(std::chrono::steady_clock::time_point now) const;
+
+    private:
+        TokenBucketConfig config_;
+        double tokens_ = 0.0;
+        std::chrono::steady_clock::time_point last_refill_{};
+    };
+
+    enum class RateLimitResult {
+        Allowed,
+        SessionLimited,
+        IpLimited,
+        ActionLimited
+    };
+
+    class RateLimiter {
+    public:
+        // 세션이 소유하는 버킷 (세션 단위 + 액션 분류 단위)
+        struct SessionBuckets {
+            bool initialized = false;
+            TokenBucket session;
+            std::map<std::string, TokenBucket> actions;
+        };
+
+        // config.json의 "rateLimit" 섹션으로 초기화, 없으면 기본값 사용
+        explicit RateLimiter(const json& config);
+
+        // 컨트롤러 디스패치 전에 호출, 세션/IP/액션 분류 버킷을 모두 확인한 뒤 전부 통과한 경우에만 토큰 차감
+        // (한 분류가 막혀도 다른 버킷의 토큰은 줄지 않음)
+        RateLimitResult check(SessionBuckets& buckets, const RemoteAddress& ipAddress, const std::string& action);
+
+        // 액션 이름을 제한 분류로 매핑 (auth, roomQuery, roomMutation, chat, ping, misc)
+        static std::string actionClass(const std::string& action);
+
+        // 일정 시간 요청이 없어 가득 찬 IP 버킷 정리
+        void pruneIdleIps();
+
+        bool enabled() const { return enabled_; }
+        json counters();
+
+    private:
+        bool enabled_ = true;
+        TokenBucketConfig session_config_;
+        TokenBucketConfig ip_config_;
+        std::unordered_map<std::string, TokenBucketConfig> action_configs_;
+
+        std::unordered_map<RemoteAddress, TokenBucket, RemoteAddressHash> ip_buckets_;
+        std::mutex ip_buckets_mutex_;
+
+        // 제한 결과 카운터 (주기 로그용, 같은 값을 /metrics에도 노출)
+        std::atomic<std::uint64_t> allowed_{ 0 };
+        std::atomic<std::uint64_t> rejected_session_{ 0 };
+        std::atomic<std::uint64_t> rejected_ip_{ 0 };
+        std::atomic<std::uint64_t> rejected_action_{ 0 };
+        std::map<std::string, std::uint64_t> rejected_by_class_;
+        std::mutex rejected_by_class_mutex_;
+
+        Metrics::Counter allowed_metric_;
+        Metrics::Counter rejected_session_metric_;
+        Metrics::Counter rejected_ip_metric_;
+        std::unordered_map<std::string, Metrics::Counter> rejected_action_metrics_;  // 분류별, 생성자에서만 채움
+    };
+
+} // namespace game_server
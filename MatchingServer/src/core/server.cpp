@@ -10,33 +10,104 @@
 #include "../repository/user_repository.h"
 #include "../repository/room_repository.h"
 #include "../repository/game_repository.h"
+#include "../util/password_util.h"
+#include "../util/metrics.h"
+#include "../util/logging.h"
+#include "../util/tracing.h"
 #include <iostream>
 #include <spdlog/spdlog.h>
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-#include <boost/uuid/uuid_io.hpp>
 #include <nlohmann/json.hpp>
 #include <vector>
 #include <string>
+#include <algorithm>
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 namespace game_server {
 
     using json = nlohmann::json;
 
+#if defined(SO_REUSEPORT)
+    using reuse_port_option = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+#if defined(TCP_KEEPIDLE)
+    using keep_idle_option = boost::asio::detail::socket_option::integer<IPPROTO_TCP, TCP_KEEPIDLE>;
+#endif
+
+    ListenerConfig ListenerConfig::fromJson(const json& config) {
+        ListenerConfig result;
+        if (!config.is_object()) return result;
+        result.bind_address = config.value("bindAddress", result.bind_address);
+        result.backlog = config.value("backlog", result.backlog);
+        result.acceptors = std::max(1, config.value("acceptors", result.acceptors));
+        result.reuse_port = config.value("reusePort", result.acceptors > 1);
+        if (result.reuse_port && result.acceptors == 1) {
+            spdlog::warn("acceptor가 하나이므로 reusePort 설정을 무시합니다");
+            result.reuse_port = false;
+        }
+        result.accept_batch = std::max(1, config.value("acceptBatch", result.accept_batch));
+        result.no_delay = config.value("noDelay", result.no_delay);
+        result.keep_alive = config.value("keepAlive", result.keep_alive);
+        result.keep_alive_idle_seconds = config.value("keepAliveIdleSeconds", result.keep_alive_idle_seconds);
+        return result;
+    }
+
+    DrainConfig DrainConfig::fromJson(const json& config) {
+        DrainConfig result;
+        if (!config.is_object()) return result;
+        result.deadline = std::chrono::seconds(config.value("deadlineSeconds", static_cast<int>(result.deadline.count())));
+        result.reconnect_address = config.value("reconnectAddress", result.reconnect_address);
+        result.reconnect_after_ms = config.value("reconnectAfterMs", result.reconnect_after_ms);
+        result.handoff_socket_path = config.value("handoffSocketPath", result.handoff_socket_path);
+        return result;
+    }
+
     Server::Server(boost::asio::io_context& io_context,
         short port,
         const std::string& db_connection_string,
-        const std::string& version)
+        const std::string& version,
+        const json& config)
         : io_context_(io_context),
-        acceptor_(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)),
+        lifetime_(std::make_shared<int>(0)),
+        listener_config_(ListenerConfig::fromJson(config.value("listener", json::object()))),
+        repository_config_(RepositoryConfig::fromJson(config.value("repository", json::object()))),
+        write_behind_config_(WriteBehindConfig::fromJson(config.value("writeBehind", json::object()))),
+        password_hash_config_(config.value("passwordHash", json::object())),
         running_(false),
-        uuid_generator_(),
+        token_signer_(auth::TokenKeyConfig::fromJson(config.value("sessionToken", json::object()))),
         session_check_timer_(io_context),
         broadcast_timer_(io_context),
+        rate_limiter_(config.value("rateLimit", json::object())),
+        request_limits_(protocol::RequestLimits::fromJson(config.value("requestLimits", json::object()))),
+        user_cache_config_(UserCacheConfig::fromJson(config.value("userCache", json::object()))),
+        drain_config_(DrainConfig::fromJson(config.value("drain", json::object()))),
+        drain_timer_(io_context),
+        admin_config_(AdminConfig::fromJson(config.value("admin", json::object()))),
         version_(version)
     {
-        // DB풀 생성
-        db_pool_ = std::make_unique<DbPool>(db_connection_string, 20);
+        if (config.contains("resume")) {
+            resume_grace_ = std::chrono::seconds(
+                config["resume"].value("graceSeconds", static_cast<int>(resume_grace_.count())));
+            replay_buffer_size_ = config["resume"].value("replayBufferSize", replay_buffer_size_);
+        }
+        if (config.contains("mirror")) {
+            mirror_ack_timeout_ = std::chrono::milliseconds(
+                config["mirror"].value("ackTimeoutMs", static_cast<int>(mirror_ack_timeout_.count())));
+        }
+
+        // 요청 추적 설정 (느린 요청만 보관)
+        Tracer::instance().configure(TracingConfig::fromJson(config.value("tracing", json::object())));
+
+        // 리스닝 소켓 생성
+        open_acceptors(port);
+
+        // DB풀 생성 (메모리 저장소를 쓰면 PostgreSQL에 연결하지 않음)
+        if (!repository_config_.inMemory()) {
+            db_pool_ = std::make_unique<DbPool>(db_connection_string, 20);
+        }
 
         // 컨트롤러 초기화
         init_controllers();
@@ -49,10 +120,14 @@ namespace game_server {
         if (running_) {
             stop();
         }
+        // 게이지 콜백이 this를 참조하므로 소멸 전에 해제
+        Metrics::instance().removeGauges(this);
+        // 이후 io_context가 정리하면서 소멸하는 세션은 서버에 접근하지 않음
+        lifetime_.reset();
     }
 
     void Server::setSessionStatus(const json& users, bool flag) {
-        std::vector<std::string> tokens;
+        std::vector<auth::SessionToken> tokens;
         {
             std::lock_guard<std::mutex> tokens_lock(tokens_mutex_);
             for (const auto& user : users["users"]) {
@@ -63,11 +138,11 @@ namespace game_server {
         }
         {
             std::lock_guard<std::mutex> sesions_lock(sessions_mutex_);
-            for (const std::string& token : tokens) {
+            for (const auto& token : tokens) {
                 if (!sessions_.count(token)) continue;
                 auto session = sessions_[token].lock();
-                if (flag) session->setStatus("게임중");
-                else session->setStatus("대기중");
+                if (flag) session->setStatus(SessionStatus::inGame());
+                else session->setStatus(SessionStatus::waiting());
             }
         }
     }
@@ -76,6 +151,30 @@ namespace game_server {
         return version_;
     }
 
+    boost::asio::io_context& Server::getIoContext() {
+        return io_context_;
+    }
+
+    std::weak_ptr<const void> Server::lifetime() const {
+        return lifetime_;
+    }
+
+    std::chrono::milliseconds Server::getMirrorAckTimeout() {
+        return mirror_ack_timeout_;
+    }
+
+    RateLimiter& Server::getRateLimiter() {
+        return rate_limiter_;
+    }
+
+    BufferPool& Server::getReceiveBuffers() {
+        return receive_buffers_;
+    }
+
+    const protocol::RequestLimits& Server::getRequestLimits() const {
+        return request_limits_;
+    }
+
     bool Server::checkAlreadyLogin(int userId) {
         std::lock_guard<std::mutex> lock(tokens_mutex_);
         return tokens_.count(userId) > 0;
@@ -96,20 +195,20 @@ namespace game_server {
         if (!running_ || !timeout_check_running_) return;
         spdlog::debug("유효하지 않은 세션 체크 중...");
 
-        std::vector<std::string> sessionsToRemove;
+        std::vector<auth::SessionToken> sessionsToRemove;
         {
             std::lock_guard<std::mutex> lock(sessions_mutex_);
             for (const auto& [token, wsession] : sessions_) {
                 auto session = wsession.lock();
                 if (!session) {
                     // 세션이 이미 소멸됨
-                    spdlog::info("세션 {}가 이미 소멸되었습니다.", token);
+                    spdlog::debug("세션 {}가 이미 소멸되었습니다.", token.fingerprint());
                     sessionsToRemove.push_back(token);
                 }
                 else if (!session->isActive(session_timeout_)) {
                     // 세션이 존재하지만 타임아웃됨
-                    spdlog::info("세션 {}가 {}초간 연결이 없어 타임아웃 되었습니다.",
-                        token, session_timeout_.count());
+                    spdlog::debug("세션 {}가 {}초간 연결이 없어 타임아웃 되었습니다.",
+                        token.fingerprint(), session_timeout_.count());
                     sessionsToRemove.push_back(token);
                 }
             }
@@ -123,7 +222,7 @@ namespace game_server {
                 if (it != sessions_.end()) {
                     session = it->second.lock();
                     sessions_.erase(it);  // 컬렉션에서 세션 제거
-                    spdlog::info("세션 {}가 서버로 부터 삭제되었습니다.", token);
+                    spdlog::debug("세션 {}가 서버로 부터 삭제되었습니다.", token.fingerprint());
                 }
             }
 
@@ -131,6 +230,54 @@ namespace game_server {
                 session->handle_error("세션 타임 아웃 발생");
             }
         }
+        // 세션마다 남기던 로그는 디버그로 내리고 점검 주기마다 한 줄로 요약
+        if (!sessionsToRemove.empty()) {
+            spdlog::info("소멸 또는 {}초 타임아웃된 세션 {}개를 정리하였습니다", session_timeout_.count(), sessionsToRemove.size());
+        }
+
+        // 재개 대기 기간이 지난 세션 정리
+        expire_retained_sessions();
+
+        // 연결당 메모리 보고 (세션 블록 + 빌려준 수신 버퍼), 연결 수가 바뀐 경우에만 기록
+        std::size_t live_sessions = SessionPoolTag::pool().liveBlocks();
+        if (live_sessions != last_reported_sessions_) {
+            std::size_t session_bytes = SessionPoolTag::pool().blockSize();
+            std::size_t buffer_bytes = receive_buffers_.inUseBytes();
+            std::size_t per_connection = live_sessions ? session_bytes + buffer_bytes / live_sessions : session_bytes;
+            spdlog::info("연결 {}개, 연결당 메모리 약 {}바이트 (세션 블록 {}바이트, 수신 버퍼 사용 {}바이트 / 확보 {}바이트)",
+                live_sessions, per_connection, session_bytes, buffer_bytes, receive_buffers_.reservedBytes());
+            if (spdlog::should_log(spdlog::level::debug)) {
+                spdlog::debug("세션 풀: {}, 수신 버퍼 풀: {}", SessionPoolTag::pool().stats().dump(), receive_buffers_.stats().dump());
+            }
+            last_reported_sessions_ = live_sessions;
+        }
+
+        // 요청 수 제한 상태 정리 및 차단 카운터 보고
+        rate_limiter_.pruneIdleIps();
+        json counters = rate_limiter_.counters();
+        std::uint64_t rejected_total = counters["rejectedSession"].get<std::uint64_t>()
+            + counters["rejectedIp"].get<std::uint64_t>()
+            + counters["rejectedAction"].get<std::uint64_t>();
+        if (rejected_total != last_rejected_total_) {
+            spdlog::warn("요청 수 제한으로 차단된 요청 누적 {}건: {}", rejected_total, counters.dump());
+            last_rejected_total_ = rejected_total;
+        }
+
+        // 지연 반영 큐 상태 보고 (실패나 상한 초과가 늘어난 경우 경고)
+        if (write_behind_) {
+            json write_behind_stats = write_behind_->stats();
+            std::uint64_t errors = write_behind_stats["overflows"].get<std::uint64_t>();
+            for (const auto& [kind, stats] : write_behind_stats["kinds"].items()) {
+                errors += stats["failures"].get<std::uint64_t>();
+            }
+            if (errors != last_write_behind_errors_) {
+                spdlog::warn("지연 반영 큐 실패/상한 초과 누적 {}건: {}", errors, write_behind_stats.dump());
+                last_write_behind_errors_ = errors;
+            }
+            else if (spdlog::should_log(spdlog::level::debug)) {
+                spdlog::debug("지연 반영 큐 상태: {}", write_behind_stats.dump());
+            }
+        }
 
         session_check_timer_.expires_after(std::chrono::seconds(10));
         session_check_timer_.async_wait([this](const boost::system::error_code& ec) {
@@ -161,29 +308,38 @@ namespace game_server {
             });
     }
 
-    std::string Server::generateSessionToken() {
-        boost::uuids::uuid uuid = uuid_generator_();
-        return boost::uuids::to_string(uuid);
+    auth::SessionToken Server::generateSessionToken(int userId) {
+        return token_signer_.issue(userId);
+    }
+
+    auth::TokenStatus Server::verifySessionToken(std::string_view token, auth::TokenClaims* claims) const {
+        return token_signer_.verify(token, claims);
+    }
+
+    void Server::reloadTokenKeys(const json& config) {
+        token_signer_.rotate(auth::TokenKeyConfig::fromJson(config.value("sessionToken", json::object())));
     }
 
-    std::string Server::registerSession(std::shared_ptr<Session> session) {
+    auth::SessionToken Server::registerSession(std::shared_ptr<Session> session) {
+        // 서명과 난수 생성은 잠금 밖에서 수행
+        int userId = session->getUserId();
+        auth::SessionToken token = generateSessionToken(userId);
+
         std::lock_guard<std::mutex> lock(sessions_mutex_);
 
         // 기존 세션이 존재하면 제거
         for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
             if (it->second.lock() == session) {
-                spdlog::info("이전에 할당된 토큰 확인, 삭제 후 새로운 토큰 할당: {}", it->first);
+                spdlog::info("이전에 할당된 토큰 확인, 삭제 후 새로운 토큰 할당: {}", it->first.fingerprint());
                 sessions_.erase(it);
                 break;  // 한 개만 삭제하면 되므로 루프 종료
             }
         }
 
-        std::string token = generateSessionToken();
         sessions_[token] = session;
-        int userId = session->getUserId();
         if (userId) {
             tokens_[userId] = token;
-            spdlog::info("유저ID : {}에게 토큰ID : {} 할당 완료", userId, token);
+            spdlog::info("유저ID : {}에게 토큰ID : {} 할당 완료", userId, token.fingerprint());
         }
         return token;
     }
@@ -204,24 +360,28 @@ namespace game_server {
         return;
     }
 
-    void Server::removeSession(const std::string& token, int userId) {
+    void Server::removeSession(const auth::SessionToken& token, int userId) {
         std::lock_guard<std::mutex> session_lock(sessions_mutex_);
         std::lock_guard<std::mutex> token_lock(tokens_mutex_);
 
         bool found = false;
         auto it_session = sessions_.find(token);
         if (it_session != sessions_.end()) {
+            // 세션 재개로 같은 토큰을 새 세션이 이어받은 경우 제거하지 않음
+            if (it_session->second.lock()) {
+                return;
+            }
             sessions_.erase(it_session);
             found = true;
         }
 
         auto it_token = tokens_.find(userId);
-        if (it_token != tokens_.end()) {
+        if (it_token != tokens_.end() && it_token->second == token) {
             tokens_.erase(it_token);
             found = true;
         }
         if (found) {
-            spdlog::info("유저 ID : {}의 토큰 삭제 완료, 토큰 ID : {}", userId, token);
+            spdlog::info("유저 ID : {}의 토큰 삭제 완료, 토큰 ID : {}", userId, token.fingerprint());
         }
     }
 
@@ -234,7 +394,7 @@ namespace game_server {
         }
     }
 
-    std::shared_ptr<Session> Server::getSession(const std::string& token) {
+    std::shared_ptr<Session> Server::getSession(const auth::SessionToken& token) {
         std::lock_guard<std::mutex> lock(sessions_mutex_);
         auto it = sessions_.find(token);
         if (it != sessions_.end()) {
@@ -245,7 +405,7 @@ namespace game_server {
             else {
                 // 세션이 이미 소멸된 경우 맵에서 제거
                 sessions_.erase(it);
-                spdlog::info("토큰 ID : {}가 이미 삭제된 상태입니다, 세션 정보를 서버에서 제거하였습니다.", token);
+                spdlog::info("토큰 ID : {}가 이미 삭제된 상태입니다, 세션 정보를 서버에서 제거하였습니다.", token.fingerprint());
             }
         }
         return nullptr;
@@ -284,7 +444,7 @@ namespace game_server {
         for (const auto& obj : sessions_) {
             auto session = obj.second.lock();
             if (!session || !session->getUserId()) continue;
-            if (session->getStatus() == "대기중") {
+            if (session->getStatus().isWaiting()) {
                 waitingSessions.push_back(session);
             }
         }
@@ -305,15 +465,17 @@ namespace game_server {
 
                 json userInfo;
                 userInfo["nickName"] = session->getUserNickName();
-                userInfo["status"] = session->getStatus();
+                userInfo["status"] = session->getStatus().toString();
                 broadcast["users"].push_back(userInfo);
 
-                if (session->getStatus() == "대기중") {
+                if (session->getStatus().isWaiting()) {
                     waitingSessions.push_back(session);
                 }
             }
         }
-        broadcastActiveUser(broadcast.dump(), waitingSessions);
+        std::string message = broadcast.dump();
+        broadcastActiveUser(message, waitingSessions);
+        buffer_for_retained_waiting(message, ReplayKind::CCUList);
     }
 
     void Server::broadcastLogin(const std::string& nickName) {
@@ -322,7 +484,9 @@ namespace game_server {
             {"nickName", nickName}
         };
         auto waitingSessions = getWaitingSessions();
-        broadcastActiveUser(broadcast.dump(), waitingSessions);
+        std::string message = broadcast.dump();
+        broadcastActiveUser(message, waitingSessions);
+        buffer_for_retained_waiting(message, ReplayKind::NewLogin);
     }
 
     void Server::broadcastChat(const std::string& nickName, const std::string& message) {
@@ -332,26 +496,311 @@ namespace game_server {
             {"message", message}
         };
         auto waitingSessions = getWaitingSessions();
-        broadcastActiveUser(broadcast.dump(), waitingSessions);
+        std::string payload = broadcast.dump();
+        broadcastActiveUser(payload, waitingSessions);
+        buffer_for_retained_waiting(payload, ReplayKind::Chat);
+    }
+
+    bool Server::retainSession(const auth::SessionToken& token, RetainedSession state) {
+        if (resume_grace_.count() <= 0 || draining_) return false;
+
+        state.expires_at = std::chrono::steady_clock::now() + resume_grace_;
+        int userId = state.user_id;
+        {
+            std::lock_guard<std::mutex> lock(retained_mutex_);
+            retained_[token] = std::move(state);
+        }
+        spdlog::info("유저 ID : {}의 세션을 {}초간 재개 대기 상태로 보관합니다", userId, resume_grace_.count());
+        return true;
+    }
+
+    std::optional<RetainedSession> Server::resumeSession(const std::string& tokenText, std::shared_ptr<Session> session) {
+        // 위조/만료된 토큰은 세션 맵과 보관 세션을 잠그기 전에 거절
+        auth::SessionToken token;
+        auth::TokenClaims claims;
+        auth::TokenStatus status = auth::SessionToken::parse(tokenText, token)
+            ? verifySessionToken(token.view(), &claims) : auth::TokenStatus::Malformed;
+        if (status != auth::TokenStatus::Valid || claims.user_id <= 0) {
+            spdlog::debug("세션 재개 토큰 검증 실패: {}", auth::toString(status));
+            return std::nullopt;
+        }
+
+        // 서버가 아직 끊김을 감지하지 못한 기존 연결이 있으면 먼저 보관 상태로 전환
+        std::shared_ptr<Session> previous;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            auto it = sessions_.find(token);
+            if (it != sessions_.end()) {
+                previous = it->second.lock();
+            }
+        }
+        if (previous && previous != session && previous->getUserId() > 0) {
+            previous->detachForResume(false);
+        }
+        previous.reset();
+
+        RetainedSession state;
+        {
+            std::lock_guard<std::mutex> lock(retained_mutex_);
+            auto it = retained_.find(token);
+            if (it == retained_.end() || it->second.expires_at <= std::chrono::steady_clock::now() ||
+                it->second.user_id != claims.user_id) {
+                return std::nullopt;
+            }
+            state = std::move(it->second);
+            retained_.erase(it);
+        }
+
+        {
+            std::lock_guard<std::mutex> session_lock(sessions_mutex_);
+            std::lock_guard<std::mutex> token_lock(tokens_mutex_);
+
+            // 핸드셰이크 때 발급한 임시 토큰 해제 후 기존 토큰으로 재등록
+            auto it = sessions_.find(session->getToken());
+            if (it != sessions_.end() && it->second.lock() == session) {
+                sessions_.erase(it);
+            }
+            sessions_[token] = session;
+            tokens_[state.user_id] = token;
+        }
+
+        spdlog::info("유저 ID : {}의 세션이 재개되었습니다, 밀린 메시지 {}건", state.user_id, state.missed_messages.size());
+        return state;
+    }
+
+    void Server::bufferRetainedMessage(const auth::SessionToken& token, const std::string& message) {
+        {
+            std::lock_guard<std::mutex> lock(retained_mutex_);
+            auto it = retained_.find(token);
+            if (it != retained_.end()) {
+                auto& missed = it->second.missed_messages;
+                missed.push_back({ ReplayKind::Response, message });
+                while (missed.size() > replay_buffer_size_) {
+                    missed.pop_front();
+                }
+                return;
+            }
+        }
+
+        // 이미 재개된 경우 새 연결로 전달
+        std::shared_ptr<Session> resumed;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            auto it = sessions_.find(token);
+            if (it != sessions_.end()) {
+                resumed = it->second.lock();
+            }
+        }
+        if (resumed) {
+            resumed->write_broadcast(message);
+        }
+    }
+
+    // 대기실 브로드캐스트를 재개 대기 중인 대기실 유저에게도 보관, 최신 것만 의미 있는 종류는 이전 메시지를 대체
+    void Server::buffer_for_retained_waiting(const std::string& message, ReplayKind kind) {
+        std::lock_guard<std::mutex> lock(retained_mutex_);
+        for (auto& [token, state] : retained_) {
+            if (!state.status.isWaiting()) continue;
+
+            auto& missed = state.missed_messages;
+            if (kind == ReplayKind::CCUList) {
+                // 동접자 목록은 최신 것만 의미가 있으므로 이전 목록을 제거 (내용이 아닌 종류로 구분)
+                for (auto it = missed.begin(); it != missed.end(); ++it) {
+                    if (it->kind == kind) {
+                        missed.erase(it);
+                        break;
+                    }
+                }
+            }
+            missed.push_back({ kind, message });
+            while (missed.size() > replay_buffer_size_) {
+                missed.pop_front();
+            }
+        }
+    }
+
+    // 새로 로그인한 유저의 보관 세션은 더 이상 재개되지 않으므로 정리
+    void Server::discardRetainedUser(int userId) {
+        bool found = false;
+        {
+            std::lock_guard<std::mutex> lock(retained_mutex_);
+            for (auto it = retained_.begin(); it != retained_.end(); ++it) {
+                if (it->second.user_id == userId) {
+                    retained_.erase(it);
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (found) {
+            spdlog::info("유저 ID : {}가 새로 로그인하여 보관 중인 세션을 폐기합니다", userId);
+            exit_room_for_user(userId);
+        }
+    }
+
+    bool Server::takeOverConnection(const std::string& tokenText, const RemoteAddress& ipAddress) {
+        auth::SessionToken token;
+        auth::TokenClaims claims;
+        if (!auth::SessionToken::parse(tokenText, token) ||
+            verifySessionToken(token.view(), &claims) != auth::TokenStatus::Valid || claims.user_id <= 0) {
+            return false;
+        }
+
+        std::shared_ptr<Session> previous;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            auto it = sessions_.find(token);
+            if (it == sessions_.end()) return false;
+            previous = it->second.lock();
+        }
+        if (!previous || previous->getUserId() != claims.user_id || previous->getRemoteIp() != ipAddress) {
+            return false;
+        }
+
+        // 기존 연결의 IP 슬롯은 새 연결이 이어받으므로 소멸 시 해제하지 않도록 함
+        previous->detachForResume(true);
+        return true;
+    }
+
+    void Server::expire_retained_sessions() {
+        std::vector<int> expired;
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(retained_mutex_);
+            for (auto it = retained_.begin(); it != retained_.end();) {
+                if (it->second.expires_at <= now) {
+                    expired.push_back(it->second.user_id);
+                    it = retained_.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+        // 재개되지 않은 세션은 연결 종료 시와 동일하게 방에서 퇴장 처리
+        for (int userId : expired) {
+            spdlog::info("유저 ID : {}의 재개 대기 기간이 지나 세션을 정리합니다", userId);
+            exit_room_for_user(userId);
+        }
+    }
+
+    void Server::exit_room_for_user(int userId) {
+        try {
+            auto controller_it = controllers_.find("room");
+            if (controller_it == controllers_.end() || userId <= 0) return;
+
+            json temp = {
+                {"action", "exitRoom"},
+                {"userId", userId}
+            };
+            json response = controller_it->second->handleRequest(temp);
+            if (response.contains("status") && response["status"] == "success") {
+                spdlog::info("사용자 {}가 세션 정리 시 자동으로 방에서 퇴장하였습니다", userId);
+            }
+        }
+        catch (const std::exception& e) {
+            spdlog::error("방 퇴장 중 에러가 발생하였습니다. : {}", e.what());
+        }
     }
 
     void Server::broadcastActiveUser(const std::string& message, const std::vector<std::shared_ptr<Session>>& sessions) {
+        static const Metrics::Histogram fanout = Metrics::instance().histogram(
+            "matching_broadcast_fanout", "브로드캐스트 한 번에 메시지를 받은 세션 수", Metrics::sizeBuckets());
+        fanout.observe(sessions.size());
         for (const auto& session : sessions) {
             session->write_broadcast(message);
         }
     }
 
+    // 스크레이프 시 읽는 게이지 등록 후 관리용 포트 열기 (실패해도 게임 서버는 계속 동작)
+    void Server::start_admin_server() {
+        if (!admin_config_.enabled) return;
+
+        Metrics& metrics = Metrics::instance();
+        metrics.gauge("matching_ccu", "접속 중인 세션 수", [this]() { return static_cast<double>(getCCU()); }, this);
+        metrics.gauge("matching_room_capacity", "연결된 미러 서버(방) 수", [this]() { return static_cast<double>(getRoomCapacity()); }, this);
+        metrics.gauge("matching_retained_sessions", "재개를 기다리는 세션 수", [this]() {
+            std::lock_guard<std::mutex> lock(retained_mutex_);
+            return static_cast<double>(retained_.size());
+            }, this);
+        metrics.gauge("matching_inflight_operations", "응답을 기다리는 비동기 작업 수", [this]() {
+            return static_cast<double>(inflight_operations_.load());
+            }, this);
+        metrics.gauge("matching_auth_queue_depth", "인증 워커 대기열 길이", [this]() {
+            return hash_pool_ ? static_cast<double>(hash_pool_->queueDepth()) : 0.0;
+            }, this);
+        metrics.gauge("matching_receive_buffer_bytes", "수신 버퍼 풀 메모리", [this]() {
+            return static_cast<double>(receive_buffers_.reservedBytes());
+            }, this, "state=\"reserved\"");
+        metrics.gauge("matching_receive_buffer_bytes", "수신 버퍼 풀 메모리", [this]() {
+            return static_cast<double>(receive_buffers_.inUseBytes());
+            }, this, "state=\"in_use\"");
+        metrics.gauge("matching_log_dropped_total", "비동기 로그 큐가 가득 차 버려진 로그 수", []() {
+            return static_cast<double>(droppedLogMessages());
+            }, this);
+
+        try {
+            admin_server_ = std::make_unique<AdminServer>(io_context_, admin_config_);
+            admin_server_->addRoute("/metrics", []() {
+                return AdminServer::Response{ "text/plain; version=0.0.4; charset=utf-8", Metrics::instance().renderPrometheus() };
+                });
+            // 보관 중인 느린 요청 추적 (OTLP JSON, 수집기에 그대로 전달 가능)
+            admin_server_->addRoute("/traces", []() {
+                return AdminServer::Response{ "application/json", Tracer::instance().exportOtlp().dump() };
+                });
+            admin_server_->addRoute("/traces/export", []() {
+                std::size_t count = Tracer::instance().exportToFile();
+                return AdminServer::Response{ "application/json", json{ {"exported", count} }.dump() };
+                });
+            admin_server_->addRoute("/traces/stats", []() {
+                return AdminServer::Response{ "application/json", Tracer::instance().stats().dump() };
+                });
+            admin_server_->start();
+        }
+        catch (const std::exception& e) {
+            spdlog::error("관리용 엔드포인트를 열지 못했습니다: {}", e.what());
+            admin_server_.reset();
+        }
+    }
+
     void Server::init_controllers() {
         // 레포지토리 생성
-        auto userRepo = UserRepository::create(db_pool_.get());
-        auto roomRepo = RoomRepository::create(db_pool_.get());
-        auto gameRepo = GameRepository::create(db_pool_.get());
+        // last_login, 게임 완료 처리 등 비핵심 갱신은 지연 반영 큐로 모아서 처리
+        write_behind_ = std::make_unique<WriteBehindQueue>(write_behind_config_);
+
+        std::unique_ptr<UserRepository> userRepo;
+        std::unique_ptr<RoomRepository> roomRepo;
+        std::unique_ptr<GameRepository> gameRepo;
+        if (repository_config_.inMemory()) {
+            // DB 없이 소켓/JSON/디스패치 계층만 측정하기 위한 메모리 저장소 (재시작하면 데이터가 사라짐)
+            auto database = MemoryRepository::createDatabase(repository_config_);
+            userRepo = MemoryRepository::createUserRepository(database);
+            roomRepo = MemoryRepository::createRoomRepository(database);
+            gameRepo = MemoryRepository::createGameRepository(database);
+            spdlog::warn("메모리 리포지토리를 사용합니다. 데이터는 저장되지 않습니다");
+        }
+        else {
+            userRepo = UserRepository::create(db_pool_.get(), write_behind_.get());
+            roomRepo = RoomRepository::create(db_pool_.get(), write_behind_.get());
+            gameRepo = GameRepository::create(db_pool_.get(), write_behind_.get());
+        }
+        if (user_cache_config_.enabled) {
+            userRepo = CachedUserRepository::create(std::move(userRepo), user_cache_config_);
+        }
 
         std::shared_ptr<UserRepository> sharedUserRepo = std::move(userRepo);
         std::shared_ptr<RoomRepository> sharedRoomRepo = std::move(roomRepo);
         std::shared_ptr<GameRepository> sharedGameRepo = std::move(gameRepo);
         spdlog::info("레포지토리 객체 생성 및 포인터화 완료");
 
+        // 비밀번호 해시 비용 설정 및 해시 전용 워커 풀 생성
+        PasswordUtil::configure(PasswordHashConfig::fromJson(password_hash_config_));
+        std::size_t default_threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+        hash_pool_ = std::make_unique<WorkerPool>("인증",
+            password_hash_config_.value("workerThreads", default_threads),
+            password_hash_config_.value("maxQueue", static_cast<std::size_t>(256)));
+
         // 서비스 생성
         auto authService = AuthService::create(sharedUserRepo);
         auto roomService = RoomService::create(sharedRoomRepo);
@@ -359,18 +808,222 @@ namespace game_server {
         spdlog::info("레포지토리와 서비스 연동 및 서비스 객체 생성 완료");
 
         // 컨트롤러 생성 및 등록
-        controllers_["auth"] = std::make_shared<AuthController>(std::move(authService));
+        controllers_["auth"] = std::make_shared<AuthController>(std::move(authService), hash_pool_.get());
         controllers_["room"] = std::make_shared<RoomController>(std::move(roomService));
         controllers_["game"] = std::make_shared<GameController>(std::move(gameService));
         spdlog::info("서비스와 컨트롤러 연동 및 컨트롤러 객체 생성, 핸들러 할당 완료");
     }
 
+    void Server::open_acceptors(short port) {
+        // 기존 프로세스가 리스닝 소켓을 인계해 주면 새로 바인딩하지 않고 그대로 사용
+        if (assign_inherited_acceptors()) {
+            return;
+        }
+
+        boost::system::error_code ec;
+        auto address = boost::asio::ip::make_address(listener_config_.bind_address, ec);
+        if (ec) {
+            spdlog::warn("잘못된 바인드 주소 {}, 기본 주소(::)를 사용합니다", listener_config_.bind_address);
+            address = boost::asio::ip::address_v6::any();
+        }
+        boost::asio::ip::tcp::endpoint endpoint(address, port);
+
+        int count = listener_config_.acceptors;
+#if !defined(SO_REUSEPORT)
+        count = 1;
+#endif
+        if (!listener_config_.reuse_port) count = 1;
+
+        for (int i = 0; i < count; ++i) {
+            auto acceptor = std::make_unique<boost::asio::ip::tcp::acceptor>(io_context_);
+            acceptor->open(endpoint.protocol(), ec);
+            if (ec && endpoint.address().is_v6()) {
+                // IPv6를 지원하지 않는 환경이면 IPv4로 대체
+                spdlog::warn("IPv6 소켓을 열 수 없어 IPv4로 바인딩합니다: {}", ec.message());
+                endpoint = boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port);
+                acceptor->open(endpoint.protocol(), ec);
+            }
+            if (ec) {
+                throw boost::system::system_error(ec, "acceptor open");
+            }
+
+            acceptor->set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+#if defined(SO_REUSEPORT)
+            if (listener_config_.reuse_port) {
+                acceptor->set_option(reuse_port_option(true));
+            }
+#endif
+            if (endpoint.address().is_v6()) {
+                // 듀얼 스택: IPv4 클라이언트도 같은 소켓으로 수락 (::ffff:a.b.c.d)
+                acceptor->set_option(boost::asio::ip::v6_only(false), ec);
+            }
+            acceptor->bind(endpoint);
+            acceptor->listen(listener_config_.backlog);
+            // 배치 accept 시 대기 중인 연결이 없으면 즉시 반환하도록 논블로킹 설정
+            acceptor->non_blocking(true);
+            acceptors_.push_back(std::move(acceptor));
+        }
+
+        spdlog::info("리스닝 소켓 {}개 생성 완료, 주소 : {}, 백로그 : {}",
+            acceptors_.size(), endpoint.address().to_string(), listener_config_.backlog);
+    }
+
+    bool Server::assign_inherited_acceptors() {
+#ifndef _WIN32
+        if (drain_config_.handoff_socket_path.empty()) return false;
+
+        std::vector<int> fds = ListenerHandoff::receive(drain_config_.handoff_socket_path, std::chrono::milliseconds(3000));
+        for (int fd : fds) {
+            sockaddr_storage storage{};
+            socklen_t length = sizeof(storage);
+            if (::getsockname(fd, reinterpret_cast<sockaddr*>(&storage), &length) != 0) {
+                ::close(fd);
+                continue;
+            }
+            auto protocol = storage.ss_family == AF_INET6 ? boost::asio::ip::tcp::v6() : boost::asio::ip::tcp::v4();
+            auto acceptor = std::make_unique<boost::asio::ip::tcp::acceptor>(io_context_);
+            acceptor->assign(protocol, fd);
+            acceptor->non_blocking(true);
+            acceptors_.push_back(std::move(acceptor));
+        }
+        return !acceptors_.empty();
+#else
+        return false;
+#endif
+    }
+
+    std::vector<int> Server::listener_handles() {
+        std::vector<int> handles;
+        for (auto& acceptor : acceptors_) {
+            if (acceptor->is_open()) {
+                handles.push_back(static_cast<int>(acceptor->native_handle()));
+            }
+        }
+        return handles;
+    }
+
+    void Server::close_acceptors() {
+        for (auto& acceptor : acceptors_) {
+            boost::system::error_code ec;
+            if (acceptor->is_open()) {
+                acceptor->close(ec);
+            }
+            if (ec) {
+                spdlog::error("리스닝 소켓 종료 중 에러가 발생하였습니다. : {}", ec.message());
+            }
+        }
+    }
+
+    bool Server::isDraining() const {
+        return draining_;
+    }
+
+    void Server::setShutdownHandler(std::function<void()> handler) {
+        shutdown_handler_ = std::move(handler);
+    }
+
+    void Server::beginOperation() {
+        inflight_operations_++;
+    }
+
+    void Server::endOperation() {
+        inflight_operations_--;
+    }
+
+    void Server::drain() {
+        if (draining_.exchange(true)) return;
+
+        drain_deadline_ = std::chrono::steady_clock::now() + drain_config_.deadline;
+        spdlog::info("서버 드레인 시작, 진행 중인 작업을 최대 {}초 기다립니다", drain_config_.deadline.count());
+
+        // 새 연결 수락 중단 (인계한 경우 새 프로세스가 같은 소켓으로 계속 수락)
+        close_acceptors();
+        if (handoff_) {
+            handoff_->stop();
+        }
+
+        // 접속 중인 클라이언트에 재접속 안내
+        json notice = {
+            {"action", "serverDraining"},
+            {"message", "서버 점검으로 연결이 곧 종료됩니다. 다시 접속해주세요"},
+            {"reconnectAfterMs", drain_config_.reconnect_after_ms}
+        };
+        if (!drain_config_.reconnect_address.empty()) {
+            notice["reconnectAddress"] = drain_config_.reconnect_address;
+        }
+
+        std::vector<std::shared_ptr<Session>> targets;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            for (const auto& [token, wsession] : sessions_) {
+                if (auto session = wsession.lock()) {
+                    targets.push_back(session);
+                }
+            }
+        }
+        broadcastActiveUser(notice.dump(), targets);
+
+        check_drain_progress();
+    }
+
+    // DB 트랜잭션은 io 스레드에서 동기로 끝나므로, 남은 것은 비동기 작업과 전송 대기 중인 응답
+    void Server::check_drain_progress() {
+        bool pending_writes = false;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            for (const auto& [token, wsession] : sessions_) {
+                auto session = wsession.lock();
+                if (session && session->hasPendingWrites()) {
+                    pending_writes = true;
+                    break;
+                }
+            }
+        }
+
+        int inflight = inflight_operations_;
+        bool idle = inflight == 0 && !pending_writes;
+        if (idle || std::chrono::steady_clock::now() >= drain_deadline_) {
+            if (!idle) {
+                spdlog::warn("드레인 제한 시간 초과, 진행 중인 작업 {}건을 남기고 종료합니다", inflight);
+            }
+            else {
+                spdlog::info("진행 중인 작업이 모두 완료되어 서버를 종료합니다");
+            }
+            stop();
+            if (shutdown_handler_) {
+                shutdown_handler_();
+            }
+            return;
+        }
+
+        drain_timer_.expires_after(std::chrono::milliseconds(100));
+        drain_timer_.async_wait([this](const boost::system::error_code& ec) {
+            if (!ec) {
+                check_drain_progress();
+            }
+            });
+    }
+
     void Server::run()
     {
         running_ = true;
-        do_accept();
+        for (auto& acceptor : acceptors_) {
+            do_accept(*acceptor);
+        }
+
+        // 다음 배포의 새 프로세스가 리스닝 소켓을 넘겨받을 수 있도록 인계 요청 대기
+        if (!drain_config_.handoff_socket_path.empty() && ListenerHandoff::supported()) {
+            handoff_ = std::make_unique<ListenerHandoff>(io_context_, drain_config_.handoff_socket_path,
+                [this]() { return listener_handles(); },
+                [this]() {
+                    spdlog::info("리스닝 소켓 인계 완료, 기존 프로세스 드레인 시작");
+                    drain();
+                });
+            handoff_->start();
+        }
         startSessionTimeoutCheck();
         startBroadcastTimer();
+        start_admin_server();
         spdlog::info("서버 실행 완료, 클라이언트 연결 요청을 기다리는 중...");
     }
 
@@ -384,38 +1037,68 @@ namespace game_server {
         // 타이머 취소 및 대기
         session_check_timer_.cancel();
         broadcast_timer_.cancel();
+        drain_timer_.cancel();
+        if (handoff_) {
+            handoff_->stop();
+        }
+        if (admin_server_) {
+            admin_server_->stop();
+        }
 
-        // 모든 세션에 종료 알림
+        // 세션 목록은 잠금 안에서 복사만 하고, 종료 처리는 잠금 밖에서 수행
+        // (handle_error의 방 퇴장 처리나 세션 소멸자의 removeSession이 같은 뮤텍스를 잡으므로)
+        std::vector<std::shared_ptr<Session>> sessions;
         {
             std::lock_guard<std::mutex> lock(sessions_mutex_);
             for (auto& [token, wsession] : sessions_) {
-                auto session = wsession.lock();
-                try {
-                    if (session) {
-                        session->handle_error("서버 중단으로 인한 연결 종료");
-                    }
-                }
-                catch (const std::exception& e) {
-                    spdlog::error("세션을 정리하던 중 에러가 발생하였습니다. : {}", e.what());
+                if (auto session = wsession.lock()) {
+                    sessions.push_back(session);
                 }
             }
             sessions_.clear();
         }
 
-        // acceptor 닫기
-        try {
-            if (acceptor_.is_open()) {
-                acceptor_.close();
+        // 모든 세션에 종료 알림
+        for (auto& session : sessions) {
+            try {
+                session->handle_error("서버 중단으로 인한 연결 종료", false);
+            }
+            catch (const std::exception& e) {
+                spdlog::error("세션을 정리하던 중 에러가 발생하였습니다. : {}", e.what());
             }
         }
-        catch (const std::exception& e) {
-            spdlog::error("서버 종료 중 에러가 발생하였습니다. : {}", e.what());
+        sessions.clear();
+
+        // 재개를 기다리던 세션은 더 이상 재개될 수 없으므로 방에서 퇴장 처리
+        std::vector<int> retained_users;
+        {
+            std::lock_guard<std::mutex> lock(retained_mutex_);
+            for (const auto& [token, state] : retained_) {
+                retained_users.push_back(state.user_id);
+            }
+            retained_.clear();
+        }
+        for (int userId : retained_users) {
+            exit_room_for_user(userId);
+        }
+
+        // 처리 중인 인증 요청을 마저 처리 (로그인 시간 등이 지연 반영 큐에 들어올 수 있으므로 먼저 종료)
+        if (hash_pool_) {
+            hash_pool_->stop();
         }
 
+        // 지연 반영 중인 갱신을 모두 DB에 반영
+        if (write_behind_) {
+            write_behind_->stop();
+        }
+
+        // acceptor 닫기
+        close_acceptors();
+
         spdlog::info("서버 중단");
     }
 
-    bool Server::allowConnection(const std::string& ipAddress) {
+    bool Server::allowConnection(const RemoteAddress& ipAddress) {
         std::lock_guard<std::mutex> lock(connected_ips_mutex_);
         if (connected_ips_.count(ipAddress)) {
             return false;
@@ -424,30 +1107,77 @@ namespace game_server {
         return true;
     }
 
-    void Server::removeConnection(const std::string& ipAddress) {
+    void Server::removeConnection(const RemoteAddress& ipAddress) {
         std::lock_guard<std::mutex> lock(connected_ips_mutex_);
         connected_ips_.erase(ipAddress);
     }
 
-    void Server::do_accept()
+    void Server::do_accept(boost::asio::ip::tcp::acceptor& acceptor)
     {
-        acceptor_.async_accept(
-            [this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
+        acceptor.async_accept(
+            [this, &acceptor](boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
                 if (!ec) {
-                    // 세션 생성 및 시작
-                    auto session = std::make_shared<Session>(std::move(socket), controllers_, this);
-                    session->start();
+                    accept_socket(std::move(socket));
+
+                    // 재접속 폭주 시 백로그에 쌓인 연결을 한 번에 꺼내 처리 (논블로킹 accept)
+                    for (int i = 1; i < listener_config_.accept_batch && running_; ++i) {
+                        boost::system::error_code batch_ec;
+                        boost::asio::ip::tcp::socket pending = acceptor.accept(batch_ec);
+                        if (batch_ec) {
+                            if (batch_ec != boost::asio::error::would_block && batch_ec != boost::asio::error::try_again) {
+                                static LogThrottle throttle;
+                                logThrottled(throttle, LogContext{}, spdlog::level::err, "연결 일괄 수락 중 에러가 발생하였습니다. : {}", batch_ec.message());
+                            }
+                            break;
+                        }
+                        accept_socket(std::move(pending));
+                    }
+                }
+                else if (ec == boost::asio::error::operation_aborted) {
+                    return;
                 }
                 else {
-                    spdlog::error("클라이언트 연결을 받아 들이던 중 에러가 발생하였습니다. : {}", ec.message());
+                    // 파일 디스크립터 고갈 등은 연달아 발생하므로 반복 로그 제한
+                    static LogThrottle throttle;
+                    logThrottled(throttle, LogContext{}, spdlog::level::err, "클라이언트 연결을 받아 들이던 중 에러가 발생하였습니다. : {}", ec.message());
                 }
 
                 // 계속해서 연결 수락 (서버가 여전히 실행 중인 경우)
-                if (running_) {
-                    do_accept();
+                if (running_ && acceptor.is_open()) {
+                    do_accept(acceptor);
                 }
             }
         );
     }
 
+    void Server::accept_socket(boost::asio::ip::tcp::socket socket) {
+        try {
+            configure_socket(socket);
+
+            // 세션 생성 및 시작
+            auto session = std::allocate_shared<Session>(SessionAllocator(), std::move(socket), controllers_, this);
+            session->start();
+        }
+        catch (const std::exception& e) {
+            // 수락 직후 연결이 끊긴 경우(remote_endpoint 실패 등) 해당 연결만 버림
+            spdlog::warn("수락한 연결을 초기화하지 못했습니다. : {}", e.what());
+        }
+    }
+
+    void Server::configure_socket(boost::asio::ip::tcp::socket& socket) {
+        boost::system::error_code ec;
+        if (listener_config_.no_delay) {
+            socket.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+        }
+        if (listener_config_.keep_alive) {
+            socket.set_option(boost::asio::socket_base::keep_alive(true), ec);
+#if defined(TCP_KEEPIDLE)
+            socket.set_option(keep_idle_option(listener_config_.keep_alive_idle_seconds), ec);
+#endif
+        }
+        if (ec) {
+            spdlog::debug("소켓 옵션 설정 실패: {}", ec.message());
+        }
+    }
+
 } // namespace game_server
\ No newline at end of file
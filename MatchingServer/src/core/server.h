@@ -4,15 +4,28 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <deque>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <mutex>
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-#include <boost/uuid/uuid_io.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <nlohmann/json.hpp>
+#include "auth/signed_token.h"
+#include "protocol/request_limits.h"
 #include "../controller/controller.h"
 #include "../util/db_pool.h"
+#include "rate_limiter.h"
+#include "listener_handoff.h"
+#include "admin_server.h"
+#include "session_identity.h"
+#include "../repository/cached_user_repository.h"
+#include "../repository/memory_repository.h"
+#include "../util/write_behind_queue.h"
+#include "../util/worker_pool.h"
+#include "../util/buffer_pool.h"
 
 namespace game_server {
 
@@ -20,27 +33,91 @@ namespace game_server {
 
     class Session;
 
+    // 리스닝 소켓 및 accept 경로 설정 (config.json의 "listener" 섹션)
+    struct ListenerConfig {
+        std::string bind_address = "::";  // "::"이면 IPv4/IPv6 듀얼 스택
+        int backlog = 1024;
+        int acceptors = 1;                 // SO_REUSEPORT로 같은 포트에 바인딩할 acceptor 수
+        // acceptor가 2개 이상일 때만 켬 (하나일 때 켜면 실수로 띄운 두 번째 프로세스가 조용히 포트를 나눠 가짐)
+        bool reuse_port = false;
+        int accept_batch = 32;             // 한 번의 accept 완료 시 추가로 꺼낼 최대 연결 수
+        bool no_delay = true;
+        bool keep_alive = true;
+        int keep_alive_idle_seconds = 30;
+
+        static ListenerConfig fromJson(const json& config);
+    };
+
+    // 재개 시 재전송할 메시지 종류 (최신 것만 의미 있는 종류는 이전 것을 대체)
+    enum class ReplayKind : std::uint8_t {
+        Response,   // 끊긴 뒤 도착한 요청 응답
+        NewLogin,
+        Chat,
+        CCUList     // 동접자 목록, 최신 것만 유지
+    };
+
+    struct MissedMessage {
+        ReplayKind kind;
+        std::string payload;
+    };
+
+    // 연결이 끊긴 로그인 세션의 상태 (재개 대기 기간 동안 보관)
+    struct RetainedSession {
+        int user_id = 0;
+        std::string user_name;
+        NickName nick_name;
+        SessionStatus status;
+        RemoteAddress remote_ip;
+        std::deque<MissedMessage> missed_messages;   // 끊긴 동안 받지 못한 메시지 (링 버퍼)
+        std::chrono::steady_clock::time_point expires_at;
+    };
+
+    // 종료 시 드레인 설정 (config.json의 "drain" 섹션)
+    struct DrainConfig {
+        std::chrono::seconds deadline{ 20 };     // 진행 중인 작업을 기다리는 최대 시간
+        std::string reconnect_address;           // 클라이언트에 안내할 재접속 주소 (빈 값이면 미포함)
+        int reconnect_after_ms = 1000;
+        std::string handoff_socket_path;         // 리스닝 소켓 인계 경로 (빈 값이면 비활성화)
+
+        static DrainConfig fromJson(const json& config);
+    };
+
     class Server {
     public:
         Server(boost::asio::io_context& io_context,
             short port,
             const std::string& db_connection_string,
-            const std::string& version);
+            const std::string& version,
+            const json& config = json::object());
         ~Server();
 
         void run();
         void stop();
 
+        // 새 연결 수락을 멈추고 클라이언트에 재접속을 안내한 뒤, 진행 중인 작업이 끝나거나
+        // 제한 시간이 지나면 stop() 후 종료 핸들러 호출
+        void drain();
+        bool isDraining() const;
+        void setShutdownHandler(std::function<void()> handler);
+
+        // 응답이 비동기로 완료되는 작업(미러 ack 대기 등) 추적, 드레인 시 완료를 기다림
+        void beginOperation();
+        void endOperation();
+
         // 세션 관리 메서드
-        std::string registerSession(std::shared_ptr<Session> session);
+        auth::SessionToken registerSession(std::shared_ptr<Session> session);
         void registerMirrorSession(std::shared_ptr<Session> session, int port);
-        void removeSession(const std::string& token, int userId);
+        void removeSession(const auth::SessionToken& token, int userId);
         void removeMirrorSession(int port);
-        std::shared_ptr<Session> getSession(const std::string& token);
+        std::shared_ptr<Session> getSession(const auth::SessionToken& token);
         std::shared_ptr<Session> getMirrorSession(int port);
         int getCCU();
         int getRoomCapacity();
-        std::string generateSessionToken();
+        auth::SessionToken generateSessionToken(int userId);
+        // 서명과 만료만으로 토큰 검증 (세션 맵을 조회하지 않음)
+        auth::TokenStatus verifySessionToken(std::string_view token, auth::TokenClaims* claims = nullptr) const;
+        // config.json의 "sessionToken" 섹션으로 서명 키 교체
+        void reloadTokenKeys(const json& config);
         void setSessionTimeout(std::chrono::seconds timeout);
         void startSessionTimeoutCheck();
         void startBroadcastTimer();
@@ -52,30 +129,69 @@ namespace game_server {
         void broadcastChat(const std::string& nickName, const std::string& message);
         void broadcastActiveUser(const std::string& message, const std::vector<std::shared_ptr<Session>>& activeSessions);
         void setSessionStatus(const json& users, bool flag);
-        bool allowConnection(const std::string& ipAddress);
-        void removeConnection(const std::string& ipAddress);
+
+        // 세션 재개: 끊긴 로그인 세션을 토큰으로 보관했다가 새 소켓에 다시 연결
+        bool retainSession(const auth::SessionToken& token, RetainedSession state);
+        std::optional<RetainedSession> resumeSession(const std::string& token, std::shared_ptr<Session> session);
+        // 보관 중이면 재전송 버퍼에 추가, 이미 재개되었으면 새 연결로 전달
+        void bufferRetainedMessage(const auth::SessionToken& token, const std::string& message);
+        void discardRetainedUser(int userId);
+        // 같은 IP에서 아직 끊김이 감지되지 않은 기존 연결을 재개 요청이 이어받음 (IP 중복 접속 예외)
+        bool takeOverConnection(const std::string& token, const RemoteAddress& ipAddress);
+        bool allowConnection(const RemoteAddress& ipAddress);
+        void removeConnection(const RemoteAddress& ipAddress);
+        boost::asio::io_context& getIoContext();
+        // 서버가 소멸하면 만료되는 핸들, 서버보다 오래 남은 세션이 소멸자에서 서버를 건드리지 않도록 확인용
+        std::weak_ptr<const void> lifetime() const;
+        std::chrono::milliseconds getMirrorAckTimeout();
+        RateLimiter& getRateLimiter();
+        BufferPool& getReceiveBuffers();
+        const protocol::RequestLimits& getRequestLimits() const;
     private:
-        void do_accept();
+        void open_acceptors(short port);
+        void do_accept(boost::asio::ip::tcp::acceptor& acceptor);
+        void accept_socket(boost::asio::ip::tcp::socket socket);
+        void configure_socket(boost::asio::ip::tcp::socket& socket);
+        bool assign_inherited_acceptors();
+        void close_acceptors();
+        std::vector<int> listener_handles();
+        void check_drain_progress();
+        void expire_retained_sessions();
+        void exit_room_for_user(int userId);
+        void buffer_for_retained_waiting(const std::string& message, ReplayKind kind);
         void init_controllers();
+        void start_admin_server();
         void check_inactive_sessions();
         void scheduleBroadcast();
 
         boost::asio::io_context& io_context_;
-        boost::asio::ip::tcp::acceptor acceptor_;
+        std::shared_ptr<const void> lifetime_;
+        ListenerConfig listener_config_;
+        std::vector<std::unique_ptr<boost::asio::ip::tcp::acceptor>> acceptors_;
+        // 리포지토리 저장소 선택 (memory면 db_pool_을 만들지 않음)
+        RepositoryConfig repository_config_;
         std::unique_ptr<DbPool> db_pool_;
         std::map<std::string, std::shared_ptr<Controller>> controllers_;
+        // 리포지토리의 반영 함수를 참조하므로 controllers_보다 먼저 소멸(뒤에 선언)되어야 함
+        WriteBehindConfig write_behind_config_;
+        std::unique_ptr<WriteBehindQueue> write_behind_;
+        std::uint64_t last_write_behind_errors_ = 0;
+        // 비밀번호 해시가 필요한 인증 요청 처리용 (AuthController가 참조)
+        json password_hash_config_;
+        std::unique_ptr<WorkerPool> hash_pool_;
         bool running_;
 
         // 세션 관리 데이터
         std::unordered_map<int, std::weak_ptr<Session>> mirrors_;
         std::mutex mirrors_mutex_;
-        std::unordered_map<std::string, std::weak_ptr<Session>> sessions_;
+        std::unordered_map<auth::SessionToken, std::weak_ptr<Session>, auth::SessionTokenHash> sessions_;
         std::mutex sessions_mutex_;
-        std::unordered_set<std::string> connected_ips_;
+        std::unordered_set<RemoteAddress, RemoteAddressHash> connected_ips_;
         std::mutex connected_ips_mutex_;
-        std::unordered_map<int, std::string> tokens_;
+        std::unordered_map<int, auth::SessionToken> tokens_;
         std::mutex tokens_mutex_;
-        boost::uuids::random_generator uuid_generator_;
+        // 세션 토큰 발급/검증 (키 설정이 같은 다른 노드에서도 검증 가능)
+        auth::TokenSigner token_signer_;
         std::chrono::seconds session_timeout_{ 12 }; // 기본 12초
         boost::asio::steady_timer session_check_timer_;
         bool timeout_check_running_{ false };
@@ -83,7 +199,43 @@ namespace game_server {
         boost::asio::steady_timer broadcast_timer_;
         bool broadcast_running_ = false;
         const std::chrono::seconds broadcast_interval_ = std::chrono::seconds(3);
+
+        // 미러 서버가 setRoom 등 명령에 ack를 보내야 하는 제한 시간
+        std::chrono::milliseconds mirror_ack_timeout_{ 3000 };
+
+        // 읽기 중에만 빌려 쓰는 수신 버퍼 (유휴 연결은 버퍼를 갖지 않음)
+        BufferPool receive_buffers_;
+        std::size_t last_reported_sessions_ = 0;
+
+        // 세션/IP/액션 분류별 요청 수 제한
+        RateLimiter rate_limiter_;
+        std::uint64_t last_rejected_total_ = 0;
+
+        // 요청 메시지 크기/중첩 깊이/필드 길이 제한 (파싱 중 위반 시 즉시 거부)
+        protocol::RequestLimits request_limits_;
+
+        // 로그인 경로 사용자 캐시
+        UserCacheConfig user_cache_config_;
         
+        // 세션 재개 대기 데이터
+        std::unordered_map<auth::SessionToken, RetainedSession, auth::SessionTokenHash> retained_;
+        std::mutex retained_mutex_;
+        std::chrono::seconds resume_grace_{ 30 };
+        std::size_t replay_buffer_size_{ 32 };
+
+        // 드레인 및 무중단 재시작
+        DrainConfig drain_config_;
+        std::atomic<bool> draining_{ false };
+        std::atomic<int> inflight_operations_{ 0 };
+        std::chrono::steady_clock::time_point drain_deadline_;
+        boost::asio::steady_timer drain_timer_;
+        std::function<void()> shutdown_handler_;
+        std::unique_ptr<ListenerHandoff> handoff_;
+
+        // 관리용 포트 (메트릭 스크레이프)
+        AdminConfig admin_config_;
+        std::unique_ptr<AdminServer> admin_server_;
+
         // 버전 관리 데이터
         std::string version_;
     };
@@ -3,15 +3,115 @@
 // 클라이언트와의 통신 세션을 처리하는 핵심 파일
 #include "session.h"
 #include "server.h"
+#include "mirror_channel.h"
+#include "../util/metrics.h"
+#include "../util/logging.h"
+#include "../util/tracing.h"
+#include "protocol/request_limits.h"
+#include <atomic>
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <unordered_map>
 
 namespace game_server {
 
     using json = nlohmann::json;
 
+    namespace {
+
+        struct ActionMetrics {
+            Metrics::Counter requests;
+            Metrics::Histogram latency;
+        };
+
+        ActionMetrics makeActionMetrics(const std::string& action) {
+            std::string labels = "action=\"" + action + "\"";
+            return {
+                Metrics::instance().counter("matching_requests_total", "처리한 요청 수", labels),
+                Metrics::instance().histogram("matching_request_duration_seconds", "요청 수신부터 응답 생성까지 걸린 시간",
+                    Metrics::latencyBuckets(), 1e-6, labels)
+            };
+        }
+
+        // 액션별 메트릭 핸들, 라벨 수가 늘지 않도록 알려진 액션만 개별 집계하고 나머지는 unknown
+        const ActionMetrics& actionMetrics(const std::string& action) {
+            static const std::unordered_map<std::string, ActionMetrics> known = []() {
+                std::unordered_map<std::string, ActionMetrics> table;
+                for (const char* name : { "register", "login", "SSAFYlogin", "updateNickName", "resume",
+                    "createRoom", "joinRoom", "exitRoom", "listRooms", "gameStart", "gameEnd",
+                    "alivePing", "chat", "logout", "roomCapacity", "CCU" }) {
+                    table.emplace(name, makeActionMetrics(name));
+                }
+                return table;
+            }();
+            static const ActionMetrics unknown = makeActionMetrics("unknown");
+
+            auto it = known.find(action);
+            return it != known.end() ? it->second : unknown;
+        }
+
+        struct SessionMetrics {
+            Metrics::Counter bytes_in;
+            Metrics::Counter bytes_out;
+            Metrics::Histogram write_queue_depth;
+        };
+
+        const SessionMetrics& sessionMetrics() {
+            static const SessionMetrics metrics = {
+                Metrics::instance().counter("matching_received_bytes_total", "클라이언트로부터 받은 바이트 수"),
+                Metrics::instance().counter("matching_sent_bytes_total", "클라이언트에 보낸 바이트 수"),
+                Metrics::instance().histogram("matching_write_queue_depth", "응답을 큐에 넣은 직후 세션 쓰기 큐 길이",
+                    Metrics::sizeBuckets())
+            };
+            return metrics;
+        }
+
+        // 동기로 끝나는 요청은 스코프를 벗어날 때 지연 시간과 추적을 마무리하고,
+        // 컨트롤러로 넘긴 요청은 release()로 시작 시각을 넘겨받아 완료 시점에 마무리
+        class RequestTimer {
+        public:
+            RequestTimer(const Metrics::Histogram& latency, std::shared_ptr<Trace> trace)
+                : latency_(&latency), started_(std::chrono::steady_clock::now()), trace_(std::move(trace)) {}
+            ~RequestTimer() {
+                if (!latency_) return;
+                latency_->observeSince(started_);
+                Tracer::instance().finish(trace_);
+            }
+
+            std::chrono::steady_clock::time_point release() {
+                latency_ = nullptr;
+                return started_;
+            }
+
+        private:
+            const Metrics::Histogram* latency_;
+            std::chrono::steady_clock::time_point started_;
+            std::shared_ptr<Trace> trace_;
+        };
+
+        // 제한 위반으로 파싱 전/중에 거부한 요청 수 (사유별)
+        const Metrics::Counter& rejectedRequests(protocol::LimitViolation violation) {
+            using protocol::LimitViolation;
+            static const std::unordered_map<LimitViolation, Metrics::Counter> counters = []() {
+                std::unordered_map<LimitViolation, Metrics::Counter> table;
+                for (LimitViolation reason : { LimitViolation::MessageTooLarge, LimitViolation::TooDeep,
+                    LimitViolation::StringTooLong, LimitViolation::TooManyElements, LimitViolation::Malformed }) {
+                    table.emplace(reason, Metrics::instance().counter("matching_rejected_requests_total",
+                        "요청 제한 위반 또는 형식 오류로 거부한 요청 수",
+                        std::string("reason=\"") + protocol::toString(reason) + "\""));
+                }
+                return table;
+            }();
+            return counters.at(violation);
+        }
+
+        // 로그에서 한 연결의 요청을 묶어 보기 위한 번호 (토큰은 로그에 남기지 않음)
+        std::atomic<std::uint64_t> next_session_id{ 1 };
+
+    } // namespace
+
     Session::Session(boost::asio::ip::tcp::socket socket,
         std::map<std::string, std::shared_ptr<Controller>>& controllers,
         Server* server)
@@ -19,18 +119,24 @@ namespace game_server {
         controllers_(controllers),
         user_id_(0),
         server_(server),
+        server_lifetime_(server ? server->lifetime() : std::weak_ptr<const void>()),
         last_activity_time_(std::chrono::steady_clock::now()),
-        remote_ip_(socket_.remote_endpoint().address().to_string())
+        remote_ip_(socket_.remote_endpoint().address()),
+        session_id_(next_session_id.fetch_add(1, std::memory_order_relaxed))
     {
-        spdlog::info("새 세션이 생성되었습니다. 주소: {}:{}",
-            socket_.remote_endpoint().address().to_string(),
-            socket_.remote_endpoint().port());
+
+        logWith(log_context(), spdlog::level::info, "새 세션이 생성되었습니다. 주소: {}:{}",
+            remote_ip_.toString(), socket_.remote_endpoint().port());
 
     }
 
     Session::~Session() {
-        if (server_) {
+        // 종료 시 실행되지 못한 핸들러가 io_context와 함께 정리되면 서버가 먼저 소멸해 있을 수 있음
+        if (server_ && !server_lifetime_.expired()) {
             if (is_mirror_) {
+                if (mirror_channel_) {
+                    mirror_channel_->failAll("미러 서버 세션 종료");
+                }
                 server_->removeMirrorSession(mirror_port_);
             }
             if (!token_.empty()) {
@@ -45,12 +151,11 @@ namespace game_server {
     void Session::initialize() {
         // 서버에 세션 등록 및 토큰 받기
         token_ = server_->registerSession(shared_from_this());
-        spdlog::info("세션이 초기화되었습니다. 토큰: {}", token_);
+        logWith(log_context(), spdlog::level::info, "세션이 초기화되었습니다");
     }
 
     void Session::handlePing() {
         last_activity_time_ = std::chrono::steady_clock::now();
-        spdlog::debug("유저 ID : {}로 부터 핑을 받음", user_id_);
 
         json response = {
             {"action", "refreshSession"},
@@ -60,7 +165,7 @@ namespace game_server {
         };
 
         write_response(response.dump());
-        spdlog::debug("핑 수신, 세션 {} 갱신됨", token_);
+        logWith(log_context(), spdlog::level::debug, "핑 수신, 세션 갱신됨");
     }
 
     bool Session::isActive(std::chrono::seconds timeout) const {
@@ -69,25 +174,65 @@ namespace game_server {
         return elapsed < timeout;
     }
 
-    const std::string& Session::getToken() const {
+    const auth::SessionToken& Session::getToken() const {
         return token_;
     }
 
+    FixedBlockPool& SessionPoolTag::pool() {
+        // 종료 시점에 남은 세션이 반납될 수 있으므로 해제하지 않음
+        static FixedBlockPool* pool = new FixedBlockPool(4096);
+        return *pool;
+    }
+
+    // 읽을 데이터가 도착할 때까지 버퍼 없이 대기하고, 도착하면 풀에서 크기에 맞는 버퍼를 빌려 읽음
+    // handler가 반환되면 버퍼는 바로 반납되므로 handler는 data를 복사하거나 그 안에서 처리해야 함
+    template <class Handler>
+    void Session::async_receive(Handler handler) {
+        auto self(shared_from_this());
+        socket_.async_wait(boost::asio::ip::tcp::socket::wait_read, makeCustomAllocHandler(read_handler_memory_,
+            [this, self, handler = std::move(handler)](boost::system::error_code ec) mutable {
+                if (ec) {
+                    handler(ec, nullptr, 0);
+                    return;
+                }
+
+                std::size_t available = socket_.available(ec);
+                BufferPool::Buffer buffer = server_->getReceiveBuffers().acquire(ec ? 0 : available);
+                ec.clear();
+                std::size_t length = socket_.read_some(boost::asio::buffer(buffer.data(), buffer.size()), ec);
+                if (ec == boost::asio::error::would_block || ec == boost::asio::error::try_again) {
+                    // 읽을 데이터 없이 깨어난 경우 버퍼를 반납하고 다시 대기
+                    buffer = BufferPool::Buffer();
+                    async_receive(std::move(handler));
+                    return;
+                }
+                if (!ec) {
+                    sessionMetrics().bytes_in.add(length);
+                }
+                handler(ec, buffer.data(), length);
+            }));
+    }
+
     // 세션 시작 - 핸드셰이크부터 시작
     void Session::start() {
+        // 읽기 준비 통지 후 read_some으로 읽으므로 블로킹되지 않도록 설정
+        boost::system::error_code ec;
+        socket_.non_blocking(true, ec);
         read_handshake();  // 먼저 핸드셰이크 처리
     }
 
     // 핸드셰이크 메시지 처리
     void Session::read_handshake() {
         auto self(shared_from_this());
-        socket_.async_read_some(
-            boost::asio::buffer(buffer_),
-            [this, self](boost::system::error_code ec, std::size_t length) {                
+        async_receive(
+            [this, self](boost::system::error_code ec, const char* data, std::size_t length) {
                 if (!ec) {
+                    json handshake;
+                    if (!parse_request(data, length, handshake)) {
+                        if (!closed_) handle_error("잘못된 핸드셰이크 형식");
+                        return;
+                    }
                     try {
-                        std::string data(buffer_.data(), length);
-                        json handshake = json::parse(data);
 
                         // 미러 서버 구분 로직
                         if (handshake.contains("connectionType") &&
@@ -102,6 +247,10 @@ namespace game_server {
                             // 미러 서버 전용 초기화
                             server_->registerMirrorSession(shared_from_this(), handshake["port"]);
                             user_id_ = handshake["port"];
+                            mirror_channel_ = std::make_shared<MirrorChannel>(
+                                server_->getIoContext(),
+                                [this](const std::string& message) { write_response(message); },
+                                server_->getMirrorAckTimeout());
 
                             // 확인 응답 전송
                             json response = {
@@ -111,13 +260,22 @@ namespace game_server {
                             write_handshake_response(response.dump());
                         }
                         else {
-                            if (!server_->allowConnection(remote_ip_)) {
+                            // 재개 요청은 같은 IP의 끊기지 않은 기존 연결을 이어받을 수 있음
+                            bool allowed = server_->allowConnection(remote_ip_);
+                            if (!allowed && handshake.value("action", "") == "resume") {
+                                allowed = server_->takeOverConnection(handshake.value("sessionToken", ""), remote_ip_);
+                            }
+                            if (!allowed) {
                                 json response = {
                                     {"status", "error"},
                                     {"message", "이미 접속 중인 IP입니다."}
                                 };
-                                write_handshake_response(response.dump());
-                                handle_error("다중 클라이언트 접속 감지 IP : " + remote_ip_);
+                                write_response(response.dump());
+                                // 기존 연결이 점유한 IP이므로 이 세션이 소멸될 때 해제하지 않음
+                                std::string duplicated_ip = remote_ip_.toString();
+                                remote_ip_.clear();
+                                handle_error("다중 클라이언트 접속 감지 IP : " + duplicated_ip);
+                                return;
                             }
 
                             // 일반 클라이언트 세션 초기화
@@ -131,6 +289,7 @@ namespace game_server {
                             // 핸드셰이크가 실제 요청인 경우 처리
                             if (handshake.contains("action")) {
                                 process_request(handshake);
+                                read_message();
                             }
                             else {
                                 // 일반 클라이언트에게 연결 확인 메시지 전송
@@ -156,48 +315,53 @@ namespace game_server {
 
     // 핸드셰이크 응답 전송 (응답 후 일반 메시지 처리로 전환)
     void Session::write_handshake_response(const std::string& response) {
-        auto self(shared_from_this());
-        boost::asio::async_write(
-            socket_,
-            boost::asio::buffer(response),
-            [this, self](boost::system::error_code ec, std::size_t /*length*/) {
-                if (!ec) {
-                    // 핸드셰이크 완료 후 일반 메시지 처리 시작
-                    read_message();
-                }
-                else {
-                    handle_error("핸드셰이크 응답 쓰기 오류: " + ec.message());
-                }
-            });
+        write_response(response);
+
+        // 핸드셰이크 완료 후 일반 메시지 처리 시작
+        read_message();
     }
 
     void Session::read_message() {
+        // 이미 종료된 세션에는 읽기를 다시 걸지 않음
+        if (!socket_.is_open()) return;
         auto self(shared_from_this());
 
-        // 비동기적으로 데이터 읽기
-        socket_.async_read_some(
-            boost::asio::buffer(buffer_),
-            [this, self](boost::system::error_code ec, std::size_t length) {
+        // 비동기적으로 데이터 읽기 (수신 버퍼는 읽기 완료 시점에만 풀에서 빌림)
+        async_receive(
+            [this, self](boost::system::error_code ec, const char* data, std::size_t length) {
                 if (!ec) {
-                    try {
-                        // 수신된 데이터를 문자열로 변환
-                        std::string data(buffer_.data(), length);
-
-                        // JSON 파싱
-                        json request = json::parse(data);
+                    // 요청 하나의 추적 시작 (비활성화 상태면 nullptr)
+                    auto trace = Tracer::instance().start();
+                    TraceScope trace_scope(trace.get());
+                    // JSON 파싱 (빌린 버퍼에서 바로 파싱, 제한 위반 시 오류 응답 후 다음 요청 대기)
+                    ScopedSpan parse_span("json.parse");
+                    json request;
+                    bool parsed = parse_request(data, length, request);
+                    parse_span.end();
+                    if (!parsed) {
+                        // 메시지 경계를 신뢰할 수 없어 연결을 끊은 경우
+                        if (closed_) return;
+                        read_message();
+                        return;
+                    }
 
+                    try {
                         // 요청 처리
-                        process_request(request);
+                        process_request(request, std::move(trace));
                     }
                     catch (const std::exception& e) {
-                        // JSON 파싱 오류 등 예외 처리
-                        spdlog::error("요청 데이터 처리 중 오류: {}", e.what());
+                        // 요청 처리 중 예외 처리 (잘못된 요청을 반복해서 보내도 로그가 넘치지 않도록 제한)
+                        static LogThrottle throttle;
+                        logThrottled(throttle, log_context(), spdlog::level::err, "요청 데이터 처리 중 오류: {}", e.what());
                         json error_response = {
                             {"status", "error"},
                             {"message", "잘못된 요청 형식"}
                         };
                         write_response(error_response.dump());
                     }
+
+                    // 응답은 쓰기 큐에서 순서대로 전송되므로 바로 다음 요청 대기
+                    read_message();
                 }
                 else {
                     handle_error("메시지 읽기 오류: " + ec.message());
@@ -205,16 +369,85 @@ namespace game_server {
             });
     }
 
-    void Session::process_request(json& request) {
+    // 설정된 제한(requestLimits)을 지키며 요청을 파싱
+    // 위반 시 처음 위반한 지점에서 파싱을 멈추고 사유별로 집계한 뒤 오류를 응답하며,
+    // 크기 초과는 한 번의 읽기로 메시지를 다 받지 못한 것이므로 연결을 종료
+    bool Session::parse_request(const char* data, std::size_t length, json& request) {
+        protocol::LimitViolation violation =
+            protocol::parseBounded(data, data + length, server_->getRequestLimits(), request);
+        if (violation == protocol::LimitViolation::None) return true;
+
+        rejectedRequests(violation).add();
+        static LogThrottle throttle;
+        logThrottled(throttle, log_context(), spdlog::level::warn, "요청 거부 ({}), 크기: {}바이트, IP : {}",
+            protocol::toString(violation), length, remote_ip_.toString());
+
+        json error_response = {
+            {"status", "error"},
+            {"message", violation == protocol::LimitViolation::Malformed ? "잘못된 요청 형식" : "요청이 허용된 크기를 초과했습니다"}
+        };
+        write_response(error_response.dump());
+
+        if (violation == protocol::LimitViolation::MessageTooLarge) {
+            handle_error(std::string("요청 크기 제한 초과로 연결 종료, 크기: ") + std::to_string(length) + "바이트");
+        }
+        return false;
+    }
+
+    void Session::process_request(json& request, std::shared_ptr<Trace> trace) {
         try {
-            spdlog::debug("요청 처리 중...");
             // action 필드로 요청 유형 확인
             std::string action = request["action"];
-            spdlog::debug("액션: {}", action);
+            logWith(log_context(), spdlog::level::debug, "요청 처리 중, 액션: {}", action);
             std::string controller_type;
 
+            // 미러 서버의 명령 응답은 대기 중인 요청과 매칭
+            if (is_mirror_ && (action == "ack" || action == "nack")) {
+                if (mirror_channel_) {
+                    mirror_channel_->handleReply(request);
+                }
+                return;
+            }
+
+            const ActionMetrics& metrics = actionMetrics(action);
+            metrics.requests.add();
+            if (trace) trace->setAction(action);
+            RequestTimer timer(metrics.latency, trace);
+
+            // 컨트롤러 디스패치 전에 세션/IP/액션 분류별 요청 수 제한 적용
+            if (!is_mirror_) {
+                RateLimitResult limited = server_->getRateLimiter().check(rate_buckets_, remote_ip_, action);
+                if (limited != RateLimitResult::Allowed) {
+                    static LogThrottle throttle;
+                    logThrottled(throttle, log_context(), spdlog::level::warn, "요청 수 제한 초과, IP : {}, 액션 : {}", remote_ip_.toString(), action);
+                    json error_response = {
+                        {"action", action},
+                        {"status", "error"},
+                        {"message", "요청이 너무 많습니다. 잠시 후 다시 시도해주세요"}
+                    };
+                    write_response(error_response.dump());
+                    return;
+                }
+            }
+
+            // 드레인 중에는 새 상태를 만드는 요청을 받지 않음 (핑, 퇴장, 로그아웃 및 미러 요청은 허용)
+            if (server_->isDraining() && !is_mirror_ &&
+                action != "alivePing" && action != "exitRoom" && action != "logout") {
+                json error_response = {
+                    {"action", action},
+                    {"status", "error"},
+                    {"message", "서버 점검을 준비 중입니다. 잠시 후 다시 접속해주세요"}
+                };
+                write_response(error_response.dump());
+                return;
+            }
+
             // 컨트롤러 유형 결정
-            if (action == "register" || action == "login" || action == "SSAFYlogin" || action == "updateNickName") {
+            if (action == "resume") {
+                handle_resume(request);
+                return;
+            }
+            else if (action == "register" || action == "login" || action == "SSAFYlogin" || action == "updateNickName") {
                 if (user_id_) request["userId"] = user_id_;
                 controller_type = "auth";
             }
@@ -248,9 +481,26 @@ namespace game_server {
                 handlePing();
                 return;
             }
+            else if (action == "chat") {
+                // 대기실 채팅은 대기 중인 세션 전체에 브로드캐스트 (보낸 사람도 같은 메시지를 받음)
+                auto message = request.find("message");
+                if (user_id_ == 0 || message == request.end() || !message->is_string() ||
+                    message->get_ref<const std::string&>().empty() ||
+                    message->get_ref<const std::string&>().size() > server_->getRequestLimits().max_chat_bytes) {
+                    json error_response = {
+                        {"action", "chat"},
+                        {"status", "error"},
+                        {"message", "잘못된 채팅 요청입니다"}
+                    };
+                    write_response(error_response.dump());
+                    return;
+                }
+                server_->broadcastChat(std::string(nick_name_.view()), message->get_ref<const std::string&>());
+                return;
+            }
             else if (action == "logout") {
                 std::string logMessage = user_name_ + " 님이 로그아웃하였습니다";
-                handle_error(logMessage);
+                handle_error(logMessage, false);
                 return;
             }
             else if (action == "roomCapacity") {
@@ -271,7 +521,8 @@ namespace game_server {
             }
             else {
                 // 알수 없는 액션 처리
-                spdlog::warn("알 수 없는 액션: {}", action);
+                static LogThrottle throttle;
+                logThrottled(throttle, log_context(), spdlog::level::warn, "알 수 없는 액션: {}", action);
                 json error_response = {
                     {"status", "error"},
                     {"message", "알 수 없는 액션"}
@@ -282,77 +533,34 @@ namespace game_server {
 
             auto controller_it = controllers_.find(controller_type);
             if (controller_it != controllers_.end()) {
-                spdlog::debug("컨트롤러 찾음: {}", controller_type);
-                json response = controller_it->second->handleRequest(request);
-                spdlog::debug("컨트롤러 응답 수신됨");
-
-                if ((action == "login" || action == "SSAFYlogin") && response["status"] == "success") {
-                    spdlog::debug("로그인 응답 처리 중");
-                    if (server_->checkAlreadyLogin(response["userId"].get<int>())) {
-                        spdlog::error("사용자 ID: {}는 이미 로그인되어 있습니다", response["userId"].get<int>());
-                        json error_response = {
-                            {"status", "error"},
-                            {"message", "이미 로그인된 사용자입니다"}
-                        };
-                        write_response(error_response.dump());
-                        return;
-                    }
-
-                    init_current_user(response);
-                    std::string token = server_->registerSession(shared_from_this());
-                    token_ = token;
-                    response["sessionToken"] = token;
-                }
-                else if (action == "createRoom" && response["status"] == "success") {
-                    spdlog::debug("방 생성 응답 처리 중");
 
-                    // response 객체 디버깅 로그
-                    spdlog::debug("응답 내용: {}", response.dump());
-
-                    try {
-                        json broad_response;
-                        broad_response["action"] = "setRoom";
-                        broad_response["roomId"] = response["roomId"];
-                        broad_response["roomName"] = response["roomName"];
-                        broad_response["maxPlayers"] = response["maxPlayers"];
-
-                        auto mirror = server_->getMirrorSession(response["port"]);
-                        if (!mirror) {
-                            json error_response = {
-                                {"status", "error"},
-                                {"message", "미러 서버가 없습니다"}
-                            };
-                            spdlog::error("방 ID {}에 미러 서버가 없습니다", response["roomId"].get<int>());
-                            write_response(error_response.dump());
+                // 인증 요청은 워커 스레드에서 완료될 수 있으므로 후속 처리는 항상 io 스레드에서 수행
+                auto self(shared_from_this());
+                auto& io_context = server_->getIoContext();
+                server_->beginOperation();
+                controller_it->second->handleRequestAsync(request,
+                    [this, self, action, &io_context, latency = &metrics.latency, started = timer.release(), trace](json response) {
+                        if (io_context.get_executor().running_in_this_thread()) {
+                            server_->endOperation();
+                            {
+                                ScopedSpan span("session.response");
+                                handle_controller_response(action, std::move(response));
+                            }
+                            latency->observeSince(started);
+                            Tracer::instance().finish(trace);
                             return;
                         }
-                        spdlog::debug("미러 서버 찾음, 메시지 브로드캐스팅");
-                        status_ = std::to_string(broad_response["roomId"].get<int>()) + "번 방";
-                        write_mirror(broad_response.dump(), mirror);
-                    }
-                    catch (const std::exception& e) {
-                        spdlog::error("방 생성 응답 처리 중 오류: {}", e.what());
-                        // 예외가 발생해도 원래 응답은 전송
-                    }
-                }
-                else if (action == "joinRoom" && response["status"] == "success") {
-                    status_ = std::to_string(response["roomId"].get<int>()) + "번 방";
-                }
-                else if (action == "exitRoom" && response["status"] == "success") {
-                    status_ = "대기중";
-                }
-                else if (action == "gameStart" && response["status"] == "success") {
-                    server_->setSessionStatus(response, true);
-                }
-                else if (action == "gameEnd" && response["status"] == "success") {
-                    server_->setSessionStatus(response, false);
-                }
-                else if (action == "updateNickName" && response["status"] == "success") {
-                    nick_name_ = response["nickName"];
-                }
-
-                spdlog::debug("클라이언트에 응답 전송 중");
-                write_response(response.dump());
+                        boost::asio::post(io_context, [this, self, action, latency, started, trace, response = std::move(response)]() mutable {
+                            TraceScope trace_scope(trace.get());
+                            server_->endOperation();
+                            {
+                                ScopedSpan span("session.response");
+                                handle_controller_response(action, std::move(response));
+                            }
+                            latency->observeSince(started);
+                            Tracer::instance().finish(trace);
+                            });
+                    });
             }
             else {
                 spdlog::error("컨트롤러를 찾지 못함: {}", controller_type);
@@ -364,10 +572,10 @@ namespace game_server {
             }
         }
         catch (const std::exception& e) {
-            spdlog::error("process_request 중 오류: {}", e.what());
-            if (request.is_object() && request.contains("action")) {
-                spdlog::error("실패한 액션: {}", request["action"].get<std::string>());
-            }
+            static LogThrottle throttle;
+            logThrottled(throttle, log_context(), spdlog::level::err, "process_request 중 오류: {}, 요청: {}", e.what(),
+                request.is_object() && request.contains("action") && request["action"].is_string()
+                ? request["action"].get_ref<const std::string&>() : std::string("(action 없음)"));
             json error_response = {
                 {"status", "error"},
                 {"message", "잘못된 요청 형식"}
@@ -376,60 +584,286 @@ namespace game_server {
         }
     }
 
-    void Session::write_mirror(const std::string& response, std::shared_ptr<Session> mirror) {
-        boost::asio::async_write(
-            mirror->socket_,
-            boost::asio::buffer(response),
-            [mirror](boost::system::error_code ec, std::size_t /*length*/) {
-                if (!ec) {
-                    // 다음 요청 대기
-                    mirror->read_message();
+    // 컨트롤러 응답에 따른 세션 상태 갱신 후 클라이언트에 응답
+    void Session::handle_controller_response(const std::string& action, json response) {
+        // 워커 스레드에서 처리되는 동안 연결이 끊긴 경우 로그인 등록 등을 하지 않음
+        if (closed_) {
+            logWith(log_context(), spdlog::level::debug, "종료된 세션의 {} 응답을 버립니다", action);
+            return;
+        }
+
+        try {
+            if ((action == "login" || action == "SSAFYlogin") && response["status"] == "success") {
+                if (server_->checkAlreadyLogin(response["userId"].get<int>())) {
+                    spdlog::error("사용자 ID: {}는 이미 로그인되어 있습니다", response["userId"].get<int>());
+                    json error_response = {
+                        {"status", "error"},
+                        {"message", "이미 로그인된 사용자입니다"}
+                    };
+                    write_response(error_response.dump());
+                    return;
                 }
-                else {
-                    mirror->handle_error("응답 쓰기 오류: " + ec.message());
+
+                // 재개되지 않고 새로 로그인한 경우 이전 연결의 보관 세션 폐기
+                server_->discardRetainedUser(response["userId"].get<int>());
+
+                init_current_user(response);
+                token_ = server_->registerSession(shared_from_this());
+                response["sessionToken"] = token_;
+            }
+            else if (action == "createRoom" && response["status"] == "success") {
+                // 미러 서버의 ack를 받은 뒤에 응답하므로 여기서 종료
+                handle_create_room(std::move(response));
+                return;
+            }
+            else if (action == "joinRoom" && response["status"] == "success") {
+                status_ = SessionStatus::inRoom(response["roomId"].get<int>());
+            }
+            else if (action == "exitRoom" && response["status"] == "success") {
+                status_ = SessionStatus::waiting();
+            }
+            else if (action == "gameStart" && response["status"] == "success") {
+                server_->setSessionStatus(response, true);
+            }
+            else if (action == "gameEnd" && response["status"] == "success") {
+                server_->setSessionStatus(response, false);
+            }
+            else if (action == "updateNickName" && response["status"] == "success") {
+                nick_name_.assign(response["nickName"].get_ref<const std::string&>());
+            }
+
+            write_response(response.dump());
+        }
+        catch (const std::exception& e) {
+            static LogThrottle throttle;
+            logThrottled(throttle, log_context(), spdlog::level::err, "{} 응답 처리 중 오류: {}", action, e.what());
+            json error_response = {
+                {"status", "error"},
+                {"message", "잘못된 요청 형식"}
+            };
+            write_response(error_response.dump());
+        }
+    }
+
+    // 방 생성 성공 후 미러 서버에 setRoom을 보내고, ack를 받아야 클라이언트에 응답
+    void Session::handle_create_room(json response) {
+        int roomId = response["roomId"].get<int>();
+
+        auto mirror = server_->getMirrorSession(response["port"]);
+        if (!mirror) {
+            spdlog::error("방 ID {}에 미러 서버가 없습니다", roomId);
+            rollback_created_room(roomId);
+            json error_response = {
+                {"status", "error"},
+                {"message", "미러 서버가 없습니다"}
+            };
+            write_response(error_response.dump());
+            return;
+        }
+
+        json command = {
+            {"action", "setRoom"},
+            {"roomId", response["roomId"]},
+            {"roomName", response["roomName"]},
+            {"maxPlayers", response["maxPlayers"]}
+        };
+
+        auto self(shared_from_this());
+        auto started_at = std::chrono::steady_clock::now();
+        server_->beginOperation();
+        mirror->sendMirrorCommand(command,
+            [this, self, response = std::move(response), roomId, started_at](bool success, const json& reply) {
+                server_->endOperation();
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - started_at);
+
+                if (!success) {
+                    spdlog::error("방 ID {}의 미러 서버 준비 실패 ({}ms): {}",
+                        roomId, elapsed.count(), reply.value("message", "nack"));
+                    rollback_created_room(roomId);
+                    json error_response = {
+                        {"status", "error"},
+                        {"message", "미러 서버가 방을 준비하지 못했습니다"}
+                    };
+                    write_response(error_response.dump());
+                    return;
                 }
+
+                spdlog::info("방 ID {} 생성 및 미러 서버 준비 완료, 소요 시간 : {}ms", roomId, elapsed.count());
+                status_ = SessionStatus::inRoom(roomId);
+                write_response(response.dump());
             });
     }
 
+    // 미러 서버가 방을 준비하지 못한 경우 DB에 생성된 방에서 호스트를 퇴장시켜 방을 정리
+    void Session::rollback_created_room(int roomId) {
+        try {
+            auto controller_it = controllers_.find("room");
+            if (controller_it == controllers_.end() || user_id_ <= 0) return;
+
+            json temp = {
+                {"action", "exitRoom"},
+                {"userId", user_id_}
+            };
+            controller_it->second->handleRequest(temp);
+            spdlog::info("방 ID {} 생성을 취소하였습니다", roomId);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("방 ID {} 생성 취소 중 에러가 발생하였습니다. : {}", roomId, e.what());
+        }
+    }
+
+    // 끊긴 로그인 세션을 토큰으로 재개하고, 끊긴 동안 받지 못한 메시지를 순서대로 재전송
+    void Session::handle_resume(const json& request) {
+        if (user_id_ != 0) {
+            json error_response = {
+                {"action", "resume"},
+                {"status", "error"},
+                {"message", "이미 로그인된 세션입니다"}
+            };
+            write_response(error_response.dump());
+            return;
+        }
+
+        std::string token = request.value("sessionToken", "");
+        auto state = token.empty() ? std::nullopt : server_->resumeSession(token, shared_from_this());
+        if (!state) {
+            json error_response = {
+                {"action", "resume"},
+                {"status", "error"},
+                {"message", "재개할 수 있는 세션이 없습니다. 다시 로그인해주세요"}
+            };
+            write_response(error_response.dump());
+            return;
+        }
+
+        auth::SessionToken::parse(token, token_);
+        user_id_ = state->user_id;
+        user_name_ = state->user_name;
+        nick_name_ = state->nick_name;
+        status_ = state->status;
+        last_activity_time_ = std::chrono::steady_clock::now();
+
+        json response = {
+            {"action", "resume"},
+            {"status", "success"},
+            {"userId", user_id_},
+            {"userName", user_name_},
+            {"nickName", nick_name_.view()},
+            {"userStatus", status_.toString()},
+            {"sessionToken", token_},
+            {"missedMessages", state->missed_messages.size()}
+        };
+        write_response(response.dump());
+
+        for (const auto& message : state->missed_messages) {
+            write_response(message.payload);
+        }
+    }
+
+    void Session::sendMirrorCommand(const json& command, std::function<void(bool, const json&)> callback) {
+        if (!is_mirror_ || !mirror_channel_ || !socket_.is_open()) {
+            json reply = {
+                {"action", "nack"},
+                {"message", "미러 서버 세션이 아닙니다"}
+            };
+            callback(false, reply);
+            return;
+        }
+        mirror_channel_->send(command, std::move(callback));
+    }
+
     void Session::write_broadcast(const std::string& response) {
-        auto self = shared_from_this();
-        boost::asio::async_write(
-            socket_,
-            boost::asio::buffer(response),
-            [self](boost::system::error_code ec, std::size_t /*length*/) {
-                if (ec) {
-                    self->handle_error("동접자 수 받기 에러: " + ec.message());
-                }
-            });
+        // 끊긴 세션의 브로드캐스트는 서버가 재개 대기 버퍼에 직접 보관
+        if (closed_) return;
+        write_response(response);
+    }
+
+    const RemoteAddress& Session::getRemoteIp() const {
+        return remote_ip_;
+    }
+
+    void Session::detachForResume(bool transfer_ip) {
+        if (transfer_ip) {
+            remote_ip_.clear();
+        }
+        handle_error("세션 재개 요청으로 기존 연결을 종료합니다. 유저 ID : " + std::to_string(user_id_));
+    }
+
+    bool Session::hasPendingWrites() const {
+        return !write_queue_.empty();
     }
 
+    // 쓰기 큐에 추가, 진행 중인 쓰기가 없으면 바로 전송 시작
     void Session::write_response(const std::string& response) {
+        if (!socket_.is_open()) {
+            // 연결이 끊긴 뒤 도착한 응답(예: 미러 ack 이후의 방 생성 응답)은 재개 시 재전송
+            if (retained_) {
+                server_->bufferRetainedMessage(token_, response);
+            }
+            return;
+        }
+
+        bool write_in_progress = !write_queue_.empty();
+        write_queue_.push_back(response);
+        sessionMetrics().write_queue_depth.observe(write_queue_.size());
+        if (!write_in_progress) {
+            do_write();
+        }
+    }
+
+    // 큐의 맨 앞 메시지를 전송, 버퍼는 전송 완료 시까지 큐가 소유
+    void Session::do_write() {
         auto self(shared_from_this());
 
-        // 클라이언트로 응답 데이터 전송
         boost::asio::async_write(
             socket_,
-            boost::asio::buffer(response),
-            [this, self](boost::system::error_code ec, std::size_t /*length*/) {
-                if (!ec) {
-                    // 다음 요청 대기
-                    read_message();
-                }
-                else {
-                    handle_error("응답 쓰기 오류: " + ec.message());
-                }
-            });
+            boost::asio::buffer(write_queue_.front()),
+            makeCustomAllocHandler(write_handler_memory_,
+                [this, self](boost::system::error_code ec, std::size_t length) {
+                    if (!ec) {
+                        sessionMetrics().bytes_out.add(length);
+                        write_queue_.pop_front();
+                        if (!write_queue_.empty()) {
+                            do_write();
+                        }
+                    }
+                    else {
+                        write_queue_.clear();
+                        handle_error("응답 쓰기 오류: " + ec.message());
+                    }
+                }));
     }
 
-    void Session::handle_error(const std::string& error_message) {
+    void Session::handle_error(const std::string& error_message, bool retain) {
         // 오류 로깅
-        spdlog::info(error_message);
+        logWith(log_context(), spdlog::level::info, "{}", error_message);
+
+        // 읽기/쓰기 오류가 연달아 들어와도 정리는 한 번만 수행
+        if (closed_) return;
+        closed_ = true;
+
+        // 미러 서버 연결이 끊기면 응답을 기다리던 방 생성 요청을 즉시 실패 처리
+        if (is_mirror_ && mirror_channel_) {
+            mirror_channel_->failAll("미러 서버 연결 종료");
+        }
+
+        // 로그인 세션은 재개 대기 기간 동안 방 상태를 유지하고 보관 (기간 만료 시 서버가 퇴장 처리)
+        if (retain && !is_mirror_ && user_id_ > 0 && !token_.empty()) {
+            RetainedSession state;
+            state.user_id = user_id_;
+            state.user_name = user_name_;
+            state.nick_name = nick_name_;
+            state.status = status_;
+            state.remote_ip = remote_ip_;
+            retained_ = server_->retainSession(token_, std::move(state));
+        }
 
         // 사용자가 방에 참여 중이라면 퇴장 처리
         try {
             auto controller_it = controllers_.find("room");
-            if (controller_it != controllers_.end() && user_id_ > 0) {
-                spdlog::debug("사용자 {}의 자동 방 퇴장 시도 중", user_id_);
+            if (controller_it != controllers_.end() && user_id_ > 0 && !retained_) {
+                logWith(log_context(), spdlog::level::debug, "자동 방 퇴장 시도 중");
 
                 json temp = {
                     {"action", "exitRoom"},
@@ -459,7 +893,7 @@ namespace game_server {
                 spdlog::error("소켓 종료 중 에러가 발생하였습니다. : {}", ec.message());
             }
             else {
-                spdlog::info("소켓을 정상적으로 종료하였습니다.");
+                logWith(log_context(), spdlog::level::debug, "소켓을 정상적으로 종료하였습니다.");
             }
         }
     }
@@ -468,28 +902,32 @@ namespace game_server {
         return user_id_;
     }
 
-    std::string Session::getUserNickName() {
-        return nick_name_;
+    std::string_view Session::getUserNickName() const {
+        return nick_name_.view();
     }
 
-    void Session::setStatus(const std::string& status) {
+    void Session::setStatus(SessionStatus status) {
         status_ = status;
     }
 
-    std::string Session::getStatus() {
+    const SessionStatus& Session::getStatus() const {
         return status_;
     }
 
-    void Session::setToken(const std::string& token) {
+    void Session::setToken(const auth::SessionToken& token) {
         token_ = token;
     }
 
     void Session::init_current_user(const json& response) {
         if (response.contains("userId")) user_id_ = response["userId"];
         if (response.contains("userName")) user_name_ = response["userName"];
-        if (response.contains("nickName")) nick_name_ = response["nickName"];
-        status_ = "대기중";
-        spdlog::info("{}유저가 로그인 하였습니다. (ID: {}) 닉네임 : {}", user_name_, user_id_, nick_name_);
+        if (response.contains("nickName")) nick_name_.assign(response["nickName"].get_ref<const std::string&>());
+        status_ = SessionStatus::waiting();
+        logWith(log_context(), spdlog::level::info, "{}유저가 로그인 하였습니다. 닉네임 : {}", user_name_, nick_name_.view());
+    }
+
+    LogContext Session::log_context() const {
+        return LogContext{ session_id_, user_id_ };
     }
 
 } // namespace game_server
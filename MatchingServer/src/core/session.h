@@ -1,10 +1,18 @@
 ﻿// core/session.h
 #pragma once
 #include "../controller/controller.h"
+#include "rate_limiter.h"
+#include "session_identity.h"
+#include "../util/object_pool.h"
+#include "../util/handler_allocator.h"
+#include "../util/logging.h"
+#include "auth/signed_token.h"
 #include <boost/asio.hpp>
 #include <memory>
 #include <string>
 #include <array>
+#include <deque>
+#include <functional>
 #include <map>
 #include <nlohmann/json.hpp>
 
@@ -12,6 +20,15 @@ namespace game_server {
 
     using json = nlohmann::json;
     class Server;
+    class MirrorChannel;
+    class Session;
+    class Trace;
+
+    // 세션 블록 풀 (shared_ptr 제어 블록과 세션을 한 블록으로 할당)
+    struct SessionPoolTag {
+        static FixedBlockPool& pool();
+    };
+    using SessionAllocator = PoolAllocator<Session, SessionPoolTag>;
 
     class Session : public std::enable_shared_from_this<Session> {
     public:
@@ -21,41 +38,66 @@ namespace game_server {
         ~Session();
 
         void start();
-        const std::string& getToken() const;
+        const auth::SessionToken& getToken() const;
         void initialize();
         void handlePing();
         bool isActive(std::chrono::seconds timeout) const;
-        void handle_error(const std::string& error_message);
-        void setToken(const std::string& token);
+        // retain이 true면 로그인 세션을 재개 대기 상태로 보관 (로그아웃, 서버 중단 시 false)
+        void handle_error(const std::string& error_message, bool retain = true);
+        void setToken(const auth::SessionToken& token);
         int getUserId();
-        std::string getUserNickName();
-        void setStatus(const std:: string& status);
-        std::string getStatus();
+        std::string_view getUserNickName() const;
+        void setStatus(SessionStatus status);
+        const SessionStatus& getStatus() const;
         void write_broadcast(const std::string& response);
+        bool hasPendingWrites() const;
+        const RemoteAddress& getRemoteIp() const;
+
+        // 같은 토큰으로 재개 요청이 들어온 경우 기존 연결을 보관 상태로 전환하고 종료
+        void detachForResume(bool transfer_ip);
+
+        // 미러 세션 전용: requestId가 부여된 명령 전송, ack/nack 또는 타임아웃 시 callback 호출
+        void sendMirrorCommand(const json& command, std::function<void(bool, const json&)> callback);
 
     private:
         void read_message();
-        void process_request(json& request);
+        bool parse_request(const char* data, std::size_t length, json& request);
+        void process_request(json& request, std::shared_ptr<Trace> trace = nullptr);
+        void handle_controller_response(const std::string& action, json response);
         void write_response(const std::string& response);
+        void do_write();
         void init_current_user(const json& response);
         void read_handshake();
         void write_handshake_response(const std::string& response);
-        void write_mirror(const std::string& response, std::shared_ptr<Session> mirror);
+        void handle_create_room(json response);
+        void rollback_created_room(int roomId);
+        void handle_resume(const json& request);
+        template <class Handler>
+        void async_receive(Handler handler);
+        LogContext log_context() const;
 
         boost::asio::ip::tcp::socket socket_;
         std::map<std::string, std::shared_ptr<Controller>>& controllers_;
-        std::array<char, 8192> buffer_;
-        std::string message_;
+        std::deque<std::string> write_queue_;
+        // 읽기 대기/쓰기 핸들러 상태를 매번 힙에 할당하지 않도록 작업별로 재사용하는 메모리
+        HandlerMemory read_handler_memory_;
+        HandlerMemory write_handler_memory_;
         int user_id_;
         std::string user_name_;
-        std::string nick_name_;
-        std::string status_;
+        NickName nick_name_;
+        SessionStatus status_;
         Server* server_;
+        std::weak_ptr<const void> server_lifetime_;  // 만료되면 server_는 이미 소멸함
         std::chrono::steady_clock::time_point last_activity_time_;
-        std::string token_;
+        auth::SessionToken token_;
         bool is_mirror_ = false;
         int mirror_port_;
-        std::string remote_ip_;
+        std::shared_ptr<MirrorChannel> mirror_channel_;
+        RemoteAddress remote_ip_;
+        std::uint64_t session_id_;
+        RateLimiter::SessionBuckets rate_buckets_;
+        bool closed_ = false;
+        bool retained_ = false;
     };
 
 } // namespace game_server
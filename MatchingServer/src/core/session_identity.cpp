@@ -0,0 +1,48 @@
+﻿// core/session_identity.cpp
+// 세션 식별 정보(상태, 접속 IP) 구현 파일
+#include "session_identity.h"
+
+namespace game_server {
+
+    std::string SessionStatus::toString() const {
+        switch (state) {
+        case UserStatus::Waiting: return "대기중";
+        case UserStatus::InRoom: return std::to_string(room_id) + "번 방";
+        case UserStatus::InGame: return "게임중";
+        case UserStatus::None: break;
+        }
+        return "";
+    }
+
+    RemoteAddress::RemoteAddress(const boost::asio::ip::address& address)
+        : valid_(true)
+    {
+        if (address.is_v4()) {
+            bytes_ = boost::asio::ip::make_address_v6(boost::asio::ip::v4_mapped, address.to_v4()).to_bytes();
+        }
+        else {
+            bytes_ = address.to_v6().to_bytes();
+        }
+    }
+
+    std::string RemoteAddress::toString() const {
+        if (!valid_) return "";
+        boost::asio::ip::address_v6 address(bytes_);
+        // 듀얼 스택으로 들어온 IPv4 클라이언트는 IPv4 표기로 출력
+        if (address.is_v4_mapped()) {
+            return boost::asio::ip::make_address_v4(boost::asio::ip::v4_mapped, address).to_string();
+        }
+        return address.to_string();
+    }
+
+    std::size_t RemoteAddressHash::operator()(const RemoteAddress& address) const {
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (unsigned char byte : address.bytes_) {
+            hash ^= byte;
+            hash *= 1099511628211ULL;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+
+} // namespace game_server
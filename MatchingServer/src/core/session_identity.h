@@ -0,0 +1,93 @@
+﻿// core/session_identity.h
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <boost/asio/ip/address.hpp>
+
+namespace game_server {
+
+    // 힙 할당 없는 고정 용량 문자열, 용량을 넘으면 UTF-8 문자 경계에서 자름
+    template <std::size_t Capacity>
+    class InlineString {
+        static_assert(Capacity <= 255, "길이를 1바이트로 저장하므로 255 이하만 가능");
+    public:
+        InlineString() = default;
+
+        void assign(std::string_view text) {
+            std::size_t length = std::min(text.size(), Capacity);
+            if (length < text.size()) {
+                // 잘린 위치가 멀티바이트 문자의 연속 바이트(10xxxxxx)면 문자 시작까지 되돌림
+                while (length > 0 && (static_cast<unsigned char>(text[length]) & 0xC0) == 0x80) {
+                    --length;
+                }
+            }
+            std::copy_n(text.data(), length, chars_.data());
+            size_ = static_cast<std::uint8_t>(length);
+        }
+
+        std::string_view view() const { return std::string_view(chars_.data(), size_); }
+        bool empty() const { return size_ == 0; }
+        void clear() { size_ = 0; }
+
+    private:
+        std::array<char, Capacity> chars_;
+        std::uint8_t size_ = 0;
+    };
+
+    // users.nick_name VARCHAR(16) 기준 16글자, UTF-8 한 글자 최대 4바이트
+    using NickName = InlineString<64>;
+
+    enum class UserStatus : std::uint8_t {
+        None,       // 로그인 전
+        Waiting,    // 대기실
+        InRoom,     // 방 참가 중 (room_id)
+        InGame      // 게임 중
+    };
+
+    struct SessionStatus {
+        UserStatus state = UserStatus::None;
+        int room_id = 0;
+
+        static SessionStatus waiting() { return { UserStatus::Waiting, 0 }; }
+        static SessionStatus inRoom(int roomId) { return { UserStatus::InRoom, roomId }; }
+        static SessionStatus inGame() { return { UserStatus::InGame, 0 }; }
+
+        bool isWaiting() const { return state == UserStatus::Waiting; }
+
+        // 클라이언트에 보내는 표시 문자열 ("대기중", "N번 방", "게임중")
+        std::string toString() const;
+    };
+
+    // 접속 IP를 16바이트로 보관 (IPv4는 IPv4-mapped IPv6 형태로 정규화)
+    class RemoteAddress {
+    public:
+        RemoteAddress() = default;
+        explicit RemoteAddress(const boost::asio::ip::address& address);
+
+        bool empty() const { return !valid_; }
+        void clear() {
+            bytes_.fill(0);
+            valid_ = false;
+        }
+        std::string toString() const;
+
+        bool operator==(const RemoteAddress& other) const {
+            return valid_ == other.valid_ && bytes_ == other.bytes_;
+        }
+        bool operator!=(const RemoteAddress& other) const { return !(*this == other); }
+
+    private:
+        friend struct RemoteAddressHash;
+        std::array<unsigned char, 16> bytes_{};
+        bool valid_ = false;
+    };
+
+    struct RemoteAddressHash {
+        std::size_t operator()(const RemoteAddress& address) const;
+    };
+
+} // namespace game_server
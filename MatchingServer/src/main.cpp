@@ -1,28 +1,17 @@
 ﻿// main.cpp
 // 프로그램 진입점 및 서버 실행 파일
 #include "core/server.h"
+#include "util/config_loader.h"
+#include "util/logging.h"
 #include <boost/asio.hpp>
 #include <iostream>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <csignal>
 #include <cstdlib>
+#include <functional>
 #include <string>
 
-// 시그널 핸들러용 전역 서버 변수
-std::unique_ptr<game_server::Server> server;
-
-// 시그널 핸들러 함수
-void signal_handler(int signal)
-{
-    spdlog::info("시그널 받음 {}, 서버 종료...", signal);
-    if (server) {
-        server->stop();
-    }
-    std::exit(0);
-    exit(signal);
-}
-
 int main(int argc, char* argv[])
 {
     try {
@@ -31,27 +20,64 @@ int main(int argc, char* argv[])
         spdlog::set_default_logger(console);
         spdlog::set_level(spdlog::level::info);
 
-        // 시그널 핸들러 등록
-        std::signal(SIGINT, signal_handler);
-        std::signal(SIGTERM, signal_handler);
-
         // 기본 설정
         short port = atoi(std::getenv("SERVER_PORT"));
         std::string version = std::getenv("SERVER_VERSION");
-        std::string db_host = std::getenv("DB_HOST");
-        std::string db_port = std::getenv("DB_PORT");
-        std::string db_user = std::getenv("DB_USER");
-        std::string db_password = std::getenv("DB_PASSWORD");
-        std::string db_name = std::getenv("DB_NAME");
+        // DB 환경 변수는 메모리 리포지토리("repository.backend": "memory")를 쓰면 없어도 됨
+        auto env = [](const char* name) {
+            const char* value = std::getenv(name);
+            return std::string(value ? value : "");
+        };
+        std::string db_host = env("DB_HOST");
+        std::string db_port = env("DB_PORT");
+        std::string db_user = env("DB_USER");
+        std::string db_password = env("DB_PASSWORD");
+        std::string db_name = env("DB_NAME");
         std::string db_connection_string =
             "dbname=" + db_name + " user=" + db_user + " password=" + db_password + " host=" + db_host +  " port=" + db_port +" client_encoding=UTF8";
 
+        // 요청 수 제한 등 부가 설정 (CONFIG_PATH 미지정 시 기본 경로)
+        const char* config_path = std::getenv("CONFIG_PATH");
+        nlohmann::json config = game_server::ConfigLoader::load(config_path ? config_path : "./src/config/config.json");
+
+        // 설정에 따라 비동기/JSON 로거로 교체 (설정을 읽기 전까지는 위의 콘솔 로거 사용)
+        game_server::initLogging(game_server::LoggingConfig::fromJson(config.value("logging", nlohmann::json::object())));
+
         spdlog::info("환경 변수 불러오기 완료! 매칭 서버 버전 : {}, 포트 번호 : {}", version, port);
 
         // IO 컨텍스트 및 서버 생성
         boost::asio::io_context io_context;
-        server = std::make_unique<game_server::Server>(
-            io_context, port, db_connection_string, version);
+        auto server = std::make_unique<game_server::Server>(
+            io_context, port, db_connection_string, version, config);
+
+        // 드레인이 끝나면 이벤트 루프 종료
+        server->setShutdownHandler([&io_context]() {
+            io_context.stop();
+        });
+
+        // 시그널은 이벤트 루프 안에서 처리 (시그널 컨텍스트에서 세션/DB를 건드리지 않음)
+        boost::asio::signal_set signals(io_context, SIGINT, SIGTERM);
+        signals.async_wait([&server](const boost::system::error_code& ec, int signal) {
+            if (ec) return;
+            spdlog::info("시그널 받음 {}, 서버 드레인 시작...", signal);
+            server->drain();
+        });
+
+#ifndef _WIN32
+        // SIGHUP: 설정 파일을 다시 읽어 토큰 서명 키 교체 (재시작 없이 키 롤링)
+        boost::asio::signal_set reload_signals(io_context, SIGHUP);
+        std::string reload_path = config_path ? config_path : "./src/config/config.json";
+        std::function<void()> wait_reload;
+        wait_reload = [&]() {
+            reload_signals.async_wait([&](const boost::system::error_code& ec, int /*signal*/) {
+                if (ec) return;
+                spdlog::info("SIGHUP 받음, 토큰 서명 키를 다시 불러옵니다");
+                server->reloadTokenKeys(game_server::ConfigLoader::load(reload_path));
+                wait_reload();
+            });
+        };
+        wait_reload();
+#endif
 
         // 서버 실행
         server->run();
@@ -59,12 +85,24 @@ int main(int argc, char* argv[])
         // IO 컨텍스트 실행 (이벤트 루프)
         spdlog::info("서버 시작, 포트 : {}", port);
         io_context.run();
+
+        // stop()이 닫은 세션의 취소된 핸들러를 서버가 살아 있는 동안 실행해 세션 정리를 마침
+        // (io_context.stop() 이후라 실행되지 못하고 대기 중)
+        io_context.restart();
+        io_context.poll();
+
+        // io_context보다 먼저 서버(타이머, 소켓) 정리
+        server.reset();
+        spdlog::info("서버 종료 완료");
     }
     catch (std::exception& e) {
         spdlog::error("서버 설정 중 예외 발생: {}", e.what());
+        spdlog::shutdown();
         return 1;
     }
 
+    // 비동기 큐에 남은 로그를 모두 출력한 뒤 종료
+    spdlog::shutdown();
     return 0;
 }
 
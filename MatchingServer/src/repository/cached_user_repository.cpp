@@ -0,0 +1,209 @@
+﻿// repository/cached_user_repository.cpp
+// 사용자 캐시 리포지토리 구현 파일
+// 로그인 시 반복되는 사용자 조회의 DB 왕복을 줄이는 데코레이터
+#include "cached_user_repository.h"
+#include "../util/tracing.h"
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    UserCacheConfig UserCacheConfig::fromJson(const json& config) {
+        UserCacheConfig result;
+        if (!config.is_object()) return result;
+
+        result.enabled = config.value("enabled", result.enabled);
+        result.capacity = config.value("capacity", result.capacity);
+        result.ttl = std::chrono::seconds(config.value("ttlSeconds", static_cast<int>(result.ttl.count())));
+        result.negative_ttl = std::chrono::seconds(
+            config.value("negativeTtlSeconds", static_cast<int>(result.negative_ttl.count())));
+        if (result.capacity < 1) result.capacity = 1;
+        return result;
+    }
+
+    // 리포지토리 구현체
+    class CachedUserRepositoryImpl : public UserRepository {
+    public:
+        CachedUserRepositoryImpl(std::shared_ptr<UserRepository> inner, const UserCacheConfig& config)
+            : inner_(std::move(inner)),
+            config_(config)
+        {
+            spdlog::info("사용자 캐시 활성화 (최대 {}개, TTL {}초)", config_.capacity, config_.ttl.count());
+        }
+
+        ~CachedUserRepositoryImpl() override {
+            spdlog::info("사용자 캐시 종료, 적중 {}회 (없는 사용자 {}회), 미적중 {}회 (DB 오류 {}회, 조회 중 변경으로 미보관 {}회), 제거 {}회",
+                hits_.load(), negative_hits_.load(), misses_.load(), lookup_failures_.load(), stale_inserts_.load(), evictions_.load());
+        }
+
+        json findByUsername(const std::string& userName) override {
+            ScopedSpan span("UserCache.findByUsername");
+            std::string key = normalizeUserName(userName);
+            auto now = std::chrono::steady_clock::now();
+            std::uint64_t generation;
+            {
+                std::lock_guard<std::mutex> lock(cache_mutex_);
+                generation = generation_;
+                auto it = index_.find(key);
+                if (it != index_.end()) {
+                    if (it->second->expires_at > now) {
+                        // 최근 사용 항목을 앞으로 이동
+                        lru_.splice(lru_.begin(), lru_, it->second);
+                        hits_++;
+                        if (it->second->user["userId"] == kUserNotFound) negative_hits_++;
+                        return it->second->user;
+                    }
+                    erase_locked(it);
+                }
+            }
+
+            misses_++;
+            json user = inner_->findByUsername(userName);
+
+            // DB 오류는 보관하지 않음 (일시적인 장애로 실제 사용자가 없는 사용자로 캐시되지 않도록)
+            if (user["userId"] == kLookupFailed) {
+                lookup_failures_++;
+                return user;
+            }
+            bool negative = user["userId"] == kUserNotFound;
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            // 조회하는 동안 생성/변경이 있었으면 조회 결과가 이미 오래된 것일 수 있으므로 보관하지 않음
+            // (인증 작업 스레드가 여럿이라 없는 사용자 결과가 방금 가입한 사용자를 덮어쓸 수 있음)
+            if (generation != generation_) {
+                stale_inserts_++;
+                return user;
+            }
+            insert_locked(key, user, now + (negative ? config_.negative_ttl : config_.ttl));
+            return user;
+        }
+
+        int create(const std::string& userName, const std::string& hashedPassword) override {
+            int userId = inner_->create(userName, hashedPassword);
+
+            // 없는 사용자로 캐시된 항목 무효화
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            generation_++;
+            auto it = index_.find(normalizeUserName(userName));
+            if (it != index_.end()) {
+                erase_locked(it);
+            }
+            return userId;
+        }
+
+        bool updateLastLogin(int userId) override {
+            return inner_->updateLastLogin(userId);
+        }
+
+        bool updateLastLoginBatch(const std::vector<int>& userIds) override {
+            return inner_->updateLastLoginBatch(userIds);
+        }
+
+        bool updateUserNickName(int userId, const std::string& nickName) override {
+            ScopedSpan span("UserCache.updateUserNickName");
+            bool updated = inner_->updateUserNickName(userId, nickName);
+
+            // DB 반영에 성공한 경우 캐시에도 그대로 반영, 실패하면 항목을 버려 다음 조회 때 DB에서 다시 읽음
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            generation_++;
+            auto id_it = user_keys_.find(userId);
+            if (id_it == user_keys_.end()) return updated;
+
+            auto it = index_.find(id_it->second);
+            if (it == index_.end()) return updated;
+            if (updated) {
+                it->second->user["nickName"] = nickName;
+            }
+            else {
+                erase_locked(it);
+            }
+            return updated;
+        }
+
+        bool updatePasswordHash(int userId, const std::string& hashedPassword) override {
+            ScopedSpan span("UserCache.updatePasswordHash");
+            bool updated = inner_->updatePasswordHash(userId, hashedPassword);
+
+            std::lock_guard<std::mutex> lock(cache_mutex_);
+            generation_++;
+            auto id_it = user_keys_.find(userId);
+            if (id_it == user_keys_.end()) return updated;
+
+            auto it = index_.find(id_it->second);
+            if (it == index_.end()) return updated;
+            if (updated) {
+                it->second->user["passwordHash"] = hashedPassword;
+            }
+            else {
+                erase_locked(it);
+            }
+            return updated;
+        }
+
+    private:
+        struct Entry {
+            std::string key;
+            json user;
+            std::chrono::steady_clock::time_point expires_at;
+        };
+        using EntryList = std::list<Entry>;
+
+        void insert_locked(const std::string& key, const json& user, std::chrono::steady_clock::time_point expires_at) {
+            auto it = index_.find(key);
+            if (it != index_.end()) {
+                erase_locked(it);
+            }
+
+            lru_.push_front(Entry{ key, user, expires_at });
+            index_[key] = lru_.begin();
+            int userId = user["userId"].get<int>();
+            if (userId > 0) {
+                user_keys_[userId] = key;
+            }
+
+            while (lru_.size() > config_.capacity) {
+                auto oldest = index_.find(lru_.back().key);
+                erase_locked(oldest);
+                evictions_++;
+            }
+        }
+
+        void erase_locked(std::unordered_map<std::string, EntryList::iterator>::iterator it) {
+            int userId = it->second->user["userId"].get<int>();
+            if (userId > 0) {
+                user_keys_.erase(userId);
+            }
+            lru_.erase(it->second);
+            index_.erase(it);
+        }
+
+        std::shared_ptr<UserRepository> inner_;
+        UserCacheConfig config_;
+
+        // LRU 캐시 (앞쪽이 최근 사용)
+        EntryList lru_;
+        std::unordered_map<std::string, EntryList::iterator> index_;
+        std::unordered_map<int, std::string> user_keys_;
+        // 생성/변경 시마다 증가, 조회 시작 이후 바뀌었으면 DB 결과를 캐시에 넣지 않음
+        std::uint64_t generation_ = 0;
+        std::mutex cache_mutex_;
+
+        // 캐시 통계
+        std::atomic<std::uint64_t> hits_{ 0 };
+        std::atomic<std::uint64_t> negative_hits_{ 0 };
+        std::atomic<std::uint64_t> misses_{ 0 };
+        std::atomic<std::uint64_t> evictions_{ 0 };
+        std::atomic<std::uint64_t> lookup_failures_{ 0 };
+        std::atomic<std::uint64_t> stale_inserts_{ 0 };
+    };
+
+    // 팩토리 메서드 구현
+    std::unique_ptr<UserRepository> CachedUserRepository::create(std::shared_ptr<UserRepository> inner, const UserCacheConfig& config) {
+        return std::make_unique<CachedUserRepositoryImpl>(std::move(inner), config);
+    }
+
+} // namespace game_server
@@ -0,0 +1,31 @@
+﻿// repository/cached_user_repository.h
+#pragma once
+#include "user_repository.h"
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    // 로그인 경로 사용자 캐시 설정 (config.json의 "userCache" 섹션)
+    struct UserCacheConfig {
+        bool enabled = true;
+        std::size_t capacity = 10000;                        // LRU 최대 항목 수
+        std::chrono::seconds ttl{ 300 };                     // 존재하는 사용자 항목 유지 시간
+        std::chrono::seconds negative_ttl{ 30 };             // 존재하지 않는 사용자 항목 유지 시간
+
+        static UserCacheConfig fromJson(const nlohmann::json& config);
+    };
+
+    // UserRepository 앞단의 캐시 데코레이터
+    // findByUsername 결과를 정규화된(소문자) 사용자 이름 기준 LRU로 보관하고, 없는 이름도 짧게 보관한다.
+    // 닉네임 변경은 캐시에 그대로 반영하고, 사용자 생성 시 해당 이름의 항목을 무효화한다.
+    // 조회가 DB를 다녀오는 동안 생성/변경이 있었으면 그 조회 결과는 보관하지 않는다.
+    // (last_login 갱신은 내부 리포지토리의 지연 반영 큐가 모아서 처리한다.)
+    class CachedUserRepository {
+    public:
+        static std::unique_ptr<UserRepository> create(std::shared_ptr<UserRepository> inner, const UserCacheConfig& config);
+    };
+
+} // namespace game_server
@@ -1,5 +1,7 @@
 ﻿#include "game_repository.h"
 #include "../util/db_pool.h"
+#include "../util/traced_sql.h"
+#include "../util/write_behind_queue.h"
 #include <pqxx/pqxx>
 #include <spdlog/spdlog.h>
 
@@ -10,9 +12,16 @@ namespace game_server {
     // 리포지토리 구현체
     class GameRepositoryImpl : public GameRepository {
     public:
-        explicit GameRepositoryImpl(DbPool* dbPool) : dbPool_(dbPool) {}
+        GameRepositoryImpl(DbPool* dbPool, WriteBehindQueue* writeBehind)
+            : dbPool_(dbPool), writeBehind_(writeBehind) {
+            if (writeBehind_) {
+                writeBehind_->registerKind("completeGame",
+                    [this](const std::vector<int>& gameIds) { return completeGames(gameIds); });
+            }
+        }
 
         json createGame(const json& request) {
+            ScopedSpan span("GameRepository.createGame");
             json response = {
                 {"gameId", -1},
                 { "users", json::array() }
@@ -23,13 +32,13 @@ namespace game_server {
                 int roomId = request["roomId"];
                 int mapId = request["mapId"];
 
-                pqxx::result result = txn.exec_params(
+                pqxx::result result = tracedExec(txn, "sql INSERT games",
                     "INSERT INTO games (room_id, map_id) "
                     "VALUES ($1, $2) "
                     "RETURNING game_id",
                     roomId, mapId);
 
-                pqxx::result updateRoom = txn.exec_params(
+                pqxx::result updateRoom = tracedExec(txn, "sql UPDATE rooms",
                     "UPDATE rooms "
                     "SET status = 'GAME_IN_PROGRESS' "
                     "WHERE room_id = $1 "
@@ -43,9 +52,10 @@ namespace game_server {
                     return response;
                 }
                 int gameId = result[0][0].as<int>();
+                response["gameId"] = gameId;
                 spdlog::info("방 번호 : {}에 대한 게임 세션이 생성되었습니다 게임 ID: {}", roomId, gameId);
 
-                pqxx::result inRoomUsers = txn.exec_params(
+                pqxx::result inRoomUsers = tracedExec(txn, "sql SELECT room_users",
                     "SELECT user_id FROM room_users WHERE room_id = $1",
                     roomId);
 
@@ -53,7 +63,7 @@ namespace game_server {
                     response["users"].push_back(res[0].as<int>());
                 }
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
                 return response;
             }
@@ -66,6 +76,15 @@ namespace game_server {
         }
 
         json endGame(int gameId) {
+            ScopedSpan span("GameRepository.endGame");
+            // 응답에 필요한 방 ID와 참가자만 조회하고, 완료 처리는 지연 반영 큐에 넣음
+            if (writeBehind_) {
+                json response = findGameParticipants(gameId);
+                if (response["gameId"] == -1 || writeBehind_->enqueue("completeGame", gameId)) {
+                    return response;
+                }
+            }
+
             json response = {
                 {"gameId", -1},
                 { "users", json::array()}
@@ -73,7 +92,7 @@ namespace game_server {
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             try {
-                pqxx::result result = txn.exec_params(
+                pqxx::result result = tracedExec(txn, "sql UPDATE games",
                     "UPDATE games "
                     "SET status = 'COMPLETED', completed_at = CURRENT_TIMESTAMP "
                     "WHERE game_id = $1 "
@@ -87,9 +106,10 @@ namespace game_server {
                     return response;
                 }
                 int roomId = result[0][0].as<int>();
+                response["gameId"] = gameId;
                 spdlog::info("게임 ID: {}의 상태가 성공적으로 완료로 업데이트되었습니다", gameId);
 
-                pqxx::result inRoomUsers = txn.exec_params(
+                pqxx::result inRoomUsers = tracedExec(txn, "sql SELECT room_users",
                     "SELECT user_id FROM room_users WHERE room_id = $1",
                     roomId);
                 response["roomId"] = roomId;
@@ -97,7 +117,7 @@ namespace game_server {
                     response["users"].push_back(res[0].as<int>());
                 }
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
                 return response;
             }
@@ -109,14 +129,81 @@ namespace game_server {
             }
         }
 
+        // 읽기만 하므로 BEGIN/COMMIT 없이 한 번의 왕복으로 조회
+        json findGameParticipants(int gameId) {
+            ScopedSpan span("GameRepository.findGameParticipants");
+            json response = {
+                {"gameId", -1},
+                { "users", json::array()}
+            };
+            auto conn = dbPool_->get_connection();
+            pqxx::result result;
+            try {
+                // ntx가 소멸된 뒤에 연결을 반환해야 다른 스레드가 같은 연결로 트랜잭션을 열지 않음
+                {
+                    pqxx::nontransaction ntx(*conn);
+                    result = tracedExec(ntx, "sql SELECT games",
+                        "SELECT g.room_id, ru.user_id FROM games g "
+                        "LEFT JOIN room_users ru ON ru.room_id = g.room_id "
+                        "WHERE g.game_id = $1",
+                        gameId);
+                }
+                dbPool_->return_connection(conn);
+            }
+            catch (const std::exception& e) {
+                dbPool_->return_connection(conn);
+                spdlog::error("findGameParticipants 데이터베이스 오류: {}", e.what());
+                return response;
+            }
+
+            if (result.empty()) {
+                spdlog::error("게임 ID: {}에 해당하는 방 ID를 찾을 수 없습니다", gameId);
+                return response;
+            }
+
+            response["gameId"] = gameId;
+            response["roomId"] = result[0][0].as<int>();
+            for (const auto& res : result) {
+                if (!res[1].is_null()) {
+                    response["users"].push_back(res[1].as<int>());
+                }
+            }
+            return response;
+        }
+
+        // 지연 반영 큐에서 호출, 모아 둔 게임들을 한 번에 완료 처리
+        bool completeGames(const std::vector<int>& gameIds) {
+            ScopedSpan span("GameRepository.completeGames");
+            auto conn = dbPool_->get_connection();
+            pqxx::work txn(*conn);
+            try {
+                tracedExec(txn, "sql UPDATE games",
+                    "UPDATE games "
+                    "SET status = 'COMPLETED', completed_at = CURRENT_TIMESTAMP "
+                    "WHERE game_id = ANY($1::int[]) AND status = 'IN_PROGRESS'",
+                    WriteBehindQueue::toArrayLiteral(gameIds));
+
+                tracedCommit(txn);
+                dbPool_->return_connection(conn);
+                return true;
+            }
+            catch (const std::exception& e) {
+                txn.abort();
+                dbPool_->return_connection(conn);
+                spdlog::error("completeGames 데이터베이스 오류: {}", e.what());
+                return false;
+            }
+        }
+
 
     private:
         DbPool* dbPool_;
+        WriteBehindQueue* writeBehind_;
     };
 
     // 팩토리 메서드 구현
-    std::unique_ptr<GameRepository> GameRepository::create(DbPool* dbPool) {
-        return std::make_unique<GameRepositoryImpl>(dbPool);
+    std::unique_ptr<GameRepository> GameRepository::create(DbPool* dbPool, WriteBehindQueue* writeBehind) {
+        return std::make_unique<GameRepositoryImpl>(dbPool, writeBehind);
     }
 
 } // namespace game_server
\ No newline at end of file
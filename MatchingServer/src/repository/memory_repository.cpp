@@ -0,0 +1,476 @@
+﻿// repository/memory_repository.cpp
+// 메모리 리포지토리 구현 파일
+// PostgreSQL 리포지토리와 같은 조건 검사와 결과 형식을 메모리 저장소 위에서 처리
+#include "memory_repository.h"
+#include "../util/tracing.h"
+#include "crypto/crypto_util.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    RepositoryConfig RepositoryConfig::fromJson(const json& config) {
+        RepositoryConfig result;
+        if (!config.is_object()) return result;
+        result.backend = config.value("backend", result.backend);
+        result.memory_rooms = config.value("memoryRooms", result.memory_rooms);
+        result.room_ip_address = config.value("roomIpAddress", result.room_ip_address);
+        result.room_base_port = config.value("roomBasePort", result.room_base_port);
+        return result;
+    }
+
+    namespace {
+        // db-init.sql의 VARCHAR(16) nick_name 제한 (바이트가 아닌 글자 수)
+        constexpr std::size_t kMaxNickNameChars = 16;
+        // db-init.sql에서 미리 넣는 맵 (map_id 1~3)
+        constexpr int kMapCount = 3;
+
+        // PostgreSQL timestamptz를 문자열로 읽은 것과 같은 형식 (UTC)
+        std::string timestampNow() {
+            std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            std::tm tm{};
+#ifdef _WIN32
+            gmtime_s(&tm, &now);
+#else
+            gmtime_r(&now, &tm);
+#endif
+            char buffer[32];
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S+00", &tm);
+            return buffer;
+        }
+
+        std::size_t utf8Length(const std::string& text) {
+            std::size_t length = 0;
+            for (unsigned char c : text) {
+                if ((c & 0xC0) != 0x80) ++length;
+            }
+            return length;
+        }
+
+        // nick_name 기본값 'user_' || substring(md5(random()::text), 1, 10)과 같은 형태
+        std::string defaultNickName() {
+            unsigned char bytes[5];
+            if (!crypto::randomBytes(bytes, sizeof(bytes))) {
+                return "user_0000000000";
+            }
+            return "user_" + crypto::toHexString(bytes, sizeof(bytes));
+        }
+    }
+
+    class MemoryDatabase {
+    public:
+        struct UserRow {
+            int user_id;
+            std::string user_name;
+            std::string nick_name;
+            std::string password_hash;
+            std::string created_at;
+            std::string last_login;
+        };
+
+        struct RoomRow {
+            int room_id;
+            std::string room_name;
+            int host_id;
+            std::string ip_address;
+            int port;
+            int max_players = 8;
+            std::string status = "TERMINATED";
+            std::string created_at;
+            std::uint64_t created_seq = 0;   // 같은 초에 만든 방도 created_at DESC 순서를 지키기 위한 순번
+            std::set<int> players;           // room_users
+        };
+
+        struct GameRow {
+            int game_id;
+            int room_id;
+            int map_id;
+            std::string status = "IN_PROGRESS";
+        };
+
+        explicit MemoryDatabase(const RepositoryConfig& config) {
+            std::string now = timestampNow();
+            users_[0] = UserRow{ 0, "Mirror", "Manager", "Mirror", now, now };
+            users_by_name_[UserRepository::normalizeUserName("Mirror")] = 0;
+
+            for (std::size_t i = 0; i < config.memory_rooms; ++i) {
+                RoomRow room;
+                room.room_id = static_cast<int>(i) + 1;
+                room.room_name = "room" + std::to_string(i);
+                room.host_id = 0;
+                room.ip_address = config.room_ip_address;
+                room.port = config.room_base_port + static_cast<int>(i);
+                room.created_at = now;
+                rooms_.emplace(room.room_id, std::move(room));
+            }
+        }
+
+        // 리포지토리 메서드 하나가 트랜잭션 하나에 해당 (잠금을 쥔 채 검사와 변경을 모두 수행)
+        std::mutex mutex_;
+        std::map<int, UserRow> users_;
+        std::unordered_map<std::string, int> users_by_name_;   // LOWER(user_name) 유니크 인덱스
+        int next_user_id_ = 1;
+        std::map<int, RoomRow> rooms_;
+        std::unordered_map<int, std::set<int>> rooms_by_user_;  // idx_room_users_user_id
+        std::map<int, GameRow> games_;
+        int next_game_id_ = 1;
+        std::uint64_t next_room_seq_ = 1;
+    };
+
+    namespace {
+
+        class MemoryUserRepository : public UserRepository {
+        public:
+            explicit MemoryUserRepository(std::shared_ptr<MemoryDatabase> db)
+                : db_(std::move(db)) {
+            }
+
+            json findByUsername(const std::string& userName) override {
+                ScopedSpan span("UserRepository.findByUsername");
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto it = db_->users_by_name_.find(normalizeUserName(userName));
+                if (it == db_->users_by_name_.end()) {
+                    return { {"userId", kUserNotFound} };
+                }
+
+                const auto& row = db_->users_.at(it->second);
+                return {
+                    {"userId", row.user_id},
+                    {"userName", row.user_name},
+                    {"passwordHash", row.password_hash},
+                    {"nickName", row.nick_name},
+                    {"createdAt", row.created_at},
+                    {"lastLogin", row.last_login}
+                };
+            }
+
+            int create(const std::string& userName, const std::string& hashedPassword) override {
+                ScopedSpan span("UserRepository.create");
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                // VARCHAR(50)과 유니크 인덱스 위반은 INSERT 실패와 같이 -1
+                if (userName.size() > 50) return -1;
+                std::string key = normalizeUserName(userName);
+                if (db_->users_by_name_.count(key)) {
+                    spdlog::error("사용자 생성 오류: 이미 존재하는 아이디 {}", userName);
+                    return -1;
+                }
+
+                int userId = db_->next_user_id_++;
+                std::string now = timestampNow();
+                db_->users_[userId] = MemoryDatabase::UserRow{ userId, userName, defaultNickName(), hashedPassword, now, now };
+                db_->users_by_name_[key] = userId;
+                return userId;
+            }
+
+            bool updateLastLogin(int userId) override {
+                ScopedSpan span("UserRepository.updateLastLogin");
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto it = db_->users_.find(userId);
+                if (it == db_->users_.end()) return false;
+                it->second.last_login = timestampNow();
+                return true;
+            }
+
+            bool updateLastLoginBatch(const std::vector<int>& userIds) override {
+                ScopedSpan span("UserRepository.updateLastLoginBatch");
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                std::string now = timestampNow();
+                for (int userId : userIds) {
+                    auto it = db_->users_.find(userId);
+                    if (it != db_->users_.end()) {
+                        it->second.last_login = now;
+                    }
+                }
+                return true;
+            }
+
+            bool updateUserNickName(int userId, const std::string& nickName) override {
+                ScopedSpan span("UserRepository.updateUserNickName");
+                if (utf8Length(nickName) > kMaxNickNameChars) {
+                    spdlog::error("닉네임 업데이트 오류: {}자를 넘는 닉네임", kMaxNickNameChars);
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto it = db_->users_.find(userId);
+                if (it == db_->users_.end()) return false;
+                it->second.nick_name = nickName;
+                return true;
+            }
+
+            bool updatePasswordHash(int userId, const std::string& hashedPassword) override {
+                ScopedSpan span("UserRepository.updatePasswordHash");
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto it = db_->users_.find(userId);
+                if (it == db_->users_.end()) return false;
+                it->second.password_hash = hashedPassword;
+                return true;
+            }
+
+        private:
+            std::shared_ptr<MemoryDatabase> db_;
+        };
+
+        class MemoryRoomRepository : public RoomRepository {
+        public:
+            explicit MemoryRoomRepository(std::shared_ptr<MemoryDatabase> db)
+                : db_(std::move(db)) {
+            }
+
+            std::vector<json> findAllOpen() override {
+                ScopedSpan span("RoomRepository.findAllOpen");
+                std::vector<const MemoryDatabase::RoomRow*> open;
+                std::vector<json> rooms;
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                for (const auto& [roomId, room] : db_->rooms_) {
+                    if (room.status == "WAITING" || room.status == "GAME_IN_PROGRESS") {
+                        open.push_back(&room);
+                    }
+                }
+                // ORDER BY created_at DESC
+                std::sort(open.begin(), open.end(), [](const auto* a, const auto* b) {
+                    return a->created_seq > b->created_seq;
+                    });
+
+                rooms.reserve(open.size());
+                for (const auto* room : open) {
+                    rooms.push_back({
+                        {"roomId", room->room_id},
+                        {"roomName", room->room_name},
+                        {"hostId", room->host_id},
+                        {"ipAddress", room->ip_address},
+                        {"port", room->port},
+                        {"maxPlayers", room->max_players},
+                        {"status", room->status},
+                        {"createdAt", room->created_at}
+                        });
+                }
+                return rooms;
+            }
+
+            json createRoomWithHost(int hostId, const std::string& roomName, int maxPlayers) override {
+                ScopedSpan span("RoomRepository.createRoomWithHost");
+                json result = {
+                    {"roomId", -1}
+                };
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto joined = db_->rooms_by_user_.find(hostId);
+                if (joined != db_->rooms_by_user_.end() && !joined->second.empty()) {
+                    return result;
+                }
+                // host_id, room_users.user_id 외래 키
+                if (!db_->users_.count(hostId)) {
+                    spdlog::error("createRoomWithHost 오류: 존재하지 않는 사용자 {}", hostId);
+                    return result;
+                }
+
+                // 유효한 방 ID 찾기 (가장 작은 TERMINATED 방 재활성화)
+                MemoryDatabase::RoomRow* room = nullptr;
+                for (auto& [roomId, candidate] : db_->rooms_) {
+                    if (candidate.status == "TERMINATED") {
+                        room = &candidate;
+                        break;
+                    }
+                }
+                if (!room) {
+                    return result;
+                }
+
+                room->room_name = roomName;
+                room->host_id = hostId;
+                room->max_players = maxPlayers;
+                room->status = "WAITING";
+                room->created_at = timestampNow();
+                room->created_seq = db_->next_room_seq_++;
+                room->players.insert(hostId);
+                db_->rooms_by_user_[hostId].insert(room->room_id);
+
+                result["roomId"] = room->room_id;
+                result["roomName"] = room->room_name;
+                result["ipAddress"] = room->ip_address;
+                result["port"] = room->port;
+                result["maxPlayers"] = room->max_players;
+                return result;
+            }
+
+            bool addPlayer(int roomId, int userId) override {
+                ScopedSpan span("RoomRepository.addPlayer");
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto it = db_->rooms_.find(roomId);
+                if (it == db_->rooms_.end()) {
+                    spdlog::error("방 {}이(가) 존재하지 않습니다", roomId);
+                    return false;
+                }
+
+                auto& room = it->second;
+                if (room.status != "WAITING") {
+                    spdlog::error("방 {}에 참가할 수 없습니다 - 상태가 {}입니다", roomId, room.status);
+                    return false;
+                }
+                if (room.players.count(userId)) {
+                    spdlog::error("사용자 {}는 이미 방 {}에 있습니다", userId, roomId);
+                    return false;
+                }
+                if (static_cast<int>(room.players.size()) >= room.max_players) {
+                    spdlog::error("방 {}이(가) 가득 찼습니다 ({}/{})", roomId, room.players.size(), room.max_players);
+                    return false;
+                }
+                if (!db_->users_.count(userId)) {
+                    spdlog::error("방에 플레이어 추가 오류: 존재하지 않는 사용자 {}", userId);
+                    return false;
+                }
+
+                room.players.insert(userId);
+                db_->rooms_by_user_[userId].insert(roomId);
+                spdlog::debug("사용자 {}이(가) 방 {}에 참가했습니다", userId, roomId);
+                return true;
+            }
+
+            bool removePlayer(int userId) override {
+                ScopedSpan span("RoomRepository.removePlayer");
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto joined = db_->rooms_by_user_.find(userId);
+                if (joined == db_->rooms_by_user_.end() || joined->second.empty()) {
+                    spdlog::warn("사용자 {}은(는) 어떤 방에도 없습니다", userId);
+                    return false;
+                }
+
+                // PostgreSQL 구현과 같이 첫 번째 방의 남은 인원으로 종료 여부를 판단하고, 참가 기록은 모두 삭제
+                int roomId = *joined->second.begin();
+                for (int joinedRoomId : joined->second) {
+                    db_->rooms_.at(joinedRoomId).players.erase(userId);
+                }
+                db_->rooms_by_user_.erase(joined);
+
+                auto& room = db_->rooms_.at(roomId);
+                std::size_t remaining = room.players.size();
+                if (remaining == 0) {
+                    room.status = "TERMINATED";
+                    for (auto& [gameId, game] : db_->games_) {
+                        if (game.room_id == roomId && game.status == "IN_PROGRESS") {
+                            game.status = "COMPLETED";
+                        }
+                    }
+                    spdlog::debug("방 {}이(가) 종료 처리되었습니다 (남은 플레이어 없음)", roomId);
+                }
+
+                spdlog::debug("사용자 {}이(가) 방 {}을(를) 나갔습니다, 남은 플레이어 {}명", userId, roomId, remaining);
+                return true;
+            }
+
+            int getPlayerCount(int roomId) override {
+                ScopedSpan span("RoomRepository.getPlayerCount");
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto it = db_->rooms_.find(roomId);
+                return it == db_->rooms_.end() ? 0 : static_cast<int>(it->second.players.size());
+            }
+
+            std::vector<int> getPlayersInRoom(int roomId) override {
+                ScopedSpan span("RoomRepository.getPlayersInRoom");
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto it = db_->rooms_.find(roomId);
+                if (it == db_->rooms_.end()) return {};
+                return std::vector<int>(it->second.players.begin(), it->second.players.end());
+            }
+
+        private:
+            std::shared_ptr<MemoryDatabase> db_;
+        };
+
+        class MemoryGameRepository : public GameRepository {
+        public:
+            explicit MemoryGameRepository(std::shared_ptr<MemoryDatabase> db)
+                : db_(std::move(db)) {
+            }
+
+            json createGame(const json& request) override {
+                ScopedSpan span("GameRepository.createGame");
+                json response = {
+                    {"gameId", -1},
+                    { "users", json::array() }
+                };
+                try {
+                    int roomId = request["roomId"];
+                    int mapId = request["mapId"];
+
+                    std::lock_guard<std::mutex> lock(db_->mutex_);
+                    // games.room_id, games.map_id 외래 키
+                    auto it = db_->rooms_.find(roomId);
+                    if (it == db_->rooms_.end() || mapId < 1 || mapId > kMapCount) {
+                        spdlog::error("방 번호 : {}에 대한 게임 세션을 생성할 수 없습니다", roomId);
+                        return response;
+                    }
+
+                    int gameId = db_->next_game_id_++;
+                    db_->games_[gameId] = MemoryDatabase::GameRow{ gameId, roomId, mapId };
+                    it->second.status = "GAME_IN_PROGRESS";
+
+                    response["gameId"] = gameId;
+                    for (int userId : it->second.players) {
+                        response["users"].push_back(userId);
+                    }
+                    spdlog::info("방 번호 : {}에 대한 게임 세션이 생성되었습니다 게임 ID: {}", roomId, gameId);
+                    return response;
+                }
+                catch (const std::exception& e) {
+                    spdlog::error("createGame 오류: {}", e.what());
+                    return response;
+                }
+            }
+
+            json endGame(int gameId) override {
+                ScopedSpan span("GameRepository.endGame");
+                json response = {
+                    {"gameId", -1},
+                    { "users", json::array()}
+                };
+                std::lock_guard<std::mutex> lock(db_->mutex_);
+                auto it = db_->games_.find(gameId);
+                if (it == db_->games_.end()) {
+                    spdlog::error("게임 ID: {}에 해당하는 방 ID를 찾을 수 없습니다", gameId);
+                    return response;
+                }
+
+                it->second.status = "COMPLETED";
+                int roomId = it->second.room_id;
+                response["gameId"] = gameId;
+                response["roomId"] = roomId;
+                for (int userId : db_->rooms_.at(roomId).players) {
+                    response["users"].push_back(userId);
+                }
+                spdlog::info("게임 ID: {}의 상태가 성공적으로 완료로 업데이트되었습니다", gameId);
+                return response;
+            }
+
+        private:
+            std::shared_ptr<MemoryDatabase> db_;
+        };
+
+    } // namespace
+
+    std::shared_ptr<MemoryDatabase> MemoryRepository::createDatabase(const RepositoryConfig& config) {
+        return std::make_shared<MemoryDatabase>(config);
+    }
+
+    std::unique_ptr<UserRepository> MemoryRepository::createUserRepository(std::shared_ptr<MemoryDatabase> database) {
+        return std::make_unique<MemoryUserRepository>(std::move(database));
+    }
+
+    std::unique_ptr<RoomRepository> MemoryRepository::createRoomRepository(std::shared_ptr<MemoryDatabase> database) {
+        return std::make_unique<MemoryRoomRepository>(std::move(database));
+    }
+
+    std::unique_ptr<GameRepository> MemoryRepository::createGameRepository(std::shared_ptr<MemoryDatabase> database) {
+        return std::make_unique<MemoryGameRepository>(std::move(database));
+    }
+
+} // namespace game_server
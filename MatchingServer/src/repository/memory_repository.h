@@ -0,0 +1,41 @@
+﻿// repository/memory_repository.h
+#pragma once
+#include "user_repository.h"
+#include "room_repository.h"
+#include "game_repository.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    // 리포지토리 저장소 선택 (config.json의 "repository" 섹션)
+    // backend가 "memory"면 PostgreSQL 없이 프로세스 메모리에 저장 (부하 테스트, 벤치마크, 프로파일링용)
+    struct RepositoryConfig {
+        std::string backend = "postgres";            // "postgres" 또는 "memory"
+        std::size_t memory_rooms = 10;               // db-init.sql과 같이 미리 만들어 둘 방 수
+        std::string room_ip_address = "127.0.0.1";   // 미리 만든 방의 게임 서버 주소
+        int room_base_port = 40000;                  // 방 i의 포트는 room_base_port + i
+
+        bool inMemory() const { return backend == "memory"; }
+
+        static RepositoryConfig fromJson(const nlohmann::json& config);
+    };
+
+    // users, rooms, room_users, games 테이블을 대신하는 메모리 저장소
+    // 세 리포지토리가 하나의 저장소를 공유하며, 각 메서드는 저장소 잠금을 쥔 채 끝까지 수행하므로
+    // PostgreSQL 구현의 트랜잭션 한 번과 같이 중간 상태가 다른 요청에 보이지 않고, 실패하면 아무것도 바뀌지 않는다.
+    class MemoryDatabase;
+
+    class MemoryRepository {
+    public:
+        // db-init.sql과 같이 미러 관리 계정(user_id 0)과 TERMINATED 상태의 방을 미리 넣은 저장소 생성
+        static std::shared_ptr<MemoryDatabase> createDatabase(const RepositoryConfig& config);
+
+        static std::unique_ptr<UserRepository> createUserRepository(std::shared_ptr<MemoryDatabase> database);
+        static std::unique_ptr<RoomRepository> createRoomRepository(std::shared_ptr<MemoryDatabase> database);
+        static std::unique_ptr<GameRepository> createGameRepository(std::shared_ptr<MemoryDatabase> database);
+    };
+
+} // namespace game_server
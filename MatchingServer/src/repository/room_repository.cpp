@@ -3,6 +3,8 @@
 // 방 관련 데이터베이스 작업을 처리하는 리포지토리
 #include "room_repository.h"
 #include "../util/db_pool.h"
+#include "../util/traced_sql.h"
+#include "../util/write_behind_queue.h"
 #include <pqxx/pqxx>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
@@ -14,21 +16,24 @@ namespace game_server {
     // 리포지토리 구현체
     class RoomRepositoryImpl : public RoomRepository {
     public:
-        explicit RoomRepositoryImpl(DbPool* dbPool) : dbPool_(dbPool) {}
+        RoomRepositoryImpl(DbPool* dbPool, WriteBehindQueue* writeBehind)
+            : dbPool_(dbPool), writeBehind_(writeBehind) {
+        }
 
         std::vector<json> findAllOpen() override {
+            ScopedSpan span("RoomRepository.findAllOpen");
             std::vector<json> rooms;
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             try {
                 // 열린 방 목록 조회 (최근 생성순)
-                pqxx::result result = txn.exec_params(
+                pqxx::result result = tracedExec(txn, "sql SELECT rooms",
                     "SELECT room_id, room_name, host_id, ip_address, port, "
                     "max_players, status, created_at "
                     "FROM rooms WHERE status = 'WAITING' OR status = 'GAME_IN_PROGRESS' "
                     "ORDER BY created_at DESC");
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
 
                 // 조회 결과를 Room 객체 리스트로 변환
@@ -55,6 +60,7 @@ namespace game_server {
         }
 
         json createRoomWithHost(int hostId, const std::string& roomName, int maxPlayers) {
+            ScopedSpan span("RoomRepository.createRoomWithHost");
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             int roomId = -1;
@@ -62,7 +68,7 @@ namespace game_server {
                 {"roomId", -1}
             };
             try {
-                pqxx::result isJoined = txn.exec_params(
+                pqxx::result isJoined = tracedExec(txn, "sql SELECT room_users",
                     "SELECT room_id FROM room_users WHERE user_id = $1 LIMIT 1"
                     , hostId);
                 if (!isJoined.empty()) {
@@ -72,7 +78,7 @@ namespace game_server {
                 }
 
                 // 유효한 방 ID 찾기
-                pqxx::result idResult = txn.exec(
+                pqxx::result idResult = tracedExec(txn, "sql SELECT rooms",
                     "SELECT room_id FROM rooms WHERE status = 'TERMINATED' ORDER BY room_id LIMIT 1 FOR UPDATE");
 
                 if (idResult.empty()) {
@@ -84,7 +90,7 @@ namespace game_server {
 
                 // 방 재활성화
                 pqxx::result roomResult;
-                roomResult = txn.exec_params(
+                roomResult = tracedExec(txn, "sql UPDATE rooms",
                     "UPDATE rooms SET room_name = $1, host_id = $2, max_players = $3, "
                     "status = 'WAITING', created_at = DEFAULT "
                     "WHERE room_id = $4 AND status = 'TERMINATED' "
@@ -98,11 +104,11 @@ namespace game_server {
                 }
 
                 // 사용자를 방에 추가
-                txn.exec_params(
+                tracedExec(txn, "sql INSERT room_users",
                     "INSERT INTO room_users(room_id, user_id) VALUES($1, $2)",
                     roomId, hostId);
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
                 result["roomId"] = roomResult[0]["room_id"].as<int>();
                 result["roomName"] = roomResult[0]["room_name"].as<std::string>();
@@ -120,11 +126,12 @@ namespace game_server {
         }
 
         bool addPlayer(int roomId, int userId) override {
+            ScopedSpan span("RoomRepository.addPlayer");
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             try {
                 // 방이 존재하고 WAITING 상태인지 확인
-                pqxx::result roomCheck = txn.exec_params(
+                pqxx::result roomCheck = tracedExec(txn, "sql SELECT rooms",
                     "SELECT status FROM rooms WHERE room_id = $1",
                     roomId);
 
@@ -144,7 +151,7 @@ namespace game_server {
                 }
 
                 // 이미 참가한 사용자인지 확인
-                pqxx::result checkResult = txn.exec_params(
+                pqxx::result checkResult = tracedExec(txn, "sql SELECT room_users",
                     "SELECT joined_at FROM room_users "
                     "WHERE room_id = $1 AND user_id = $2",
                     roomId, userId);
@@ -158,7 +165,7 @@ namespace game_server {
                 }
 
                 // 최대 인원 확인
-                pqxx::result maxPlayersResult = txn.exec_params(
+                pqxx::result maxPlayersResult = tracedExec(txn, "sql SELECT rooms FOR UPDATE",
                     "SELECT max_players, "
                     "(SELECT COUNT(*) FROM room_users WHERE room_id = $1) as current_players "
                     "FROM rooms WHERE room_id = $1 FOR UPDATE",
@@ -175,7 +182,7 @@ namespace game_server {
                 }
 
                 // 새 참가자 추가
-                pqxx::result result = txn.exec_params(
+                pqxx::result result = tracedExec(txn, "sql INSERT room_users",
                     "INSERT INTO room_users (room_id, user_id, joined_at) "
                     "VALUES ($1, $2, DEFAULT) RETURNING room_id",
                     roomId, userId);
@@ -186,7 +193,7 @@ namespace game_server {
                     return false;
                 }
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
                 spdlog::debug("사용자 {}이(가) 방 {}에 참가했습니다", userId, roomId);
                 return true;
@@ -200,11 +207,12 @@ namespace game_server {
         }
 
         bool removePlayer(int userId) override {
+            ScopedSpan span("RoomRepository.removePlayer");
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             try {
                 // 사용자가 속한 방 ID 가져오기
-                pqxx::result roomResult = txn.exec_params(
+                pqxx::result roomResult = tracedExec(txn, "sql SELECT room_users",
                     "SELECT room_id FROM room_users WHERE user_id = $1",
                     userId);
 
@@ -219,32 +227,56 @@ namespace game_server {
                 int room_id = roomResult[0][0].as<int>();
 
                 // 참가자 제거
-                txn.exec_params(
+                tracedExec(txn, "sql DELETE room_users",
                     "DELETE FROM room_users WHERE user_id = $1",
                     userId);
 
                 // 동일 트랜잭션 내에서 플레이어 수 확인
-                pqxx::result countResult = txn.exec_params(
+                pqxx::result countResult = tracedExec(txn, "sql SELECT room_users",
                     "SELECT COUNT(*) FROM room_users WHERE room_id = $1",
                     room_id);
 
                 int remaining_players = countResult[0][0].as<int>();
 
                 // 방에 남은 플레이어가 없으면 방 상태 TERMINATED로 변경
+                // (방 목록/참가 판단에 쓰이므로 즉시 반영하고, 진행 중 게임 완료 처리는 지연 반영)
+                // 종료된 방은 재사용되므로 방 ID가 아닌 지금 진행 중인 게임 ID로 완료 처리를 넘김
+                std::vector<int> gameIds;
                 if (remaining_players == 0) {
-                    txn.exec_params(
+                    tracedExec(txn, "sql UPDATE rooms",
                         "UPDATE rooms SET status = 'TERMINATED' WHERE room_id = $1",
                         room_id);
 
-                    txn.exec_params(
-                        "UPDATE games SET status = 'COMPLETED', completed_at = CURRENT_TIMESTAMP WHERE status = 'IN_PROGRESS' AND room_id = $1",
-                        room_id);
-
-                    spdlog::debug("방 {}이(가) 종료 처리되었습니다 (남은 플레이어 없음), 해당 방의 진행 중 게임들도 완료 처리: {}", room_id, room_id);
+                    if (writeBehind_) {
+                        pqxx::result gameResult = tracedExec(txn, "sql SELECT games",
+                            "SELECT game_id FROM games WHERE status = 'IN_PROGRESS' AND room_id = $1",
+                            room_id);
+                        for (const auto& row : gameResult) {
+                            gameIds.push_back(row[0].as<int>());
+                        }
+                    }
+                    else {
+                        tracedExec(txn, "sql UPDATE games",
+                            "UPDATE games SET status = 'COMPLETED', completed_at = CURRENT_TIMESTAMP WHERE status = 'IN_PROGRESS' AND room_id = $1",
+                            room_id);
+                    }
+
+                    spdlog::debug("방 {}이(가) 종료 처리되었습니다 (남은 플레이어 없음), 해당 방의 진행 중 게임들도 완료 처리", room_id);
                 }
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
+
+                // 커밋된 뒤에만 큐에 넣음 (롤백된 종료 처리로 게임이 완료되지 않도록)
+                std::vector<int> overflowIds;
+                for (int gameId : gameIds) {
+                    if (!writeBehind_->enqueue("completeGame", gameId)) {
+                        overflowIds.push_back(gameId);
+                    }
+                }
+                if (!overflowIds.empty()) {
+                    completeGames(overflowIds);
+                }
                 spdlog::debug("사용자 {}이(가) 방 {}을(를) 나갔습니다, 남은 플레이어 {}명",
                     userId, room_id, remaining_players);
                 return true;
@@ -258,15 +290,16 @@ namespace game_server {
         }
 
         int getPlayerCount(int roomId) override {
+            ScopedSpan span("RoomRepository.getPlayerCount");
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             try {
                 // 남은 플레이어 수 확인
-                pqxx::result result = txn.exec_params(
+                pqxx::result result = tracedExec(txn, "sql SELECT room_users",
                     "SELECT COUNT(*) FROM room_users WHERE room_id = $1",
                     roomId);
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
 
                 return result.empty() ? 0 : result[0][0].as<int>();
@@ -280,18 +313,19 @@ namespace game_server {
         }
 
         std::vector<int> getPlayersInRoom(int roomId) override {
+            ScopedSpan span("RoomRepository.getPlayersInRoom");
             std::vector<int> playerIds;
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
 
             try {
                 // 현재 방에 있는 참가자 ID 목록 조회
-                pqxx::result result = txn.exec_params(
+                pqxx::result result = tracedExec(txn, "sql SELECT room_users",
                     "SELECT user_id FROM room_users "
                     "WHERE room_id = $1",
                     roomId);
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
 
                 for (const auto& row : result) {
@@ -310,12 +344,36 @@ namespace game_server {
         }
 
     private:
+        // 지연 반영 큐가 받지 못한 게임(비활성화/상한 초과)을 직접 완료 처리
+        bool completeGames(const std::vector<int>& gameIds) {
+            ScopedSpan span("RoomRepository.completeGames");
+            auto conn = dbPool_->get_connection();
+            pqxx::work txn(*conn);
+            try {
+                tracedExec(txn, "sql UPDATE games",
+                    "UPDATE games SET status = 'COMPLETED', completed_at = CURRENT_TIMESTAMP "
+                    "WHERE game_id = ANY($1::int[]) AND status = 'IN_PROGRESS'",
+                    WriteBehindQueue::toArrayLiteral(gameIds));
+
+                tracedCommit(txn);
+                dbPool_->return_connection(conn);
+                return true;
+            }
+            catch (const std::exception& e) {
+                txn.abort();
+                dbPool_->return_connection(conn);
+                spdlog::error("completeGames 데이터베이스 오류: {}", e.what());
+                return false;
+            }
+        }
+
         DbPool* dbPool_;
+        WriteBehindQueue* writeBehind_;
     };
 
     // 팩토리 메서드 구현
-    std::unique_ptr<RoomRepository> RoomRepository::create(DbPool* dbPool) {
-        return std::make_unique<RoomRepositoryImpl>(dbPool);
+    std::unique_ptr<RoomRepository> RoomRepository::create(DbPool* dbPool, WriteBehindQueue* writeBehind) {
+        return std::make_unique<RoomRepositoryImpl>(dbPool, writeBehind);
     }
 
 } // namespace game_server
\ No newline at end of file
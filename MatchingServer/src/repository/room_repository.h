@@ -9,6 +9,7 @@
 namespace game_server {
 
     class DbPool;
+    class WriteBehindQueue;
 
     class RoomRepository {
     public:
@@ -21,7 +22,7 @@ namespace game_server {
         virtual int getPlayerCount(int roomId) = 0;
         virtual std::vector<int> getPlayersInRoom(int roomId) = 0;
 
-        static std::unique_ptr<RoomRepository> create(DbPool* dbPool);
+        static std::unique_ptr<RoomRepository> create(DbPool* dbPool, WriteBehindQueue* writeBehind = nullptr);
     };
 
 } // namespace game_server
@@ -3,8 +3,12 @@
 // 사용자 관련 데이터베이스 작업을 처리하는 리포지토리
 #include "user_repository.h"
 #include "../util/db_pool.h"
+#include "../util/traced_sql.h"
+#include "../util/write_behind_queue.h"
 #include <pqxx/pqxx>
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
 
 namespace game_server {
 
@@ -13,23 +17,31 @@ namespace game_server {
     // 리포지토리 구현체
     class UserRepositoryImpl : public UserRepository {
     public:
-        explicit UserRepositoryImpl(DbPool* dbPool) : dbPool_(dbPool) {}
+        UserRepositoryImpl(DbPool* dbPool, WriteBehindQueue* writeBehind)
+            : dbPool_(dbPool), writeBehind_(writeBehind) {
+            if (writeBehind_) {
+                writeBehind_->registerKind("lastLogin",
+                    [this](const std::vector<int>& userIds) { return updateLastLoginBatch(userIds); });
+            }
+        }
 
         //std::optional<json> findById(int userId) override {}
 
         json findByUsername(const std::string& userName) {
+            ScopedSpan span("UserRepository.findByUsername");
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             try {
-                pqxx::result result = txn.exec_params(
-                    "SELECT user_id, user_name, password_hash, nick_name, created_at, last_login FROM users WHERE LOWER(user_name) = LOWER($1)",
-                    userName);
+                // 정규화한 값으로 비교해야 idx_users_username_lower 인덱스를 사용함
+                pqxx::result result = tracedExec(txn, "sql SELECT users",
+                    "SELECT user_id, user_name, password_hash, nick_name, created_at, last_login FROM users WHERE LOWER(user_name) = $1",
+                    normalizeUserName(userName));
 
                 if (result.empty()) {
-                    // 사용자를 찾지 못함 - std::nullopt 반환
+                    // 사용자를 찾지 못함
                     txn.abort();
                     dbPool_->return_connection(conn);
-                    return { {"userId", -1} };
+                    return { {"userId", kUserNotFound} };
                 }
 
                 // 결과를 JSON으로 변환
@@ -41,7 +53,7 @@ namespace game_server {
                 user["createdAt"] = result[0]["created_at"].as<std::string>();
                 user["lastLogin"] = result[0]["last_login"].as<std::string>();
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
                 return user;
             }
@@ -49,21 +61,22 @@ namespace game_server {
                 txn.abort();
                 dbPool_->return_connection(conn);
                 spdlog::error("findByUsername 데이터베이스 오류: {}", e.what());
-                return { {"userId", -1} };
+                return { {"userId", kLookupFailed} };
             }
         }
 
         int create(const std::string& userName, const std::string& hashedPassword) override {
+            ScopedSpan span("UserRepository.create");
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             try {
                 // 새 사용자 생성
-                pqxx::result result = txn.exec_params(
+                pqxx::result result = tracedExec(txn, "sql INSERT users",
                     "INSERT INTO users (user_name, password_hash) "
                     "VALUES ($1, $2) RETURNING user_id",
                     userName, hashedPassword);
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
 
                 if (result.empty()) {
@@ -83,16 +96,22 @@ namespace game_server {
         }
 
         bool updateLastLogin(int userId) override {
+            ScopedSpan span("UserRepository.updateLastLogin");
+            // 로그인 응답에는 필요 없는 값이므로 지연 반영 큐에 넣고 바로 반환
+            if (writeBehind_ && writeBehind_->enqueue("lastLogin", userId)) {
+                return true;
+            }
+
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             try {
                 // 마지막 로그인 시간 업데이트
-                pqxx::result result = txn.exec_params(
+                pqxx::result result = tracedExec(txn, "sql UPDATE users",
                     "UPDATE users SET last_login = CURRENT_TIMESTAMP "
                     "WHERE user_id = $1 RETURNING user_id",
                     userId);
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
 
                 return !result.empty();
@@ -105,18 +124,43 @@ namespace game_server {
             }
         }
 
+        bool updateLastLoginBatch(const std::vector<int>& userIds) override {
+            ScopedSpan span("UserRepository.updateLastLoginBatch");
+            if (userIds.empty()) return true;
+
+            auto conn = dbPool_->get_connection();
+            pqxx::work txn(*conn);
+            try {
+                tracedExec(txn, "sql UPDATE users",
+                    "UPDATE users SET last_login = CURRENT_TIMESTAMP "
+                    "WHERE user_id = ANY($1::int[])",
+                    WriteBehindQueue::toArrayLiteral(userIds));
+
+                tracedCommit(txn);
+                dbPool_->return_connection(conn);
+                return true;
+            }
+            catch (const std::exception& e) {
+                txn.abort();
+                spdlog::error("마지막 로그인 일괄 업데이트 오류: {}", e.what());
+                dbPool_->return_connection(conn);
+                return false;
+            }
+        }
+
         bool updateUserNickName(int userId, const std::string& nickName) override {
+            ScopedSpan span("UserRepository.updateUserNickName");
             auto conn = dbPool_->get_connection();
             pqxx::work txn(*conn);
             try {
                 // 닉네임 업데이트
-                pqxx::result result = txn.exec_params(
+                pqxx::result result = tracedExec(txn, "sql UPDATE users",
                     "UPDATE users SET nick_name = $2 "
                     "WHERE user_id = $1 "
                     "RETURNING user_id",
                     userId, nickName);
 
-                txn.commit();
+                tracedCommit(txn);
                 dbPool_->return_connection(conn);
 
                 return !result.empty();
@@ -129,13 +173,47 @@ namespace game_server {
             }
         }
 
+        bool updatePasswordHash(int userId, const std::string& hashedPassword) override {
+            ScopedSpan span("UserRepository.updatePasswordHash");
+            auto conn = dbPool_->get_connection();
+            pqxx::work txn(*conn);
+            try {
+                // 비밀번호 해시 교체 (이전 형식 해시를 로그인 시 새 형식으로 전환)
+                pqxx::result result = tracedExec(txn, "sql UPDATE users",
+                    "UPDATE users SET password_hash = $2 "
+                    "WHERE user_id = $1 "
+                    "RETURNING user_id",
+                    userId, hashedPassword);
+
+                tracedCommit(txn);
+                dbPool_->return_connection(conn);
+
+                return !result.empty();
+            }
+            catch (const std::exception& e) {
+                txn.abort();
+                spdlog::error("비밀번호 해시 업데이트 오류: {}", e.what());
+                dbPool_->return_connection(conn);
+                return false;
+            }
+        }
+
     private:
         DbPool* dbPool_;
+        WriteBehindQueue* writeBehind_;
     };
 
+    // 아이디는 ASCII만 허용하므로 PostgreSQL의 LOWER()와 같은 결과
+    std::string UserRepository::normalizeUserName(const std::string& userName) {
+        std::string key = userName;
+        std::transform(key.begin(), key.end(), key.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return key;
+    }
+
     // 팩토리 메서드 구현
-    std::unique_ptr<UserRepository> UserRepository::create(DbPool* dbPool) {
-        return std::make_unique<UserRepositoryImpl>(dbPool);
+    std::unique_ptr<UserRepository> UserRepository::create(DbPool* dbPool, WriteBehindQueue* writeBehind) {
+        return std::make_unique<UserRepositoryImpl>(dbPool, writeBehind);
     }
 
 } // namespace game_server
\ No newline at end of file
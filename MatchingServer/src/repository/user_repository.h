@@ -9,18 +9,30 @@
 namespace game_server {
 
     class DbPool;
+    class WriteBehindQueue;
 
     class UserRepository {
     public:
         virtual ~UserRepository() = default;
 
+        // findByUsername 결과의 userId 값 (찾은 경우는 양수)
+        static constexpr int kUserNotFound = -1;
+        static constexpr int kLookupFailed = -2;   // DB 오류, 사용자가 없다는 뜻이 아니므로 캐시하지 않음
+
         //virtual std::optional<nlohmann::json> findById(int userId) = 0;
         virtual nlohmann::json findByUsername(const std::string& username) = 0;
         virtual int create(const std::string& username, const std::string& hashedPassword) = 0;
         virtual bool updateLastLogin(int userId) = 0;
+        // 여러 사용자의 마지막 로그인 시간을 하나의 UPDATE로 갱신
+        virtual bool updateLastLoginBatch(const std::vector<int>& userIds) = 0;
         virtual bool updateUserNickName(int userId, const std::string& nickName) = 0;
+        virtual bool updatePasswordHash(int userId, const std::string& hashedPassword) = 0;
+
+        // 아이디 조회 키 (idx_users_username_lower 인덱스의 LOWER(user_name)과 같은 값)
+        static std::string normalizeUserName(const std::string& userName);
 
-        static std::unique_ptr<UserRepository> create(DbPool* dbPool);
+        // writeBehind가 주어지면 last_login 갱신을 지연 반영 큐로 모아서 처리
+        static std::unique_ptr<UserRepository> create(DbPool* dbPool, WriteBehindQueue* writeBehind = nullptr);
     };
 
 } // namespace game_server
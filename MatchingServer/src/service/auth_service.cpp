@@ -3,85 +3,15 @@
 // 사용자 등록 및 로그인 비즈니스 로직을 처리
 #include "auth_service.h"
 #include "../util/password_util.h"
+#include "../util/tracing.h"
+#include "../util/validation.h"
 #include "../repository/user_repository.h"
 #include <spdlog/spdlog.h>
-#include <regex>
 
 namespace game_server {
 
     using json = nlohmann::json;
 
-    namespace {
-        // 사용자 이름 유효성 검증 함수
-        bool isValidUserName(const std::string& name) {
-            // 빈 이름은 유효하지 않음
-            if (name.empty()) {
-                return false;
-            }
-
-            // 30바이트 이내인지 확인
-            if (name.size() > 30) {
-                return false;
-            }
-
-            // "mirror" 단어가 포함되어 있는지 확인 (대소문자 구분 없이)
-            if (name.find("mirror") != std::string::npos) {
-                return false;
-            }
-
-            // 이메일 형식인지 확인
-            bool isEmail = (name.find('@') != std::string::npos) &&
-                (name.find('.', name.find('@')) != std::string::npos);
-
-            // 이메일이 아닌 경우 영어, 한글, 숫자, @ 문자만 포함하는지 확인
-            if (!isEmail) {
-                for (unsigned char c : name) {
-                    // ASCII 영어와 숫자 확인
-                    if ((c >= 'A' && c <= 'Z') ||
-                        (c >= 'a' && c <= 'z') ||
-                        (c >= '0' && c <= '9')) {
-                        continue;
-                    }
-
-                    // 허용되지 않는 문자
-                    return false;
-                }
-            }
-            else {
-                // 이메일인 경우 추가 검증 (간단한 이메일 형식 검사)
-                // 여기서는 표준적인 이메일 문자들(영어, 숫자, 일부 특수문자) 허용
-                for (unsigned char c : name) {
-                    if ((c >= 'A' && c <= 'Z') ||
-                        (c >= 'a' && c <= 'z') ||
-                        (c >= '0' && c <= '9') ||
-                        (c == '@') || (c == '.') ||
-                        (c == '_') || (c == '-') || (c == '+')) {
-                        continue;
-                    }
-
-                    // 이메일에 한글은 허용하지 않음 (IDN 이메일 제외)
-                    return false;
-                }
-            }
-
-            return true;
-        }
-
-        bool isValidNickName(const std::string& str) {
-            // 정규식 패턴: 한글(가-힣), 영어(A-Za-z), 숫자(0-9)만 허용
-            if (str.size() > 24) return false;
-
-            try {
-                std::regex pattern("^[가-힣A-Za-z0-9]+$");
-                return std::regex_match(str, pattern);
-            }
-            catch (const std::regex_error& e) {
-                spdlog::error("닉네임 {}에 대한 검증 시 정규식 오류 발생 : {}",str,  e.what());
-                return false;
-            }
-        }
-    }
-
     // 서비스 구현체
     class AuthServiceImpl : public AuthService {
     public:
@@ -90,6 +20,7 @@ namespace game_server {
         }
 
         json registerUser(const json& request) override {
+            ScopedSpan span("AuthService.registerUser");
             json response;
 
             // 사용자명 유효성 검증
@@ -114,7 +45,12 @@ namespace game_server {
 
             // 사용자명 중복 확인
             const json& userInfo = userRepo_->findByUsername(request["userName"]);
-            if (userInfo["userId"] != -1) {
+            if (userInfo["userId"] == UserRepository::kLookupFailed) {
+                response["status"] = "error";
+                response["message"] = "사용자 정보를 확인하지 못했습니다. 잠시 후 다시 시도해주세요.";
+                return response;
+            }
+            if (userInfo["userId"] != UserRepository::kUserNotFound) {
                 response["status"] = "error";
                 response["message"] = "이미 존재하는 아이디입니다.";
                 return response;
@@ -122,6 +58,11 @@ namespace game_server {
 
             // PasswordUtil을 사용하여 비밀번호 해싱
             std::string hashedPassword = PasswordUtil::hashPassword(request["password"]);
+            if (hashedPassword.empty()) {
+                response["status"] = "error";
+                response["message"] = "회원가입에 실패하였습니다.";
+                return response;
+            }
 
             // 새 사용자 생성
             int userId = userRepo_->create(request["userName"], hashedPassword);
@@ -143,6 +84,7 @@ namespace game_server {
         }
 
         json loginUser(const json& request) override {
+            ScopedSpan span("AuthService.loginUser");
             json response;
 
             // 사용자명 유효성 검증
@@ -154,7 +96,12 @@ namespace game_server {
 
             // 사용자 찾기
             const json& userInfo = userRepo_->findByUsername(request["userName"]);
-            if (userInfo["userId"] == -1) {
+            if (userInfo["userId"] == UserRepository::kLookupFailed) {
+                response["status"] = "error";
+                response["message"] = "사용자 정보를 확인하지 못했습니다. 잠시 후 다시 시도해주세요.";
+                return response;
+            }
+            if (userInfo["userId"] == UserRepository::kUserNotFound) {
                 response["status"] = "error";
                 response["message"] = "존재하지 않는 사용자입니다.";
                 return response;
@@ -167,6 +114,14 @@ namespace game_server {
                 return response;
             }
 
+            // 이전 형식(SHA-256) 또는 낮은 비용의 해시는 검증에 성공한 평문으로 다시 해시하여 저장
+            if (PasswordUtil::needsRehash(userInfo["passwordHash"])) {
+                std::string rehashed = PasswordUtil::hashPassword(request["password"]);
+                if (!rehashed.empty() && userRepo_->updatePasswordHash(userInfo["userId"], rehashed)) {
+                    spdlog::info("유저 ID : {}의 비밀번호 해시를 새 형식으로 전환하였습니다", userInfo["userId"].get<int>());
+                }
+            }
+
             // 로그인 시간 업데이트
             userRepo_->updateLastLogin(userInfo["userId"]);
 
@@ -183,6 +138,7 @@ namespace game_server {
         }
 
         json registerCheckAndLogin(const nlohmann::json& request) {
+            ScopedSpan span("AuthService.registerCheckAndLogin");
             json response;
 
             // 사용자명 유효성 검증
@@ -194,25 +150,36 @@ namespace game_server {
 
             // 사용자 찾기
             json userInfo = userRepo_->findByUsername(request["userName"]);
-            int userId = -1;
-            if (userInfo["userId"] == -1) {
+            // 조회 실패를 없는 사용자로 보고 이미 있는 계정을 다시 만들지 않도록 먼저 확인
+            if (userInfo["userId"] == UserRepository::kLookupFailed) {
+                response["status"] = "error";
+                response["message"] = "사용자 정보를 확인하지 못했습니다. 잠시 후 다시 시도해주세요.";
+                return response;
+            }
+            if (userInfo["userId"] == UserRepository::kUserNotFound) {
                 // PasswordUtil을 사용하여 비밀번호 해싱
                 std::string hashedPassword = PasswordUtil::hashPassword(request["password"]);
 
                 // 새 사용자 생성
-                userId = userRepo_->create(request["userName"], hashedPassword);
+                int userId = userRepo_->create(request["userName"], hashedPassword);
                 if (userId < 0) {
                     response["status"] = "error";
                     response["message"] = "사용재 생성에 실패하였습니다.";
                     spdlog::error("새로운 사용자를 생성하는 도중 에러가 발생하였습니다.");
                     return response;
                 }
+
+                // 기본 닉네임 등 DB에서 채워지는 값을 읽기 위해 새 사용자만 다시 조회
+                userInfo = userRepo_->findByUsername(request["userName"]);
+                if (userInfo["userId"].get<int>() <= 0) {
+                    response["status"] = "error";
+                    response["message"] = "사용자 정보를 확인하지 못했습니다. 잠시 후 다시 시도해주세요.";
+                    return response;
+                }
             }
 
-            userInfo = userRepo_->findByUsername(request["userName"]);
-            
             // 로그인 시간 업데이트
-            userRepo_->updateLastLogin(userId);
+            userRepo_->updateLastLogin(userInfo["userId"]);
 
             // 성공 응답 생성
             response["action"] = "login";
@@ -227,6 +194,7 @@ namespace game_server {
         }
 
         json updateNickName(const nlohmann::json& request) {
+            ScopedSpan span("AuthService.updateNickName");
             json response;
 
             // 사용자명 유효성 검증
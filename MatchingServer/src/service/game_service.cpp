@@ -1,5 +1,6 @@
 ﻿#include "game_service.h"
 #include "../repository/game_repository.h"
+#include "../util/tracing.h"
 #include <spdlog/spdlog.h>
 #include <random>
 #include <string>
@@ -17,6 +18,7 @@ namespace game_server {
         }
 
         json startGame(json& request) {
+            ScopedSpan span("GameService.startGame");
             json response;
             try {
                 // 요청 유효성 검증
@@ -56,6 +58,7 @@ namespace game_server {
         }
 
         json endGame(json& request) {
+            ScopedSpan span("GameService.endGame");
             json response;
             try {
                 // 요청 유효성 검증
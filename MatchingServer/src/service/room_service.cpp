@@ -1,5 +1,7 @@
 ﻿#include "room_service.h"
 #include "../repository/room_repository.h"
+#include "../util/tracing.h"
+#include "../util/validation.h"
 #include <spdlog/spdlog.h>
 #include <random>
 #include <string>
@@ -9,51 +11,6 @@ namespace game_server {
 
     using json = nlohmann::json;
 
-    namespace {
-        // 방 이름 유효성 검증 함수
-        bool isValidRoomName(const std::string& name) {
-            // 빈 이름은 유효하지 않음
-            if (name.empty()) {
-                return false;
-            }
-
-            // 40바이트(UTF-8 표준) 이내인지 확인
-            if (name.size() > 40) {
-                return false;
-            }
-
-            // 영어, 한글, 숫자만 포함하는지 확인
-            int len = name.size();
-            for (int i = 0; i < len; ++i) {
-                // ASCII 영어와 숫자 확인
-                const char& c = name[i];
-                if (i == len - 1 && c == '$') continue;
-                if ((c >= 'A' && c <= 'Z') ||
-                    (c >= 'a' && c <= 'z') ||
-                    (c >= '0' && c <= '9') ||
-                    (c == ' ')) {
-                    continue;
-                }
-
-                // UTF-8 한글 범위 확인 (첫 바이트가 0xEA~0xED 범위)
-                if ((c & 0xF0) == 0xE0) {
-                    // 한글 문자의 첫 바이트 가능성, 좀 더 정확한 확인 필요
-                    continue;
-                }
-
-                // 한글 문자의 연속 바이트 (0x80~0xBF 범위)
-                if ((c & 0xC0) == 0x80) {
-                    continue;
-                }
-
-                // 허용되지 않는 문자
-                return false;
-            }
-
-            return true;
-        }
-    }
-
     // 서비스 구현체
     class RoomServiceImpl : public RoomService {
     public:
@@ -62,6 +19,7 @@ namespace game_server {
         }
 
         json createRoom(json& request) override {
+            ScopedSpan span("RoomService.createRoom");
             json response;
 
             try {
@@ -116,6 +74,7 @@ namespace game_server {
         }
 
         json joinRoom(json& request) override {
+            ScopedSpan span("RoomService.joinRoom");
             json response;
 
             try {
@@ -154,6 +113,7 @@ namespace game_server {
         }
 
         json exitRoom(json& request) override {
+            ScopedSpan span("RoomService.exitRoom");
             json response;
 
             try {
@@ -190,6 +150,7 @@ namespace game_server {
         }
 
         json listRooms() override {
+            ScopedSpan span("RoomService.listRooms");
             json response;
 
             try {
@@ -0,0 +1,120 @@
+﻿// util/buffer_pool.cpp
+// 수신 버퍼 슬랩 풀 구현 파일
+// 크기 클래스별로 슬랩 단위로 할당한 블록을 빈 목록으로 재사용
+#include "buffer_pool.h"
+
+namespace game_server {
+
+    BufferPool::Buffer::Buffer(BufferPool* pool, std::size_t size_class, char* data, std::size_t size)
+        : pool_(pool),
+        size_class_(size_class),
+        data_(data),
+        size_(size)
+    {
+    }
+
+    BufferPool::Buffer::Buffer(Buffer&& other) noexcept
+        : pool_(other.pool_),
+        size_class_(other.size_class_),
+        data_(other.data_),
+        size_(other.size_)
+    {
+        other.pool_ = nullptr;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    BufferPool::Buffer& BufferPool::Buffer::operator=(Buffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            pool_ = other.pool_;
+            size_class_ = other.size_class_;
+            data_ = other.data_;
+            size_ = other.size_;
+            other.pool_ = nullptr;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    BufferPool::Buffer::~Buffer() {
+        release();
+    }
+
+    void BufferPool::Buffer::release() {
+        if (pool_ && data_) {
+            pool_->release(size_class_, data_);
+        }
+        pool_ = nullptr;
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    BufferPool::Buffer BufferPool::acquire(std::size_t size_hint) {
+        std::size_t size_class = 0;
+        while (size_class + 1 < kBlockSizes.size() && kBlockSizes[size_class] < size_hint) {
+            ++size_class;
+        }
+        std::size_t block_size = kBlockSizes[size_class];
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        SizeClass& cls = classes_[size_class];
+        if (cls.free_blocks.empty()) {
+            // 빈 블록이 없으면 슬랩 하나를 새로 잘라서 추가
+            cls.slabs.emplace_back(new char[block_size * kBlocksPerSlab]);
+            char* slab = cls.slabs.back().get();
+            for (std::size_t i = kBlocksPerSlab; i > 0; --i) {
+                cls.free_blocks.push_back(slab + (i - 1) * block_size);
+            }
+        }
+
+        char* data = cls.free_blocks.back();
+        cls.free_blocks.pop_back();
+        cls.in_use++;
+        cls.acquired++;
+        return Buffer(this, size_class, data, block_size);
+    }
+
+    void BufferPool::release(std::size_t size_class, char* data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SizeClass& cls = classes_[size_class];
+        cls.free_blocks.push_back(data);
+        cls.in_use--;
+    }
+
+    std::size_t BufferPool::reservedBytes() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < classes_.size(); ++i) {
+            total += classes_[i].slabs.size() * kBlocksPerSlab * kBlockSizes[i];
+        }
+        return total;
+    }
+
+    std::size_t BufferPool::inUseBytes() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < classes_.size(); ++i) {
+            total += classes_[i].in_use * kBlockSizes[i];
+        }
+        return total;
+    }
+
+    nlohmann::json BufferPool::stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        nlohmann::json result = nlohmann::json::array();
+        for (std::size_t i = 0; i < classes_.size(); ++i) {
+            const SizeClass& cls = classes_[i];
+            result.push_back({
+                {"blockSize", kBlockSizes[i]},
+                {"slabs", cls.slabs.size()},
+                {"inUse", cls.in_use},
+                {"free", cls.free_blocks.size()},
+                {"acquired", cls.acquired}
+            });
+        }
+        return result;
+    }
+
+} // namespace game_server
@@ -0,0 +1,73 @@
+﻿// util/buffer_pool.h
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    // 수신 버퍼 슬랩 풀
+    // 세션은 버퍼를 소유하지 않고, 읽을 데이터가 도착했을 때만 크기에 맞는 블록을 빌려 읽은 뒤 바로 반납한다.
+    // 유휴 연결은 버퍼 메모리를 차지하지 않으며, 풀의 크기는 동시에 처리 중인 읽기 수만큼만 늘어난다.
+    class BufferPool {
+    public:
+        // 반납을 보장하는 이동 전용 핸들
+        class Buffer {
+        public:
+            Buffer() = default;
+            Buffer(Buffer&& other) noexcept;
+            Buffer& operator=(Buffer&& other) noexcept;
+            Buffer(const Buffer&) = delete;
+            Buffer& operator=(const Buffer&) = delete;
+            ~Buffer();
+
+            char* data() const { return data_; }
+            std::size_t size() const { return size_; }
+
+        private:
+            friend class BufferPool;
+            Buffer(BufferPool* pool, std::size_t size_class, char* data, std::size_t size);
+            void release();
+
+            BufferPool* pool_ = nullptr;
+            std::size_t size_class_ = 0;
+            char* data_ = nullptr;
+            std::size_t size_ = 0;
+        };
+
+        // 크기 클래스 (작은 요청 대부분은 1KB, 큰 메시지는 기존 수신 버퍼 크기인 8KB)
+        static constexpr std::array<std::size_t, 2> kBlockSizes = { 1024, 8192 };
+        // 슬랩 하나에 담는 블록 수
+        static constexpr std::size_t kBlocksPerSlab = 32;
+
+        BufferPool() = default;
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        // size_hint 이상인 가장 작은 클래스의 블록 (최대 클래스보다 크면 최대 클래스)
+        Buffer acquire(std::size_t size_hint);
+
+        // 슬랩으로 확보한 바이트와 현재 빌려준 바이트
+        std::size_t reservedBytes();
+        std::size_t inUseBytes();
+        nlohmann::json stats();
+
+    private:
+        struct SizeClass {
+            std::vector<char*> free_blocks;
+            std::vector<std::unique_ptr<char[]>> slabs;
+            std::size_t in_use = 0;
+            std::uint64_t acquired = 0;
+        };
+
+        void release(std::size_t size_class, char* data);
+
+        std::mutex mutex_;
+        std::array<SizeClass, kBlockSizes.size()> classes_;
+    };
+
+} // namespace game_server
@@ -0,0 +1,34 @@
+﻿// util/config_loader.cpp
+// 설정 파일 로더 구현 파일
+// src/config/config.json 형식의 설정을 읽어 각 모듈에 전달
+#include "config_loader.h"
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    json ConfigLoader::load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            spdlog::warn("설정 파일 {}을 찾을 수 없어 기본값을 사용합니다", path);
+            return json::object();
+        }
+
+        try {
+            json config = json::parse(file);
+            if (!config.is_object()) {
+                spdlog::warn("설정 파일 {}의 형식이 올바르지 않아 기본값을 사용합니다", path);
+                return json::object();
+            }
+            spdlog::info("설정 파일 {} 불러오기 완료", path);
+            return config;
+        }
+        catch (const std::exception& e) {
+            spdlog::error("설정 파일 {} 파싱 중 오류가 발생하여 기본값을 사용합니다: {}", path, e.what());
+            return json::object();
+        }
+    }
+
+} // namespace game_server
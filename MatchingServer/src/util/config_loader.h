@@ -0,0 +1,14 @@
+﻿// util/config_loader.h
+#pragma once
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    class ConfigLoader {
+    public:
+        // 설정 파일(JSON)을 읽어 반환, 파일이 없거나 잘못된 경우 빈 객체 반환
+        static nlohmann::json load(const std::string& path);
+    };
+
+} // namespace game_server
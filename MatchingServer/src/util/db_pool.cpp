@@ -1,4 +1,6 @@
 ﻿#include "db_pool.h"
+#include "metrics.h"
+#include "tracing.h"
 
 // 표준 라이브러리 헤더 포함
 #include <memory>
@@ -15,6 +17,23 @@
 
 namespace game_server {
 
+    namespace {
+        struct PoolMetrics {
+            Metrics::Histogram wait;
+            Metrics::Histogram hold;
+        };
+
+        const PoolMetrics& poolMetrics() {
+            static const PoolMetrics metrics = {
+                Metrics::instance().histogram("matching_db_pool_wait_seconds", "DB 연결을 얻기까지 걸린 시간 (재연결/추가 생성 포함)",
+                    Metrics::latencyBuckets(), 1e-6),
+                Metrics::instance().histogram("matching_db_pool_hold_seconds", "DB 연결을 빌린 뒤 반환하기까지의 시간",
+                    Metrics::latencyBuckets(), 1e-6)
+            };
+            return metrics;
+        }
+    }
+
     DbPool::DbPool(const std::string& connectionString, int poolSize)
         : connection_string_(connectionString)
     {
@@ -22,12 +41,14 @@ namespace game_server {
             // 연결 풀 초기화
             connections_.reserve(poolSize);
             in_use_.reserve(poolSize);
+            acquired_at_.reserve(poolSize);
 
             for (int i = 0; i < poolSize; ++i) {
                 // 새 연결 생성 및 풀에 추가
                 auto conn = std::make_shared<pqxx::connection>(connectionString);
                 connections_.push_back(conn);
                 in_use_.push_back(false);
+                acquired_at_.push_back(std::chrono::steady_clock::time_point());
 
                 spdlog::info("데이터베이스 연결 생성 {}/{}", i + 1, poolSize);
             }
@@ -49,6 +70,8 @@ namespace game_server {
 
     std::shared_ptr<pqxx::connection> DbPool::get_connection()
     {
+        ScopedSpan span("db.acquire");
+        auto started = std::chrono::steady_clock::now();
         std::lock_guard<std::mutex> lock(mutex_);
 
         // 사용 가능한 연결 찾기
@@ -69,6 +92,8 @@ namespace game_server {
                     }
                 }
 
+                acquired_at_[i] = std::chrono::steady_clock::now();
+                poolMetrics().wait.observeSince(started);
                 return connections_[i];
             }
         }
@@ -79,6 +104,8 @@ namespace game_server {
             auto conn = std::make_shared<pqxx::connection>(connection_string_);
             connections_.push_back(conn);
             in_use_.push_back(true);
+            acquired_at_.push_back(std::chrono::steady_clock::now());
+            poolMetrics().wait.observeSince(started);
             return conn;
         }
         catch (const std::exception& e) {
@@ -95,6 +122,7 @@ namespace game_server {
         for (size_t i = 0; i < connections_.size(); ++i) {
             if (connections_[i] == conn) {
                 in_use_[i] = false;
+                poolMetrics().hold.observeSince(acquired_at_[i]);
                 return;
             }
         }
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <mutex>
@@ -27,6 +28,7 @@ namespace game_server {
         std::string connection_string_;
         std::vector<std::shared_ptr<pqxx::connection>> connections_;
         std::vector<bool> in_use_;
+        std::vector<std::chrono::steady_clock::time_point> acquired_at_;  // 점유 시간 측정용
         std::mutex mutex_;
     };
 
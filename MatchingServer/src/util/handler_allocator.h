@@ -0,0 +1,109 @@
+﻿// util/handler_allocator.h
+#pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace game_server {
+
+    // 비동기 작업 핸들러 상태를 담는 세션별 고정 메모리
+    // 읽기 대기, 쓰기처럼 한 번에 하나만 진행되는 작업마다 하나씩 두면 매 메시지의 핸들러 할당이 힙을 거치지 않는다.
+    // (Boost 1.74에는 recycling_allocator가 없어 Asio 예제의 custom allocation 방식 사용)
+    class HandlerMemory {
+    public:
+        // 세션 핸들러(this, shared_ptr 캡처)를 감싼 Asio 작업 객체가 들어가는 크기
+        static constexpr std::size_t kCapacity = 256;
+
+        HandlerMemory() = default;
+        HandlerMemory(const HandlerMemory&) = delete;
+        HandlerMemory& operator=(const HandlerMemory&) = delete;
+
+        void* allocate(std::size_t size) {
+            if (!in_use_ && size <= kCapacity) {
+                in_use_ = true;
+                return &storage_;
+            }
+            // 이미 사용 중이거나 크기를 넘으면 일반 할당
+            return ::operator new(size);
+        }
+
+        void deallocate(void* pointer) {
+            if (pointer == &storage_) {
+                in_use_ = false;
+            }
+            else {
+                ::operator delete(pointer);
+            }
+        }
+
+    private:
+        alignas(std::max_align_t) unsigned char storage_[kCapacity];
+        bool in_use_ = false;
+    };
+
+    template <class T>
+    class HandlerAllocator {
+    public:
+        using value_type = T;
+
+        explicit HandlerAllocator(HandlerMemory& memory) noexcept
+            : memory_(&memory)
+        {
+        }
+
+        template <class U>
+        HandlerAllocator(const HandlerAllocator<U>& other) noexcept
+            : memory_(other.memory_)
+        {
+        }
+
+        T* allocate(std::size_t n) const {
+            return static_cast<T*>(memory_->allocate(sizeof(T) * n));
+        }
+
+        void deallocate(T* pointer, std::size_t /*n*/) const {
+            memory_->deallocate(pointer);
+        }
+
+        template <class U>
+        bool operator==(const HandlerAllocator<U>& other) const noexcept { return memory_ == other.memory_; }
+        template <class U>
+        bool operator!=(const HandlerAllocator<U>& other) const noexcept { return memory_ != other.memory_; }
+
+    private:
+        template <class> friend class HandlerAllocator;
+        HandlerMemory* memory_;
+    };
+
+    // associated_allocator로 HandlerMemory를 사용하도록 핸들러를 감쌈
+    template <class Handler>
+    class CustomAllocHandler {
+    public:
+        using allocator_type = HandlerAllocator<Handler>;
+
+        CustomAllocHandler(HandlerMemory& memory, Handler handler)
+            : memory_(memory),
+            handler_(std::move(handler))
+        {
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(memory_);
+        }
+
+        template <class... Args>
+        void operator()(Args&&... args) {
+            handler_(std::forward<Args>(args)...);
+        }
+
+    private:
+        HandlerMemory& memory_;
+        Handler handler_;
+    };
+
+    template <class Handler>
+    inline CustomAllocHandler<Handler> makeCustomAllocHandler(HandlerMemory& memory, Handler handler) {
+        return CustomAllocHandler<Handler>(memory, std::move(handler));
+    }
+
+} // namespace game_server
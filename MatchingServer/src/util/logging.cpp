@@ -0,0 +1,174 @@
+﻿// util/logging.cpp
+// 로거 초기화 및 구조화(JSON) 로그 포맷 구현 파일
+#include "logging.h"
+#include <cstdio>
+#include <cstring>
+#include <spdlog/async.h>
+#include <spdlog/formatter.h>
+#include <spdlog/details/os.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/sinks/stdout_sinks.h>
+
+namespace game_server {
+
+    namespace {
+
+        // JSON 형식일 때 logWith가 session/user/msg 필드를 직접 만들어 넘김
+        std::atomic<bool> g_json_format{ false };
+        // 필드가 이미 만들어진 메시지 표시 (주소로 비교하며, 비동기 큐에도 source_loc은 그대로 복사됨)
+        constexpr char kStructuredPayload[] = "logWith";
+
+        void appendEscaped(spdlog::memory_buf_t& dest, const char* data, std::size_t size) {
+            static constexpr char kHex[] = "0123456789abcdef";
+            for (std::size_t i = 0; i < size; ++i) {
+                unsigned char c = static_cast<unsigned char>(data[i]);
+                switch (c) {
+                case '"': dest.append(std::string_view("\\\"")); break;
+                case '\\': dest.append(std::string_view("\\\\")); break;
+                case '\n': dest.append(std::string_view("\\n")); break;
+                case '\r': dest.append(std::string_view("\\r")); break;
+                case '\t': dest.append(std::string_view("\\t")); break;
+                default:
+                    if (c < 0x20) {
+                        char escaped[6] = { '\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0x0F] };
+                        dest.append(escaped, escaped + sizeof(escaped));
+                    }
+                    else {
+                        dest.push_back(static_cast<char>(c));
+                    }
+                }
+            }
+        }
+
+        // 한 줄에 JSON 객체 하나씩 출력하는 포맷터 (로그 수집기에서 바로 파싱 가능)
+        class JsonFormatter : public spdlog::formatter {
+        public:
+            void format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& dest) override {
+                using namespace std::chrono;
+                auto since_epoch = msg.time.time_since_epoch();
+                std::time_t seconds = static_cast<std::time_t>(duration_cast<std::chrono::seconds>(since_epoch).count());
+                int millis = static_cast<int>(duration_cast<milliseconds>(since_epoch).count() % 1000);
+                std::tm tm = spdlog::details::os::gmtime(seconds);
+
+                char time_buf[32];
+                int time_len = std::snprintf(time_buf, sizeof(time_buf), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                    tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, millis);
+
+                dest.append(std::string_view("{\"time\":\""));
+                dest.append(time_buf, time_buf + time_len);
+                dest.append(std::string_view("\",\"level\":\""));
+                auto level = spdlog::level::to_string_view(msg.level);
+                dest.append(level.data(), level.data() + level.size());
+                dest.append(std::string_view("\",\"thread\":"));
+                fmt::format_to(std::back_inserter(dest), "{}", msg.thread_id);
+
+                if (msg.source.filename == kStructuredPayload) {
+                    // logWith가 이스케이프까지 마친 "session":N,"user":M,"msg":"..." 필드
+                    dest.push_back(',');
+                    dest.append(msg.payload.data(), msg.payload.data() + msg.payload.size());
+                }
+                else {
+                    dest.append(std::string_view(",\"msg\":\""));
+                    appendEscaped(dest, msg.payload.data(), msg.payload.size());
+                    dest.push_back('"');
+                }
+                dest.push_back('}');
+                dest.append(std::string_view(spdlog::details::os::default_eol));
+            }
+
+            std::unique_ptr<spdlog::formatter> clone() const override {
+                return std::make_unique<JsonFormatter>();
+            }
+        };
+
+        std::int64_t steadyMillis() {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+    } // namespace
+
+    LoggingConfig LoggingConfig::fromJson(const nlohmann::json& config) {
+        LoggingConfig result;
+        if (!config.is_object()) return result;
+        result.level = config.value("level", result.level);
+        result.format = config.value("format", result.format);
+        result.async = config.value("async", result.async);
+        result.queue_size = config.value("queueSize", result.queue_size);
+        result.block_on_overflow = config.value("overflow", std::string("dropOldest")) == "block";
+        result.flush_interval_seconds = config.value("flushIntervalSeconds", result.flush_interval_seconds);
+        return result;
+    }
+
+    void initLogging(const LoggingConfig& config) {
+        spdlog::sink_ptr sink;
+        g_json_format.store(config.format == "json", std::memory_order_relaxed);
+        if (config.format == "json") {
+            sink = std::make_shared<spdlog::sinks::stdout_sink_mt>();
+            sink->set_formatter(std::make_unique<JsonFormatter>());
+        }
+        else {
+            sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        }
+
+        std::shared_ptr<spdlog::logger> logger;
+        if (config.async) {
+            spdlog::init_thread_pool(config.queue_size, 1);
+            logger = std::make_shared<spdlog::async_logger>("main", sink, spdlog::thread_pool(),
+                config.block_on_overflow ? spdlog::async_overflow_policy::block : spdlog::async_overflow_policy::overrun_oldest);
+        }
+        else {
+            logger = std::make_shared<spdlog::logger>("main", sink);
+        }
+
+        logger->set_level(spdlog::level::from_str(config.level));
+        // 경고 이상은 바로 내보내 장애 직전 로그가 큐에 남지 않도록 함
+        logger->flush_on(spdlog::level::warn);
+        spdlog::set_default_logger(logger);
+        if (config.flush_interval_seconds > 0) {
+            spdlog::flush_every(std::chrono::seconds(config.flush_interval_seconds));
+        }
+
+        spdlog::info("로거 설정 완료, 레벨 : {}, 형식 : {}, 비동기 : {} (큐 {}개, 초과 시 {})",
+            config.level, config.format, config.async, config.queue_size,
+            config.block_on_overflow ? "대기" : "오래된 로그 버림");
+    }
+
+    void detail::logContextMessage(const LogContext& context, spdlog::level::level_enum level, std::string_view message) {
+        spdlog::memory_buf_t buffer;
+        if (g_json_format.load(std::memory_order_relaxed)) {
+            fmt::format_to(std::back_inserter(buffer), "\"session\":{},\"user\":{},\"msg\":\"", context.session_id, context.user_id);
+            appendEscaped(buffer, message.data(), message.size());
+            buffer.push_back('"');
+            spdlog::default_logger_raw()->log(spdlog::source_loc{ kStructuredPayload, 0, nullptr }, level,
+                spdlog::string_view_t(buffer.data(), buffer.size()));
+            return;
+        }
+        fmt::format_to(std::back_inserter(buffer), "[session={} user={}] ", context.session_id, context.user_id);
+        buffer.append(message.data(), message.data() + message.size());
+        spdlog::log(level, spdlog::string_view_t(buffer.data(), buffer.size()));
+    }
+
+    std::size_t droppedLogMessages() {
+        auto pool = spdlog::thread_pool();
+        return pool ? pool->overrun_counter() : 0;
+    }
+
+    bool LogThrottle::allow(std::uint64_t& suppressed) {
+        std::int64_t now = steadyMillis();
+        std::int64_t start = window_start_ms_.load(std::memory_order_relaxed);
+        if (now - start >= window_ms_ &&
+            window_start_ms_.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+            // 새 창을 연 스레드가 카운트 초기화 (경합 시 한두 건의 오차는 허용)
+            count_.store(0, std::memory_order_relaxed);
+        }
+
+        if (count_.fetch_add(1, std::memory_order_relaxed) < burst_) {
+            suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+} // namespace game_server
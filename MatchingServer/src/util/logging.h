@@ -0,0 +1,89 @@
+﻿// util/logging.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    // 로거 설정 (config.json의 "logging" 섹션)
+    struct LoggingConfig {
+        std::string level = "info";
+        std::string format = "text";          // "text" 또는 "json" (한 줄에 JSON 객체 하나)
+        bool async = true;                    // 로그 출력은 전용 스레드에서 수행하고 호출 스레드는 큐에 넣기만 함
+        std::size_t queue_size = 8192;        // 비동기 큐 최대 메시지 수
+        bool block_on_overflow = false;       // 큐가 가득 찼을 때 true면 대기, false면 가장 오래된 메시지를 버림
+        int flush_interval_seconds = 1;
+
+        static LoggingConfig fromJson(const nlohmann::json& config);
+    };
+
+    // 설정에 맞는 로거를 만들어 기본 로거로 교체
+    void initLogging(const LoggingConfig& config);
+    // 비동기 큐가 가득 차 버려진 로그 수 (동기 모드이면 0)
+    std::size_t droppedLogMessages();
+
+    // 로그를 남긴 세션 문맥, session_id가 0이면 붙이지 않음
+    // 텍스트 형식에서는 "[session=3 user=12] 메시지", JSON 형식에서는 session/user 필드로 출력
+    struct LogContext {
+        std::uint64_t session_id = 0;
+        int user_id = 0;
+    };
+
+    namespace detail {
+        // 문맥이 있는 메시지 출력: 텍스트 형식은 "[session=3 user=12] " 접두사를 붙이고,
+        // JSON 형식은 session/user 필드를 만들어 포맷터가 메시지 내용을 다시 해석하지 않도록 전달
+        void logContextMessage(const LogContext& context, spdlog::level::level_enum level, std::string_view message);
+    }
+
+    // 같은 오류가 반복될 때 호출 위치마다 window 동안 burst건까지만 남기는 제한기 (락 없음)
+    class LogThrottle {
+    public:
+        explicit LogThrottle(std::chrono::milliseconds window = std::chrono::seconds(10), std::uint32_t burst = 5)
+            : window_ms_(window.count()), burst_(burst) {}
+
+        // 남겨도 되면 true, suppressed에는 그 전까지 생략된 건수를 담음
+        bool allow(std::uint64_t& suppressed);
+
+    private:
+        const std::int64_t window_ms_;
+        const std::uint32_t burst_;
+        std::atomic<std::int64_t> window_start_ms_{ 0 };
+        std::atomic<std::uint32_t> count_{ 0 };
+        std::atomic<std::uint64_t> suppressed_{ 0 };
+    };
+
+    // 레벨이 꺼져 있으면 인자 포맷 없이 바로 반환
+    template <typename... Args>
+    void logWith(const LogContext& context, spdlog::level::level_enum level,
+        spdlog::format_string_t<Args...> format, Args&&... args) {
+        if (!spdlog::should_log(level)) return;
+        if (context.session_id == 0) {
+            spdlog::log(level, format, std::forward<Args>(args)...);
+            return;
+        }
+        spdlog::memory_buf_t buffer;
+        fmt::format_to(std::back_inserter(buffer), format, std::forward<Args>(args)...);
+        detail::logContextMessage(context, level, std::string_view(buffer.data(), buffer.size()));
+    }
+
+    template <typename... Args>
+    void logThrottled(LogThrottle& throttle, const LogContext& context, spdlog::level::level_enum level,
+        spdlog::format_string_t<Args...> format, Args&&... args) {
+        if (!spdlog::should_log(level)) return;
+        std::uint64_t suppressed = 0;
+        if (!throttle.allow(suppressed)) return;
+        if (suppressed) {
+            spdlog::log(level, "같은 위치의 로그 {}건이 생략되었습니다", suppressed);
+        }
+        logWith(context, level, format, std::forward<Args>(args)...);
+    }
+
+} // namespace game_server
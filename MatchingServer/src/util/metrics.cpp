@@ -0,0 +1,261 @@
+﻿// util/metrics.cpp
+#include "metrics.h"
+#include <algorithm>
+#include <cstdio>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    namespace {
+
+        // Prometheus 노출 형식의 숫자 표기 (정수는 그대로, 실수는 유효 숫자 12자리)
+        void append_number(std::string& out, double value) {
+            char buf[32];
+            int len = std::snprintf(buf, sizeof(buf), "%.12g", value);
+            out.append(buf, static_cast<std::size_t>(len));
+        }
+
+        void append_series(std::string& out, const std::string& name, const char* suffix,
+            const std::string& labels, const std::string& extra_label) {
+            out += name;
+            out += suffix;
+            if (!labels.empty() || !extra_label.empty()) {
+                out += '{';
+                out += labels;
+                if (!labels.empty() && !extra_label.empty()) out += ',';
+                out += extra_label;
+                out += '}';
+            }
+            out += ' ';
+        }
+
+    } // namespace
+
+    struct Metrics::ShardLease {
+        Shard* shard = nullptr;
+        ~ShardLease() {
+            if (shard) {
+                Metrics::instance().release_shard(shard);
+            }
+        }
+    };
+
+    Metrics& Metrics::instance() {
+        // 종료 시점까지 스레드가 기록할 수 있으므로 해제하지 않음
+        static Metrics* metrics = new Metrics();
+        return *metrics;
+    }
+
+    Metrics::Shard& Metrics::local_shard() {
+        static thread_local ShardLease lease;
+        if (!lease.shard) {
+            lease.shard = instance().attach_shard();
+        }
+        return *lease.shard;
+    }
+
+    Metrics::Shard* Metrics::attach_shard() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_shards_.empty()) {
+            Shard* shard = free_shards_.back();
+            free_shards_.pop_back();
+            return shard;
+        }
+        shards_.push_back(std::make_unique<Shard>());
+        for (auto& value : shards_.back()->values) {
+            value.store(0, std::memory_order_relaxed);
+        }
+        return shards_.back().get();
+    }
+
+    void Metrics::release_shard(Shard* shard) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_shards_.push_back(shard);
+    }
+
+    Metrics::Family& Metrics::family(const std::string& name, const std::string& help, Type type) {
+        for (auto& family : families_) {
+            if (family->name == name) {
+                if (family->type != type) {
+                    spdlog::warn("메트릭 {}가 다른 유형으로 이미 등록되어 있습니다", name);
+                }
+                return *family;
+            }
+        }
+        families_.push_back(std::make_unique<Family>(Family{ name, help, type, {} }));
+        return *families_.back();
+    }
+
+    Metrics::Series* Metrics::find_series(Family& family, const std::string& labels) {
+        for (auto& series : family.series) {
+            if (series->labels == labels) {
+                return series.get();
+            }
+        }
+        return nullptr;
+    }
+
+    std::uint32_t Metrics::reserve_slots(std::uint32_t count, const std::string& name) {
+        if (next_slot_ + count > kShardSlots) {
+            spdlog::warn("메트릭 칸이 부족하여 {}를 기록하지 않습니다", name);
+            return 0;
+        }
+        std::uint32_t base = next_slot_;
+        next_slot_ += count;
+        return base;
+    }
+
+    Metrics::Counter Metrics::counter(const std::string& name, const std::string& help, const std::string& labels) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Family& target = family(name, help, Type::Counter);
+        if (Series* series = find_series(target, labels)) {
+            return Counter(series->base);
+        }
+
+        auto series = std::make_unique<Series>();
+        series->labels = labels;
+        series->base = reserve_slots(1, name);
+        std::uint32_t base = series->base;
+        if (base) {
+            target.series.push_back(std::move(series));
+        }
+        return Counter(base);
+    }
+
+    Metrics::Histogram Metrics::histogram(const std::string& name, const std::string& help,
+        const std::vector<std::uint64_t>& bounds, double scale, const std::string& labels) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Family& target = family(name, help, Type::Histogram);
+        Series* series = find_series(target, labels);
+        if (!series) {
+            // 버킷마다 한 칸(누적하지 않은 개수), +Inf 버킷 한 칸, 합계 한 칸
+            std::uint32_t base = reserve_slots(static_cast<std::uint32_t>(bounds.size()) + 2, name);
+            if (!base) {
+                return Histogram();
+            }
+            auto created = std::make_unique<Series>();
+            created->labels = labels;
+            created->base = base;
+            created->bounds = bounds;
+            created->scale = scale;
+            series = created.get();
+            target.series.push_back(std::move(created));
+        }
+        return Histogram(series->bounds.data(), static_cast<std::uint32_t>(series->bounds.size()), series->base);
+    }
+
+    void Metrics::Histogram::observe(std::uint64_t value) const {
+        if (!base_) return;
+
+        // 버킷 수가 적으므로 선형 탐색이 이진 탐색보다 빠름
+        std::uint32_t bucket = 0;
+        while (bucket < bucket_count_ && value > bounds_[bucket]) {
+            ++bucket;
+        }
+
+        Shard& shard = local_shard();
+        auto& count = shard.values[base_ + bucket];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        auto& sum = shard.values[base_ + bucket_count_ + 1];
+        sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    void Metrics::gauge(const std::string& name, const std::string& help, std::function<double()> read,
+        const void* owner, const std::string& labels) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Family& target = family(name, help, Type::Gauge);
+        Series* series = find_series(target, labels);
+        if (!series) {
+            target.series.push_back(std::make_unique<Series>());
+            series = target.series.back().get();
+            series->labels = labels;
+        }
+        series->read = std::move(read);
+        series->owner = owner;
+    }
+
+    void Metrics::removeGauges(const void* owner) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& family : families_) {
+            if (family->type != Type::Gauge) continue;
+            auto& series = family->series;
+            series.erase(std::remove_if(series.begin(), series.end(),
+                [owner](const std::unique_ptr<Series>& s) { return s->owner == owner; }), series.end());
+        }
+    }
+
+    std::string Metrics::renderPrometheus() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // 스레드별 샤드 합산 (기록 중인 스레드와 경합해도 각 칸은 원자적으로 읽힘)
+        std::vector<std::uint64_t> totals(next_slot_, 0);
+        for (const auto& shard : shards_) {
+            for (std::uint32_t slot = 1; slot < next_slot_; ++slot) {
+                totals[slot] += shard->values[slot].load(std::memory_order_relaxed);
+            }
+        }
+
+        std::string out;
+        out.reserve(8192);
+        for (const auto& family : families_) {
+            if (family->series.empty()) continue;
+
+            const char* type = family->type == Type::Counter ? "counter"
+                : family->type == Type::Gauge ? "gauge" : "histogram";
+            out += "# HELP " + family->name + " " + family->help + "\n";
+            out += "# TYPE " + family->name + " " + type + "\n";
+
+            for (const auto& series : family->series) {
+                if (family->type == Type::Counter) {
+                    append_series(out, family->name, "", series->labels, "");
+                    out += std::to_string(totals[series->base]);
+                    out += '\n';
+                }
+                else if (family->type == Type::Gauge) {
+                    append_series(out, family->name, "", series->labels, "");
+                    append_number(out, series->read ? series->read() : 0.0);
+                    out += '\n';
+                }
+                else {
+                    std::uint64_t cumulative = 0;
+                    for (std::size_t i = 0; i <= series->bounds.size(); ++i) {
+                        cumulative += totals[series->base + i];
+                        std::string le = "le=\"";
+                        if (i < series->bounds.size()) {
+                            append_number(le, static_cast<double>(series->bounds[i]) * series->scale);
+                        }
+                        else {
+                            le += "+Inf";
+                        }
+                        le += '"';
+                        append_series(out, family->name, "_bucket", series->labels, le);
+                        out += std::to_string(cumulative);
+                        out += '\n';
+                    }
+                    append_series(out, family->name, "_sum", series->labels, "");
+                    append_number(out, static_cast<double>(totals[series->base + series->bounds.size() + 1]) * series->scale);
+                    out += '\n';
+                    append_series(out, family->name, "_count", series->labels, "");
+                    out += std::to_string(cumulative);
+                    out += '\n';
+                }
+            }
+        }
+        return out;
+    }
+
+    const std::vector<std::uint64_t>& Metrics::latencyBuckets() {
+        static const std::vector<std::uint64_t> buckets = {
+            50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000, 10000000
+        };
+        return buckets;
+    }
+
+    const std::vector<std::uint64_t>& Metrics::sizeBuckets() {
+        static const std::vector<std::uint64_t> buckets = {
+            1, 4, 16, 64, 256, 1024, 4096, 16384, 65536
+        };
+        return buckets;
+    }
+
+} // namespace game_server
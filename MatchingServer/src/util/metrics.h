@@ -0,0 +1,122 @@
+﻿// util/metrics.h
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace game_server {
+
+    // 프로세스 전역 메트릭 레지스트리 (Prometheus 텍스트 형식으로 노출)
+    // 카운터/히스토그램 값은 스레드별 샤드에 기록하고 스크레이프 시점에 모든 샤드를 합산한다.
+    // 샤드의 각 칸은 소유 스레드만 쓰므로 원자적 load/store만으로 갱신하며, 기록 경로에 락이나 RMW 명령이 없다.
+    // 게이지는 값을 따로 보관하지 않고 스크레이프 시 등록된 콜백으로 읽는다.
+    class Metrics {
+    public:
+        static constexpr std::size_t kShardSlots = 4096;  // 스레드당 칸 수 (히스토그램은 버킷 수 + 2칸 사용)
+
+        struct Shard {
+            std::array<std::atomic<std::uint64_t>, kShardSlots> values;
+        };
+
+        // 단조 증가 카운터 핸들 (등록 후 복사해서 사용)
+        class Counter {
+        public:
+            Counter() = default;
+            void add(std::uint64_t n = 1) const {
+                auto& value = local_shard().values[slot_];
+                value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            }
+
+        private:
+            friend class Metrics;
+            explicit Counter(std::uint32_t slot) : slot_(slot) {}
+            std::uint32_t slot_ = 0;  // 0번 칸은 등록 실패 시 버리는 칸
+        };
+
+        // 고정 버킷 히스토그램 핸들, 값은 정수 단위(마이크로초, 바이트, 개수)로 기록
+        class Histogram {
+        public:
+            Histogram() = default;
+            void observe(std::uint64_t value) const;
+            // 시작 시각부터 지금까지의 경과 시간을 마이크로초로 기록
+            void observeSince(std::chrono::steady_clock::time_point started) const {
+                observe(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - started).count()));
+            }
+
+        private:
+            friend class Metrics;
+            Histogram(const std::uint64_t* bounds, std::uint32_t bucket_count, std::uint32_t base)
+                : bounds_(bounds), bucket_count_(bucket_count), base_(base) {}
+            const std::uint64_t* bounds_ = nullptr;
+            std::uint32_t bucket_count_ = 0;  // 상한 개수 (+Inf 버킷 제외)
+            std::uint32_t base_ = 0;
+        };
+
+        static Metrics& instance();
+
+        // 같은 이름과 라벨로 다시 등록하면 기존 시리즈를 돌려줌
+        // labels는 Prometheus 라벨 본문 (예: action="login"), 코드에 고정된 값만 사용
+        Counter counter(const std::string& name, const std::string& help, const std::string& labels = "");
+        // bounds: 오름차순 버킷 상한 (기록 단위), scale: 노출 시 곱할 값 (마이크로초를 초로 내보내려면 1e-6)
+        Histogram histogram(const std::string& name, const std::string& help,
+            const std::vector<std::uint64_t>& bounds, double scale = 1.0, const std::string& labels = "");
+        // owner는 removeGauges로 한 번에 해제하기 위한 식별자 (보통 등록한 객체의 this)
+        void gauge(const std::string& name, const std::string& help, std::function<double()> read,
+            const void* owner, const std::string& labels = "");
+        void removeGauges(const void* owner);
+
+        // 모든 샤드를 합산해 Prometheus 텍스트 노출 형식(0.0.4)으로 출력
+        std::string renderPrometheus();
+
+        // 마이크로초 지연 시간용 기본 버킷 (50us ~ 10s)
+        static const std::vector<std::uint64_t>& latencyBuckets();
+        // 개수/크기용 기본 버킷 (1 ~ 65536, 4배씩)
+        static const std::vector<std::uint64_t>& sizeBuckets();
+
+    private:
+        enum class Type { Counter, Gauge, Histogram };
+
+        struct Series {
+            std::string labels;
+            std::uint32_t base = 0;
+            std::vector<std::uint64_t> bounds;
+            double scale = 1.0;
+            std::function<double()> read;
+            const void* owner = nullptr;
+        };
+
+        struct Family {
+            std::string name;
+            std::string help;
+            Type type;
+            std::vector<std::unique_ptr<Series>> series;
+        };
+
+        // 스레드 종료 시 샤드를 반납하는 thread_local 객체
+        struct ShardLease;
+
+        Metrics() = default;
+        static Shard& local_shard();
+        Shard* attach_shard();
+        void release_shard(Shard* shard);
+        Family& family(const std::string& name, const std::string& help, Type type);
+        Series* find_series(Family& family, const std::string& labels);
+        std::uint32_t reserve_slots(std::uint32_t count, const std::string& name);
+
+        std::mutex mutex_;
+        std::vector<std::unique_ptr<Family>> families_;
+        std::uint32_t next_slot_ = 1;
+        // 종료된 스레드의 샤드도 합계 유지를 위해 남겨두고, 새 스레드가 재사용
+        std::vector<std::unique_ptr<Shard>> shards_;
+        std::vector<Shard*> free_shards_;
+    };
+
+} // namespace game_server
@@ -0,0 +1,81 @@
+﻿// util/object_pool.cpp
+// 고정 크기 블록 풀 구현 파일
+#include "object_pool.h"
+#include <algorithm>
+
+namespace game_server {
+
+    FixedBlockPool::FixedBlockPool(std::size_t max_cached)
+        : max_cached_(max_cached)
+    {
+    }
+
+    FixedBlockPool::~FixedBlockPool() {
+        while (free_list_) {
+            FreeBlock* next = free_list_->next;
+            ::operator delete(free_list_);
+            free_list_ = next;
+        }
+    }
+
+    void* FixedBlockPool::allocate(std::size_t size) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (block_size_ == 0) {
+                block_size_ = std::max(size, sizeof(FreeBlock));
+            }
+            if (size == block_size_) {
+                live_++;
+                if (free_list_) {
+                    FreeBlock* block = free_list_;
+                    free_list_ = block->next;
+                    cached_--;
+                    reused_++;
+                    return block;
+                }
+                allocated_++;
+            }
+        }
+        return ::operator new(std::max(size, sizeof(FreeBlock)));
+    }
+
+    void FixedBlockPool::deallocate(void* block, std::size_t size) {
+        if (!block) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (size == block_size_) {
+                live_--;
+                if (cached_ < max_cached_) {
+                    FreeBlock* free_block = static_cast<FreeBlock*>(block);
+                    free_block->next = free_list_;
+                    free_list_ = free_block;
+                    cached_++;
+                    return;
+                }
+            }
+        }
+        ::operator delete(block);
+    }
+
+    std::size_t FixedBlockPool::blockSize() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return block_size_;
+    }
+
+    std::size_t FixedBlockPool::liveBlocks() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return live_;
+    }
+
+    nlohmann::json FixedBlockPool::stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return {
+            {"blockSize", block_size_},
+            {"live", live_},
+            {"cached", cached_},
+            {"allocated", allocated_},
+            {"reused", reused_}
+        };
+    }
+
+} // namespace game_server
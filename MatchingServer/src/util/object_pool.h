@@ -0,0 +1,74 @@
+﻿// util/object_pool.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    // 같은 크기의 블록을 빈 목록으로 재사용하는 풀
+    // 블록 크기는 첫 할당 크기로 정해지며, 다른 크기 요청은 일반 new로 처리한다.
+    // 반납된 블록은 max_cached개까지 보관하고 넘는 블록은 바로 해제한다.
+    class FixedBlockPool {
+    public:
+        explicit FixedBlockPool(std::size_t max_cached);
+        ~FixedBlockPool();
+        FixedBlockPool(const FixedBlockPool&) = delete;
+        FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+        void* allocate(std::size_t size);
+        void deallocate(void* block, std::size_t size);
+
+        std::size_t blockSize();
+        std::size_t liveBlocks();
+        nlohmann::json stats();
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        std::mutex mutex_;
+        std::size_t block_size_ = 0;
+        std::size_t max_cached_;
+        FreeBlock* free_list_ = nullptr;
+        std::size_t cached_ = 0;
+        std::size_t live_ = 0;
+        std::uint64_t reused_ = 0;
+        std::uint64_t allocated_ = 0;
+    };
+
+    // std::allocate_shared용 할당자, Tag::pool()의 블록을 사용
+    // (제어 블록과 객체가 한 블록에 들어가므로 객체당 할당 1회가 빈 목록 pop 1회로 바뀜)
+    template <class T, class Tag>
+    class PoolAllocator {
+    public:
+        using value_type = T;
+
+        template <class U>
+        struct rebind {
+            using other = PoolAllocator<U, Tag>;
+        };
+
+        PoolAllocator() noexcept = default;
+        template <class U>
+        PoolAllocator(const PoolAllocator<U, Tag>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "풀 블록은 기본 new 정렬만 보장");
+            return static_cast<T*>(Tag::pool().allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            Tag::pool().deallocate(p, n * sizeof(T));
+        }
+
+        template <class U>
+        bool operator==(const PoolAllocator<U, Tag>&) const noexcept { return true; }
+        template <class U>
+        bool operator!=(const PoolAllocator<U, Tag>&) const noexcept { return false; }
+    };
+
+} // namespace game_server
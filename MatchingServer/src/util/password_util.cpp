@@ -2,33 +2,186 @@
 // 비밀번호 유틸리티 구현 파일
 // 비밀번호 해싱 및 검증 기능 제공
 #include "password_util.h"
-#include <openssl/sha.h>
-#include <iomanip>
-#include <sstream>
+#include "tracing.h"
+#include "crypto/crypto_util.h"
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
 #include <spdlog/spdlog.h>
 
 namespace game_server {
 
+    namespace {
+        constexpr std::size_t kSaltLength = 16;
+        constexpr std::size_t kHashLength = 32;
+        constexpr char kScryptPrefix[] = "$scrypt$";
+
+        PasswordHashConfig& currentConfig() {
+            static PasswordHashConfig config;
+            return config;
+        }
+
+        // PHC 문자열 형식의 base64 (패딩 없음)
+        const char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        std::string base64Encode(const unsigned char* data, std::size_t length) {
+            std::string out;
+            out.reserve((length * 4 + 2) / 3);
+            std::uint32_t buffer = 0;
+            int bits = 0;
+            for (std::size_t i = 0; i < length; ++i) {
+                buffer = (buffer << 8) | data[i];
+                bits += 8;
+                while (bits >= 6) {
+                    bits -= 6;
+                    out.push_back(kBase64Chars[(buffer >> bits) & 0x3F]);
+                }
+            }
+            if (bits > 0) {
+                out.push_back(kBase64Chars[(buffer << (6 - bits)) & 0x3F]);
+            }
+            return out;
+        }
+
+        bool base64Decode(const std::string& text, std::vector<unsigned char>& out) {
+            out.clear();
+            std::uint32_t buffer = 0;
+            int bits = 0;
+            for (char c : text) {
+                int value;
+                if (c >= 'A' && c <= 'Z') value = c - 'A';
+                else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+                else if (c >= '0' && c <= '9') value = c - '0' + 52;
+                else if (c == '+') value = 62;
+                else if (c == '/') value = 63;
+                else return false;
+
+                buffer = (buffer << 6) | static_cast<std::uint32_t>(value);
+                bits += 6;
+                if (bits >= 8) {
+                    bits -= 8;
+                    out.push_back(static_cast<unsigned char>((buffer >> bits) & 0xFF));
+                }
+            }
+            return true;
+        }
+
+        bool deriveScrypt(const std::string& password, const unsigned char* salt, std::size_t salt_length,
+            const PasswordHashConfig& config, unsigned char* out, std::size_t out_length) {
+            std::uint64_t n = std::uint64_t{ 1 } << config.log_n;
+            // OpenSSL 기본 메모리 한도(32MB)를 넘는 비용도 쓸 수 있도록 필요한 만큼 지정
+            std::uint64_t maxmem = 128ull * config.r * (n + config.p + 2) + (1ull << 20);
+            return EVP_PBE_scrypt(password.data(), password.size(), salt, salt_length,
+                n, config.r, config.p, maxmem, out, out_length) == 1;
+        }
+
+        // "$scrypt$ln=14,r=8,p=1$<salt>$<hash>" 분해
+        bool parseScrypt(const std::string& encoded, PasswordHashConfig& config,
+            std::vector<unsigned char>& salt, std::vector<unsigned char>& hash) {
+            if (encoded.compare(0, sizeof(kScryptPrefix) - 1, kScryptPrefix) != 0) return false;
+
+            std::size_t params_begin = sizeof(kScryptPrefix) - 1;
+            std::size_t salt_begin = encoded.find('$', params_begin);
+            if (salt_begin == std::string::npos) return false;
+            std::size_t hash_begin = encoded.find('$', salt_begin + 1);
+            if (hash_begin == std::string::npos) return false;
+
+            std::string params = encoded.substr(params_begin, salt_begin - params_begin);
+            unsigned int log_n = 0, r = 0, p = 0;
+            if (std::sscanf(params.c_str(), "ln=%u,r=%u,p=%u", &log_n, &r, &p) != 3) return false;
+            if (log_n < 1 || log_n > 30 || r < 1 || p < 1) return false;
+            config.log_n = log_n;
+            config.r = r;
+            config.p = p;
+
+            return base64Decode(encoded.substr(salt_begin + 1, hash_begin - salt_begin - 1), salt) &&
+                base64Decode(encoded.substr(hash_begin + 1), hash) &&
+                !salt.empty() && !hash.empty();
+        }
+
+        // 이전 버전 형식: 솔트 없는 SHA-256 16진수, 저장된 값을 바이트로 되돌려 스택 버퍼에서 비교
+        bool verifyLegacySha256(const std::string& password, const std::string& hashedPassword) {
+            crypto::Sha256Digest expected;
+            if (!crypto::fromHex(hashedPassword, expected.data(), expected.size())) return false;
+
+            crypto::Sha256Digest computed = crypto::sha256(password);
+            return crypto::constantTimeEquals(computed.data(), expected.data(), computed.size());
+        }
+    }
+
+    PasswordHashConfig PasswordHashConfig::fromJson(const nlohmann::json& config) {
+        PasswordHashConfig result;
+        if (!config.is_object()) return result;
+
+        result.log_n = config.value("logN", result.log_n);
+        result.r = config.value("r", result.r);
+        result.p = config.value("p", result.p);
+        if (result.log_n < 10 || result.log_n > 22) result.log_n = 14;
+        if (result.r < 1) result.r = 8;
+        if (result.p < 1) result.p = 1;
+        return result;
+    }
+
+    void PasswordUtil::configure(const PasswordHashConfig& config) {
+        currentConfig() = config;
+
+        auto started_at = std::chrono::steady_clock::now();
+        hashPassword("calibration-password");
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started_at);
+        spdlog::info("비밀번호 해시 설정: scrypt N=2^{}, r={}, p={}, 메모리 약 {}MB, 1회 소요 시간 {}ms",
+            config.log_n, config.r, config.p,
+            (128ull * config.r * (std::uint64_t{ 1 } << config.log_n)) >> 20, elapsed.count());
+    }
+
     std::string PasswordUtil::hashPassword(const std::string& password) {
-        // 보안 참고: 실제 제품에서는 더 안전한 해싱 알고리즘 사용 필요
-        unsigned char hash[SHA256_DIGEST_LENGTH];
-        SHA256(reinterpret_cast<const unsigned char*>(password.c_str()),
-            password.length(), hash);
+        ScopedSpan span("password.hash");
+        const PasswordHashConfig& config = currentConfig();
 
-        // 해시를 16진수 문자열로 변환
-        std::stringstream ss;
-        for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-            ss << std::hex << std::setw(2) << std::setfill('0')
-                << static_cast<int>(hash[i]);
+        unsigned char salt[kSaltLength];
+        unsigned char hash[kHashLength];
+        if (RAND_bytes(salt, sizeof(salt)) != 1 ||
+            !deriveScrypt(password, salt, sizeof(salt), config, hash, sizeof(hash))) {
+            spdlog::error("비밀번호 해시 생성에 실패하였습니다");
+            return "";
         }
 
-        return ss.str();
+        return std::string(kScryptPrefix) +
+            "ln=" + std::to_string(config.log_n) +
+            ",r=" + std::to_string(config.r) +
+            ",p=" + std::to_string(config.p) + "$" +
+            base64Encode(salt, sizeof(salt)) + "$" +
+            base64Encode(hash, sizeof(hash));
     }
 
     bool PasswordUtil::verifyPassword(const std::string& password, const std::string& hashedPassword) {
-        // 입력된 비밀번호의 해시와 저장된 해시 비교
-        std::string computedHash = hashPassword(password);
-        return computedHash == hashedPassword;
+        ScopedSpan span("password.verify");
+        PasswordHashConfig config;
+        std::vector<unsigned char> salt;
+        std::vector<unsigned char> expected;
+        if (parseScrypt(hashedPassword, config, salt, expected)) {
+            std::vector<unsigned char> computed(expected.size());
+            if (!deriveScrypt(password, salt.data(), salt.size(), config, computed.data(), computed.size())) {
+                spdlog::error("비밀번호 검증 중 해시 계산에 실패하였습니다");
+                return false;
+            }
+            return crypto::constantTimeEquals(computed.data(), expected.data(), expected.size());
+        }
+
+        // 이전 버전의 SHA-256 해시 (로그인 성공 시 scrypt로 다시 저장됨)
+        return verifyLegacySha256(password, hashedPassword);
+    }
+
+    bool PasswordUtil::needsRehash(const std::string& hashedPassword) {
+        PasswordHashConfig config;
+        std::vector<unsigned char> salt;
+        std::vector<unsigned char> hash;
+        if (!parseScrypt(hashedPassword, config, salt, hash)) return true;
+
+        const PasswordHashConfig& current = currentConfig();
+        return config.log_n < current.log_n || config.r < current.r || config.p < current.p;
     }
 
-} // namespace game_server
\ No newline at end of file
+} // namespace game_server
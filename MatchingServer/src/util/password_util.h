@@ -1,14 +1,34 @@
 ﻿// util/password_util.h
 #pragma once
+#include <cstdint>
 #include <string>
+#include <nlohmann/json.hpp>
 
 namespace game_server {
 
+    // scrypt 비용 설정 (config.json의 "passwordHash" 섹션)
+    // N = 2^log_n, 메모리 사용량은 약 128 * r * N 바이트 (기본 16MB)
+    struct PasswordHashConfig {
+        std::uint32_t log_n = 14;
+        std::uint32_t r = 8;
+        std::uint32_t p = 1;
+
+        static PasswordHashConfig fromJson(const nlohmann::json& config);
+    };
+
     class PasswordUtil {
     public:
+        // 서버 시작 시 한 번 호출, 설정된 비용으로 해시 1회 소요 시간을 측정하여 로그로 남김
+        static void configure(const PasswordHashConfig& config);
+
+        // 솔트를 포함한 "$scrypt$ln=..,r=..,p=..$<salt>$<hash>" 형식 문자열 반환
         static std::string hashPassword(const std::string& password);
 
+        // scrypt 형식과 이전 버전의 SHA-256 16진수 해시를 모두 검증
         static bool verifyPassword(const std::string& password, const std::string& hashedPassword);
+
+        // 이전 형식이거나 현재 설정보다 비용이 낮은 해시면 true (로그인 성공 시 다시 해시하여 저장)
+        static bool needsRehash(const std::string& hashedPassword);
     };
 
 } // namespace game_server
@@ -0,0 +1,28 @@
+﻿// util/traced_sql.h
+#pragma once
+#include <utility>
+#include <pqxx/pqxx>
+#include "tracing.h"
+
+namespace game_server {
+
+    // SQL 문 하나를 추적 스팬으로 감싸 실행 (리포지토리 구현 파일에서만 포함)
+    // span은 "sql <문 종류> <테이블>" 형식의 문자열 리터럴, 요청 추적 중이 아니면 그대로 실행
+    template <class Transaction, class... Args>
+    pqxx::result tracedExec(Transaction& txn, const char* span, const char* sql, Args&&... args) {
+        ScopedSpan scope(span);
+        if constexpr (sizeof...(Args) == 0) {
+            return txn.exec(sql);
+        }
+        else {
+            return txn.exec_params(sql, std::forward<Args>(args)...);
+        }
+    }
+
+    template <class Transaction>
+    void tracedCommit(Transaction& txn) {
+        ScopedSpan scope("sql COMMIT");
+        txn.commit();
+    }
+
+} // namespace game_server
@@ -0,0 +1,281 @@
+﻿// util/tracing.cpp
+// 요청 추적 구현 파일
+// 스팬 기록, 느린 요청 링 버퍼, OTLP JSON 내보내기
+#include "tracing.h"
+#include "logging.h"
+#include "crypto/crypto_util.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace game_server {
+
+    namespace {
+
+        thread_local Trace* current_trace = nullptr;
+
+        std::int64_t steadyNanos(std::chrono::steady_clock::time_point time) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        }
+
+        std::int64_t nowNanos() {
+            return steadyNanos(std::chrono::steady_clock::now());
+        }
+
+        // OTLP 스팬 ID: 추적 ID 뒤 8바이트에 스팬 번호를 더해 추적 안에서 유일하게 만듦
+        std::string spanId(const std::array<unsigned char, 16>& trace_id, std::size_t index) {
+            unsigned char id[8];
+            std::memcpy(id, trace_id.data() + 8, sizeof(id));
+            std::uint64_t value = 0;
+            for (unsigned char byte : id) value = (value << 8) | byte;
+            value += index + 1;
+            for (int i = 7; i >= 0; --i) {
+                id[i] = static_cast<unsigned char>(value & 0xFF);
+                value >>= 8;
+            }
+            return crypto::toHexString(id, sizeof(id));
+        }
+
+        json stringAttribute(const char* key, const std::string& value) {
+            return { {"key", key}, {"value", {{"stringValue", value}}} };
+        }
+
+        json intAttribute(const char* key, std::uint64_t value) {
+            // OTLP JSON은 64비트 정수를 문자열로 표기
+            return { {"key", key}, {"value", {{"intValue", std::to_string(value)}}} };
+        }
+
+    } // namespace
+
+    TracingConfig TracingConfig::fromJson(const json& config) {
+        TracingConfig result;
+        if (!config.is_object()) return result;
+        result.enabled = config.value("enabled", result.enabled);
+        result.slow_threshold = std::chrono::milliseconds(
+            config.value("slowThresholdMs", static_cast<int>(result.slow_threshold.count())));
+        result.ring_size = config.value("ringSize", result.ring_size);
+        result.export_path = config.value("exportPath", result.export_path);
+        return result;
+    }
+
+    Trace::Trace(std::uint64_t request_id)
+        : request_id_(request_id),
+        wall_start_(std::chrono::system_clock::now())
+    {
+        spans_[0] = Span{ "request", kNoParent, nowNanos(), 0 };
+        count_ = 1;
+        open_ = 0;
+    }
+
+    Trace* Trace::current() {
+        return current_trace;
+    }
+
+    int Trace::beginSpan(const char* name) {
+        if (count_ >= kMaxSpans) {
+            ++dropped_;
+            return -1;
+        }
+        int index = count_++;
+        spans_[index] = Span{ name, open_, nowNanos(), 0 };
+        open_ = static_cast<std::uint16_t>(index);
+        return index;
+    }
+
+    void Trace::endSpan(int index) {
+        if (index < 0) return;
+        spans_[index].end_ns = nowNanos();
+        open_ = spans_[index].parent;
+    }
+
+    void Trace::addSpan(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+        if (count_ >= kMaxSpans) {
+            ++dropped_;
+            return;
+        }
+        spans_[count_++] = Span{ name, open_, steadyNanos(start), steadyNanos(end) };
+    }
+
+    void Trace::setAction(const std::string& action) {
+        action_ = action;
+    }
+
+    void Trace::finish() {
+        std::int64_t now = nowNanos();
+        // 예외 등으로 닫히지 않은 스팬은 요청 종료 시각으로 닫음
+        for (std::size_t i = 0; i < count_; ++i) {
+            if (spans_[i].end_ns == 0) spans_[i].end_ns = now;
+        }
+        open_ = kNoParent;
+    }
+
+    std::chrono::nanoseconds Trace::duration() const {
+        std::int64_t end = spans_[0].end_ns ? spans_[0].end_ns : nowNanos();
+        return std::chrono::nanoseconds(end - spans_[0].start_ns);
+    }
+
+    TraceScope::TraceScope(Trace* trace)
+        : previous_(current_trace)
+    {
+        current_trace = trace;
+    }
+
+    TraceScope::~TraceScope() {
+        current_trace = previous_;
+    }
+
+    FixedBlockPool& TracePoolTag::pool() {
+        // 링 버퍼에 남은 추적이 종료 시점에 반납될 수 있으므로 해제하지 않음
+        static FixedBlockPool* pool = new FixedBlockPool(1024);
+        return *pool;
+    }
+
+    Tracer& Tracer::instance() {
+        static Tracer* tracer = new Tracer();
+        return *tracer;
+    }
+
+    void Tracer::configure(const TracingConfig& config) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+        while (slow_.size() > config_.ring_size) {
+            slow_.pop_front();
+        }
+        slow_threshold_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(config.slow_threshold).count(),
+            std::memory_order_relaxed);
+        enabled_.store(config.enabled, std::memory_order_relaxed);
+        spdlog::info("요청 추적 설정 완료, 활성화 : {}, 느린 요청 기준 : {}ms, 보관 : {}건",
+            config.enabled, config.slow_threshold.count(), config.ring_size);
+    }
+
+    std::shared_ptr<Trace> Tracer::start() {
+        if (!enabled_.load(std::memory_order_relaxed)) return nullptr;
+        return std::allocate_shared<Trace>(PoolAllocator<Trace, TracePoolTag>(),
+            next_request_id_.fetch_add(1, std::memory_order_relaxed));
+    }
+
+    bool Tracer::finish(const std::shared_ptr<Trace>& trace) {
+        if (!trace) return false;
+        trace->finish();
+
+        // 빠른 요청은 락 없이 버림
+        auto duration = trace->duration();
+        if (duration.count() < slow_threshold_ns_.load(std::memory_order_relaxed)) return false;
+
+        // 가장 오래 걸린 SQL 문을 함께 기록 (원인 파악용)
+        const char* slowest = nullptr;
+        std::int64_t slowest_ns = 0;
+        for (std::size_t i = 1; i < trace->spanCount(); ++i) {
+            const auto& span = trace->span(i);
+            std::int64_t elapsed = span.end_ns - span.start_ns;
+            if (elapsed > slowest_ns && std::strncmp(span.name, "sql", 3) == 0) {
+                slowest = span.name;
+                slowest_ns = elapsed;
+            }
+        }
+        static LogThrottle throttle;
+        logThrottled(throttle, LogContext{}, spdlog::level::warn, "느린 요청 #{} {} {}ms, 가장 느린 SQL : {} {}ms",
+            trace->requestId(), trace->action(), duration.count() / 1000000,
+            slowest ? slowest : "없음", slowest_ns / 1000000);
+
+        SlowTrace slow;
+        slow.trace = trace;
+        if (!crypto::randomBytes(slow.trace_id.data(), slow.trace_id.size())) {
+            slow.trace_id.fill(0);
+            std::uint64_t id = trace->requestId();
+            std::memcpy(slow.trace_id.data(), &id, sizeof(id));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        slow_.push_back(std::move(slow));
+        while (slow_.size() > config_.ring_size) {
+            slow_.pop_front();
+        }
+        ++sampled_;
+        return true;
+    }
+
+    json Tracer::exportOtlp() {
+        std::deque<SlowTrace> traces;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            traces = slow_;
+        }
+
+        json spans = json::array();
+        for (const auto& slow : traces) {
+            const Trace& trace = *slow.trace;
+            std::string trace_id = crypto::toHexString(slow.trace_id.data(), slow.trace_id.size());
+            std::int64_t wall_start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                trace.wallStart().time_since_epoch()).count();
+
+            for (std::size_t i = 0; i < trace.spanCount(); ++i) {
+                const auto& span = trace.span(i);
+                // steady 시각을 요청 시작 시점의 벽시계 시각 기준으로 변환
+                std::int64_t start = wall_start_ns + (span.start_ns - trace.steadyStartNs());
+                std::int64_t end = wall_start_ns + (span.end_ns - trace.steadyStartNs());
+
+                json item = {
+                    {"traceId", trace_id},
+                    {"spanId", spanId(slow.trace_id, i)},
+                    {"name", i == 0 && !trace.action().empty() ? trace.action() : std::string(span.name)},
+                    {"kind", i == 0 ? 2 : 1},   // 루트는 SERVER, 나머지는 INTERNAL
+                    {"startTimeUnixNano", std::to_string(start)},
+                    {"endTimeUnixNano", std::to_string(end)}
+                };
+                if (span.parent != Trace::kNoParent) {
+                    item["parentSpanId"] = spanId(slow.trace_id, span.parent);
+                }
+                if (i == 0) {
+                    item["attributes"] = json::array({
+                        intAttribute("request.id", trace.requestId()),
+                        stringAttribute("request.action", trace.action()),
+                        intAttribute("trace.dropped_spans", trace.droppedSpans())
+                    });
+                }
+                spans.push_back(std::move(item));
+            }
+        }
+
+        return {
+            {"resourceSpans", json::array({ {
+                {"resource", {{"attributes", json::array({ stringAttribute("service.name", "matching-server") })}}},
+                {"scopeSpans", json::array({ {
+                    {"scope", {{"name", "game_server"}}},
+                    {"spans", std::move(spans)}
+                } })}
+            } })}
+        };
+    }
+
+    std::size_t Tracer::exportToFile() {
+        std::string path;
+        std::size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            path = config_.export_path;
+            count = slow_.size();
+        }
+
+        json document = exportOtlp();
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("추적 내보내기 파일을 열 수 없습니다: " + path);
+        }
+        file << document.dump() << '\n';
+        spdlog::info("느린 요청 {}건을 {}에 내보냈습니다", count, path);
+        return count;
+    }
+
+    json Tracer::stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return {
+            {"enabled", enabled_.load(std::memory_order_relaxed)},
+            {"slowThresholdMs", config_.slow_threshold.count()},
+            {"sampled", sampled_},
+            {"retained", slow_.size()},
+            {"requests", next_request_id_.load(std::memory_order_relaxed) - 1}
+        };
+    }
+
+} // namespace game_server
@@ -0,0 +1,152 @@
+﻿// util/tracing.h
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "object_pool.h"
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    // 요청 추적 설정 (config.json의 "tracing" 섹션)
+    struct TracingConfig {
+        bool enabled = true;
+        std::chrono::milliseconds slow_threshold{ 100 };  // 이 시간 이상 걸린 요청만 링 버퍼에 보관
+        std::size_t ring_size = 128;
+        std::string export_path = "./slow_traces.json";   // 관리용 포트의 /traces/export가 쓰는 파일
+
+        static TracingConfig fromJson(const json& config);
+    };
+
+    // 요청 하나의 스팬 기록
+    // 요청 경로의 각 계층(세션, 컨트롤러, 서비스, 리포지토리, DB 풀, SQL)이 ScopedSpan으로 구간을 남기고,
+    // 요청이 끝났을 때 느린 요청이면 Tracer의 링 버퍼에 보관된다.
+    // 한 시점에는 한 스레드만 기록하며(io 스레드 → 워커 → io 스레드 순으로 넘겨짐), 스팬 이름은 문자열 리터럴만 사용한다.
+    class Trace {
+    public:
+        static constexpr std::size_t kMaxSpans = 64;
+        static constexpr std::uint16_t kNoParent = 0xFFFF;
+
+        struct Span {
+            const char* name;
+            std::uint16_t parent;
+            std::int64_t start_ns;   // steady_clock 기준
+            std::int64_t end_ns;     // 0이면 아직 끝나지 않음
+        };
+
+        explicit Trace(std::uint64_t request_id);
+
+        // 루트 스팬("request")은 생성 시 시작되고 finish 시 끝남
+        int beginSpan(const char* name);
+        void endSpan(int index);
+        // 이미 지난 구간을 현재 스팬의 자식으로 추가 (워커 대기열 대기 시간 등)
+        void addSpan(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+        void setAction(const std::string& action);
+        void finish();
+
+        std::uint64_t requestId() const { return request_id_; }
+        const std::string& action() const { return action_; }
+        std::chrono::nanoseconds duration() const;
+        std::size_t spanCount() const { return count_; }
+        const Span& span(std::size_t index) const { return spans_[index]; }
+        std::size_t droppedSpans() const { return dropped_; }
+        std::chrono::system_clock::time_point wallStart() const { return wall_start_; }
+        std::int64_t steadyStartNs() const { return spans_[0].start_ns; }
+
+        // 현재 스레드에서 기록 중인 추적 (없으면 nullptr)
+        static Trace* current();
+
+    private:
+        friend class TraceScope;
+
+        std::uint64_t request_id_;
+        std::string action_;
+        std::chrono::system_clock::time_point wall_start_;
+        std::array<Span, kMaxSpans> spans_;
+        std::uint16_t count_ = 0;
+        std::uint16_t open_ = kNoParent;   // 새 스팬의 부모가 될 현재 열린 스팬
+        std::size_t dropped_ = 0;
+    };
+
+    // 현재 스레드의 추적을 지정하고 스코프를 벗어나면 이전 값으로 복원
+    class TraceScope {
+    public:
+        explicit TraceScope(Trace* trace);
+        ~TraceScope();
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        Trace* previous_;
+    };
+
+    // 현재 스레드에 추적이 있을 때만 구간을 기록 (없으면 thread_local 읽기 한 번)
+    class ScopedSpan {
+    public:
+        explicit ScopedSpan(const char* name) : trace_(Trace::current()) {
+            if (trace_) index_ = trace_->beginSpan(name);
+        }
+        ~ScopedSpan() { end(); }
+        ScopedSpan(const ScopedSpan&) = delete;
+        ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+        // 스코프보다 먼저 끝내야 하는 경우 (SQL 문 실행 직후 등)
+        void end() {
+            if (trace_) {
+                trace_->endSpan(index_);
+                trace_ = nullptr;
+            }
+        }
+
+    private:
+        Trace* trace_;
+        int index_ = -1;
+    };
+
+    struct TracePoolTag {
+        static FixedBlockPool& pool();
+    };
+
+    // 추적 생성과 느린 요청 보관/내보내기
+    class Tracer {
+    public:
+        static Tracer& instance();
+
+        void configure(const TracingConfig& config);
+        // 비활성화 상태면 nullptr
+        std::shared_ptr<Trace> start();
+        // 요청 완료 처리, 느린 요청이면 링 버퍼에 보관하고 true
+        bool finish(const std::shared_ptr<Trace>& trace);
+
+        // 보관 중인 느린 요청을 OTLP(OpenTelemetry) JSON 형식으로 변환
+        json exportOtlp();
+        // exportOtlp 결과를 설정된 파일에 기록, 기록한 요청 수 반환 (실패 시 예외)
+        std::size_t exportToFile();
+        json stats();
+
+    private:
+        struct SlowTrace {
+            std::shared_ptr<const Trace> trace;
+            std::array<unsigned char, 16> trace_id;  // 보관할 때만 생성
+        };
+
+        Tracer() = default;
+
+        std::mutex mutex_;
+        TracingConfig config_;
+        std::atomic<bool> enabled_{ false };
+        std::atomic<std::int64_t> slow_threshold_ns_{ 0 };
+        std::atomic<std::uint64_t> next_request_id_{ 1 };
+        std::deque<SlowTrace> slow_;
+        std::uint64_t sampled_ = 0;
+    };
+
+} // namespace game_server
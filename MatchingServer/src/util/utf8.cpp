@@ -0,0 +1,184 @@
+﻿// util/utf8.cpp
+// UTF-8 디코딩 및 문자 분류 구현 파일
+#include "utf8.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GAME_SERVER_UTF8_SSE2 1
+#endif
+
+namespace game_server {
+namespace utf8 {
+
+    namespace {
+
+        // 첫 바이트별 시퀀스 길이와 두 번째 바이트의 허용 범위 (RFC 3629 표 기준)
+        // 두 번째 바이트 범위를 좁혀 overlong(E0, F0), 서로게이트(ED), U+10FFFF 초과(F4)를 거른다.
+        struct LeadInfo {
+            std::uint8_t length = 0;        // 0이면 올 수 없는 첫 바이트
+            std::uint8_t second_low = 0x80;
+            std::uint8_t second_high = 0xBF;
+        };
+
+        constexpr std::array<LeadInfo, 256> makeLeadTable() {
+            std::array<LeadInfo, 256> table{};
+            for (int b = 0x00; b <= 0x7F; ++b) table[b].length = 1;
+            for (int b = 0xC2; b <= 0xDF; ++b) table[b].length = 2;
+            for (int b = 0xE0; b <= 0xEF; ++b) table[b].length = 3;
+            for (int b = 0xF0; b <= 0xF4; ++b) table[b].length = 4;
+            table[0xE0].second_low = 0xA0;
+            table[0xED].second_high = 0x9F;
+            table[0xF0].second_low = 0x90;
+            table[0xF4].second_high = 0x8F;
+            return table;
+        }
+
+        constexpr std::array<unsigned char, 128> makeAsciiClassTable() {
+            std::array<unsigned char, 128> table{};
+            for (int c = '0'; c <= '9'; ++c) table[c] = kAsciiDigit;
+            for (int c = 'A'; c <= 'Z'; ++c) table[c] = kAsciiLetter;
+            for (int c = 'a'; c <= 'z'; ++c) table[c] = kAsciiLetter;
+            table[' '] = kSpace;
+            return table;
+        }
+
+        constexpr std::array<LeadInfo, 256> kLeadTable = makeLeadTable();
+        constexpr std::array<unsigned char, 128> kAsciiClass = makeAsciiClassTable();
+
+        // pos부터 allowed에 속하는 ASCII 문자가 이어지는 끝 위치
+        std::size_t skipAllowedAscii(std::string_view text, std::size_t pos, unsigned allowed) {
+            const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+            const std::size_t size = text.size();
+#ifdef GAME_SERVER_UTF8_SSE2
+            // 부호 있는 비교를 쓰므로 0x80 이상 바이트는 음수가 되어 어느 범위에도 들지 않음
+            const __m128i zero_low = _mm_set1_epi8('0' - 1);
+            const __m128i nine_high = _mm_set1_epi8('9' + 1);
+            const __m128i lower_bit = _mm_set1_epi8(0x20);
+            const __m128i a_low = _mm_set1_epi8('a' - 1);
+            const __m128i z_high = _mm_set1_epi8('z' + 1);
+            const __m128i space = _mm_set1_epi8(' ');
+            while (pos + 16 <= size) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+                __m128i match = _mm_setzero_si128();
+                if (allowed & kAsciiDigit) {
+                    match = _mm_or_si128(match, _mm_and_si128(
+                        _mm_cmpgt_epi8(chunk, zero_low), _mm_cmpgt_epi8(nine_high, chunk)));
+                }
+                if (allowed & kAsciiLetter) {
+                    __m128i folded = _mm_or_si128(chunk, lower_bit);
+                    match = _mm_or_si128(match, _mm_and_si128(
+                        _mm_cmpgt_epi8(folded, a_low), _mm_cmpgt_epi8(z_high, folded)));
+                }
+                if (allowed & kSpace) {
+                    match = _mm_or_si128(match, _mm_cmpeq_epi8(chunk, space));
+                }
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(match));
+                if (mask != 0xFFFF) {
+                    return pos + std::countr_zero(~mask);
+                }
+                pos += 16;
+            }
+#endif
+            while (pos < size && data[pos] < 0x80 && (kAsciiClass[data[pos]] & allowed)) {
+                ++pos;
+            }
+            return pos;
+        }
+    }
+
+    char32_t decode(std::string_view text, std::size_t& pos) {
+        const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+        const std::size_t size = text.size();
+        if (pos >= size) return kInvalid;
+
+        unsigned char lead = data[pos];
+        const LeadInfo& info = kLeadTable[lead];
+        if (info.length == 1) {
+            ++pos;
+            return lead;
+        }
+        if (info.length == 0 || pos + info.length > size) return kInvalid;
+
+        unsigned char second = data[pos + 1];
+        if (second < info.second_low || second > info.second_high) return kInvalid;
+
+        char32_t codePoint = lead & (0xFF >> (info.length + 1));
+        codePoint = (codePoint << 6) | (second & 0x3F);
+        for (std::size_t i = 2; i < info.length; ++i) {
+            unsigned char next = data[pos + i];
+            if ((next & 0xC0) != 0x80) return kInvalid;
+            codePoint = (codePoint << 6) | (next & 0x3F);
+        }
+        pos += info.length;
+        return codePoint;
+    }
+
+    std::size_t asciiPrefixLength(std::string_view text) {
+        const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+        const std::size_t size = text.size();
+        std::size_t pos = 0;
+#ifdef GAME_SERVER_UTF8_SSE2
+        while (pos + 16 <= size) {
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos))));
+            if (mask != 0) {
+                return pos + std::countr_zero(mask);
+            }
+            pos += 16;
+        }
+#else
+        while (pos + 8 <= size) {
+            std::uint64_t word;
+            std::memcpy(&word, data + pos, sizeof(word));
+            if (word & 0x8080808080808080ull) break;
+            pos += 8;
+        }
+#endif
+        while (pos < size && data[pos] < 0x80) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    bool isValid(std::string_view text) {
+        return length(text) != std::string_view::npos;
+    }
+
+    std::size_t length(std::string_view text) {
+        std::size_t count = 0;
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            std::size_t ascii = asciiPrefixLength(text.substr(pos));
+            count += ascii;
+            pos += ascii;
+            if (pos == text.size()) break;
+            if (decode(text, pos) == kInvalid) return std::string_view::npos;
+            ++count;
+        }
+        return count;
+    }
+
+    unsigned classify(char32_t codePoint) {
+        if (codePoint < 0x80) return kAsciiClass[codePoint];
+        if (isHangulSyllable(codePoint)) return kHangulSyllable;
+        return 0;
+    }
+
+    bool consistsOf(std::string_view text, unsigned allowed) {
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            pos = skipAllowedAscii(text, pos, allowed);
+            if (pos == text.size()) break;
+            // 허용되지 않은 ASCII 문자에서 멈춘 경우 decode가 그대로 돌려주므로 classify에서 걸러짐
+            char32_t codePoint = decode(text, pos);
+            if (codePoint == kInvalid || !(classify(codePoint) & allowed)) return false;
+        }
+        return true;
+    }
+
+} // namespace utf8
+} // namespace game_server
@@ -0,0 +1,47 @@
+﻿// util/utf8.h
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+namespace game_server {
+namespace utf8 {
+
+    // 입력 검증용 UTF-8 디코더와 문자 분류
+    // 바이트 분류는 256칸 표로, ASCII 구간은 SSE2(없으면 8바이트 단위)로 한 번에 16바이트씩 확인한다.
+
+    constexpr char32_t kInvalid = 0xFFFFFFFF;
+
+    // 허용 문자 집합 (비트 조합)
+    enum CharSet : unsigned {
+        kAsciiDigit = 1u << 0,        // 0-9
+        kAsciiLetter = 1u << 1,       // A-Z, a-z
+        kSpace = 1u << 2,             // ' ' (U+0020)
+        kHangulSyllable = 1u << 3,    // 완성형 한글 '가'(U+AC00) ~ '힣'(U+D7A3)
+        kAsciiAlnum = kAsciiDigit | kAsciiLetter
+    };
+
+    // text[pos]부터 코드 포인트 하나를 읽고 pos를 다음 문자로 이동
+    // overlong, 서로게이트(U+D800~U+DFFF), U+10FFFF 초과, 잘린 시퀀스는 kInvalid (pos는 이동하지 않음)
+    char32_t decode(std::string_view text, std::size_t& pos);
+
+    // 전체가 올바른 UTF-8인지
+    bool isValid(std::string_view text);
+
+    // 코드 포인트 수, 올바른 UTF-8이 아니면 npos
+    std::size_t length(std::string_view text);
+
+    // 앞에서부터 ASCII(0x00~0x7F) 바이트가 이어지는 길이
+    std::size_t asciiPrefixLength(std::string_view text);
+
+    // 코드 포인트가 속한 집합 (어느 집합에도 속하지 않으면 0)
+    unsigned classify(char32_t codePoint);
+
+    // 올바른 UTF-8이고 모든 문자가 allowed 집합에 속하는지 (빈 문자열은 true)
+    bool consistsOf(std::string_view text, unsigned allowed);
+
+    constexpr bool isHangulSyllable(char32_t codePoint) {
+        return codePoint >= 0xAC00 && codePoint <= 0xD7A3;
+    }
+
+} // namespace utf8
+} // namespace game_server
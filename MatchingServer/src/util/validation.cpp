@@ -0,0 +1,79 @@
+﻿// util/validation.cpp
+// 사용자 입력(아이디, 닉네임, 방 이름) 검증 구현 파일
+#include "validation.h"
+#include "utf8.h"
+
+namespace game_server {
+
+    // 사용자 이름 유효성 검증 함수
+    bool isValidUserName(const std::string& name) {
+        // 빈 이름은 유효하지 않음
+        if (name.empty()) {
+            return false;
+        }
+
+        // 30바이트 이내인지 확인
+        if (name.size() > 30) {
+            return false;
+        }
+
+        // "mirror" 단어가 포함되어 있는지 확인 (대소문자 구분 없이)
+        if (name.find("mirror") != std::string::npos) {
+            return false;
+        }
+
+        // 이메일 형식인지 확인
+        bool isEmail = (name.find('@') != std::string::npos) &&
+            (name.find('.', name.find('@')) != std::string::npos);
+
+        // 이메일이 아닌 경우 영어, 숫자만 포함하는지 확인
+        if (!isEmail) {
+            return utf8::consistsOf(name, utf8::kAsciiAlnum);
+        }
+        else {
+            // 이메일인 경우 추가 검증 (간단한 이메일 형식 검사)
+            // 여기서는 표준적인 이메일 문자들(영어, 숫자, 일부 특수문자) 허용
+            for (unsigned char c : name) {
+                if ((c >= 'A' && c <= 'Z') ||
+                    (c >= 'a' && c <= 'z') ||
+                    (c >= '0' && c <= '9') ||
+                    (c == '@') || (c == '.') ||
+                    (c == '_') || (c == '-') || (c == '+')) {
+                    continue;
+                }
+
+                // 이메일에 한글은 허용하지 않음 (IDN 이메일 제외)
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool isValidNickName(const std::string& str) {
+        // 한글 완성형(가-힣), 영어(A-Za-z), 숫자(0-9)만 허용
+        if (str.empty() || str.size() > 24) return false;
+        return utf8::consistsOf(str, utf8::kAsciiAlnum | utf8::kHangulSyllable);
+    }
+
+    // 방 이름 유효성 검증 함수
+    bool isValidRoomName(const std::string& name) {
+        // 빈 이름은 유효하지 않음
+        if (name.empty()) {
+            return false;
+        }
+
+        // 40바이트(UTF-8 표준) 이내인지 확인
+        if (name.size() > 40) {
+            return false;
+        }
+
+        // 마지막 '$' 한 글자는 허용 (나머지는 영어, 숫자, 공백, 한글 완성형만)
+        std::string_view body = name;
+        if (body.back() == '$') {
+            body.remove_suffix(1);
+        }
+        return utf8::consistsOf(body, utf8::kAsciiAlnum | utf8::kSpace | utf8::kHangulSyllable);
+    }
+
+} // namespace game_server
@@ -0,0 +1,16 @@
+﻿// util/validation.h
+#pragma once
+#include <string>
+
+namespace game_server {
+
+    // 서비스 계층의 입력 검증 함수 (벤치마크에서도 직접 호출)
+
+    // 영문/숫자 30바이트 이내 또는 이메일 형식, "mirror" 포함 불가
+    bool isValidUserName(const std::string& name);
+    // 한글 완성형(가-힣), 영문, 숫자 24바이트 이내
+    bool isValidNickName(const std::string& str);
+    // 영문, 숫자, 공백, 한글 완성형 40바이트 이내 (마지막 한 글자는 '$' 허용)
+    bool isValidRoomName(const std::string& name);
+
+} // namespace game_server
@@ -0,0 +1,89 @@
+﻿// util/worker_pool.cpp
+// 워커 스레드 풀 구현 파일
+// 제한된 대기열과 고정된 수의 스레드로 블로킹 작업을 io 스레드 밖에서 처리
+#include "worker_pool.h"
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    WorkerPool::WorkerPool(std::string name, std::size_t threads, std::size_t max_queue)
+        : name_(std::move(name)),
+        max_queue_(max_queue)
+    {
+        if (threads < 1) threads = 1;
+        threads_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back([this]() { worker_loop(); });
+        }
+        spdlog::info("{} 워커 풀 시작 (스레드 {}개, 대기열 상한 {}개)", name_, threads, max_queue_);
+    }
+
+    WorkerPool::~WorkerPool() {
+        stop();
+    }
+
+    bool WorkerPool::submit(Job job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_ || jobs_.size() >= max_queue_) {
+                rejected_++;
+                return false;
+            }
+            jobs_.push_back(std::move(job));
+            if (jobs_.size() > max_depth_) max_depth_ = jobs_.size();
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+    void WorkerPool::stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& thread : threads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        spdlog::info("{} 워커 풀 종료: {}", name_, stats().dump());
+    }
+
+    std::size_t WorkerPool::queueDepth() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return jobs_.size();
+    }
+
+    nlohmann::json WorkerPool::stats() {
+        return {
+            {"queueDepth", queueDepth()},
+            {"maxQueueDepth", max_depth_.load()},
+            {"completed", completed_.load()},
+            {"rejected", rejected_.load()}
+        };
+    }
+
+    void WorkerPool::worker_loop() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;   // 종료 중이고 남은 작업 없음
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+
+            try {
+                job();
+            }
+            catch (const std::exception& e) {
+                spdlog::error("{} 워커 작업 중 예외 발생: {}", name_, e.what());
+            }
+            completed_++;
+        }
+    }
+
+} // namespace game_server
@@ -0,0 +1,50 @@
+﻿// util/worker_pool.h
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    // io 스레드를 막으면 안 되는 무거운 작업(비밀번호 해시 등)을 처리하는 고정 크기 스레드 풀
+    // 대기열 길이에 상한이 있어 과부하 시 작업을 거절하고, 호출자는 즉시 오류를 응답한다.
+    class WorkerPool {
+    public:
+        using Job = std::function<void()>;
+
+        WorkerPool(std::string name, std::size_t threads, std::size_t max_queue);
+        ~WorkerPool();
+
+        // 대기열이 가득 찼거나 종료 중이면 false
+        bool submit(Job job);
+
+        // 새 작업을 받지 않고, 대기 중인 작업을 모두 처리한 뒤 스레드 종료
+        void stop();
+
+        std::size_t queueDepth();
+        nlohmann::json stats();
+
+    private:
+        void worker_loop();
+
+        std::string name_;
+        std::size_t max_queue_;
+        std::deque<Job> jobs_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_ = false;
+        std::vector<std::thread> threads_;
+
+        std::atomic<std::uint64_t> completed_{ 0 };
+        std::atomic<std::uint64_t> rejected_{ 0 };
+        std::atomic<std::size_t> max_depth_{ 0 };
+    };
+
+} // namespace game_server
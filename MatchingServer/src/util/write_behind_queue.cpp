@@ -0,0 +1,242 @@
+﻿// util/write_behind_queue.cpp
+// 지연 반영 큐 구현 파일
+// 요청 지연 시간에서 작은 트랜잭션 커밋을 빼기 위해 비핵심 갱신을 주기적으로 일괄 반영
+#include "write_behind_queue.h"
+#include <algorithm>
+#include <spdlog/fmt/ranges.h>
+#include <spdlog/spdlog.h>
+
+namespace game_server {
+
+    using json = nlohmann::json;
+
+    WriteBehindConfig WriteBehindConfig::fromJson(const json& config) {
+        WriteBehindConfig result;
+        if (!config.is_object()) return result;
+
+        result.enabled = config.value("enabled", result.enabled);
+        result.flush_interval = std::chrono::milliseconds(
+            config.value("flushIntervalMs", static_cast<int>(result.flush_interval.count())));
+        result.batch_size = config.value("batchSize", result.batch_size);
+        result.max_pending = config.value("maxPending", result.max_pending);
+        result.shutdown_retries = config.value("shutdownRetries", result.shutdown_retries);
+        result.shutdown_retry_delay = std::chrono::milliseconds(
+            config.value("shutdownRetryDelayMs", static_cast<int>(result.shutdown_retry_delay.count())));
+        if (result.flush_interval.count() < 1) result.flush_interval = std::chrono::milliseconds(1);
+        if (result.batch_size < 1) result.batch_size = 1;
+        return result;
+    }
+
+    WriteBehindQueue::WriteBehindQueue(const WriteBehindConfig& config)
+        : config_(config)
+    {
+        if (config_.enabled) {
+            flush_thread_ = std::thread([this]() { flush_loop(); });
+            spdlog::info("지연 반영 큐 활성화 (주기 {}ms, 배치 {}건, 대기 상한 {}건)",
+                config_.flush_interval.count(), config_.batch_size, config_.max_pending);
+        }
+    }
+
+    WriteBehindQueue::~WriteBehindQueue() {
+        stop();
+    }
+
+    void WriteBehindQueue::registerKind(const std::string& kind, FlushHandler handler) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        kinds_[kind].handler = std::move(handler);
+    }
+
+    bool WriteBehindQueue::enqueue(const std::string& kind, int id) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!config_.enabled || stopping_) return false;
+
+            auto it = kinds_.find(kind);
+            if (it == kinds_.end()) return false;
+
+            // 이미 대기 중인 ID는 한 번만 반영하면 되므로 상한과 관계없이 수락
+            if (it->second.pending.count(id)) return true;
+            if (pending_total_ >= config_.max_pending) {
+                overflows_++;
+                return false;
+            }
+
+            it->second.pending.insert(id);
+            pending_total_++;
+        }
+        return true;
+    }
+
+    void WriteBehindQueue::flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        flush_all(lock);
+    }
+
+    // 새 항목을 받지 않고 반영 스레드를 멈춘 뒤 남은 항목을 모두 반영
+    void WriteBehindQueue::stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (flush_thread_.joinable()) {
+            flush_thread_.join();
+        }
+        flush();
+
+        // 실패한 묶음은 다시 대기열에 들어가지만 이후 주기 반영이 없으므로 여기서 간격을 늘려 가며 재시도
+        std::chrono::milliseconds delay = config_.shutdown_retry_delay;
+        for (int attempt = 1; attempt <= config_.shutdown_retries; ++attempt) {
+            std::size_t pending;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pending = pending_total_;
+            }
+            if (pending == 0) break;
+
+            spdlog::warn("지연 반영 큐 종료 중 {}건 반영 실패, {}ms 후 다시 시도 ({}/{})",
+                pending, delay.count(), attempt, config_.shutdown_retries);
+            std::this_thread::sleep_for(delay);
+            delay *= 2;
+            flush();
+        }
+        drop_pending();
+
+        spdlog::info("지연 반영 큐 종료: {}", stats().dump());
+    }
+
+    // 종료 재시도 후에도 남은 항목은 반영할 방법이 없으므로 ID를 남기고 버림 (수동 복구용)
+    void WriteBehindQueue::drop_pending() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [name, kind] : kinds_) {
+            if (kind.pending.empty()) continue;
+            std::vector<int> ids(kind.pending.begin(), kind.pending.end());
+            std::sort(ids.begin(), ids.end());
+            spdlog::error("지연 반영 {} {}건을 반영하지 못하고 버립니다, ID : {}", name, ids.size(), fmt::join(ids, ","));
+            kind.dropped += ids.size();
+            kind.pending.clear();
+        }
+        pending_total_ = 0;
+    }
+
+    void WriteBehindQueue::flush_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            cv_.wait_for(lock, config_.flush_interval, [this]() { return stopping_; });
+            if (stopping_) break;
+            flush_all(lock);
+        }
+    }
+
+    // 종류별로 대기 목록을 꺼내 batch_size 단위로 반영, 실패한 묶음은 다시 대기열에 넣음
+    // 호출 시 lock을 잡고 있어야 하며, DB 작업 동안에는 lock을 풀어 enqueue를 막지 않음
+    void WriteBehindQueue::flush_all(std::unique_lock<std::mutex>& lock) {
+        std::map<std::string, std::vector<int>> batches;
+        for (auto& [name, kind] : kinds_) {
+            if (kind.pending.empty()) continue;
+            batches[name].assign(kind.pending.begin(), kind.pending.end());
+            pending_total_ -= kind.pending.size();
+            kind.pending.clear();
+        }
+        if (batches.empty()) return;
+
+        lock.unlock();
+        std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+        auto started_at = std::chrono::steady_clock::now();
+
+        for (auto& [name, ids] : batches) {
+            FlushHandler handler;
+            {
+                std::lock_guard<std::mutex> kinds_lock(mutex_);
+                handler = kinds_[name].handler;
+            }
+
+            std::vector<int> failed;
+            std::uint64_t flushed = 0;
+            std::uint64_t statements = 0;
+            for (std::size_t offset = 0; offset < ids.size(); offset += config_.batch_size) {
+                std::size_t end = std::min(ids.size(), offset + config_.batch_size);
+                std::vector<int> chunk(ids.begin() + offset, ids.begin() + end);
+
+                bool ok = false;
+                try {
+                    ok = handler && handler(chunk);
+                }
+                catch (const std::exception& e) {
+                    spdlog::error("지연 반영 {} 처리 중 예외 발생: {}", name, e.what());
+                }
+
+                statements++;
+                if (ok) {
+                    flushed += chunk.size();
+                }
+                else {
+                    failed.insert(failed.end(), chunk.begin(), chunk.end());
+                }
+            }
+
+            std::lock_guard<std::mutex> kinds_lock(mutex_);
+            Kind& kind = kinds_[name];
+            kind.flushed += flushed;
+            kind.statements += statements;
+            if (!failed.empty()) {
+                kind.failures++;
+                spdlog::error("지연 반영 {} {}건 실패, 다음 주기에 다시 시도합니다", name, failed.size());
+
+                // 상한 안에서만 다시 넣고, 넘치는 항목은 버림 (last_login 등 유실되어도 되는 갱신만 사용)
+                for (int id : failed) {
+                    if (pending_total_ >= config_.max_pending) {
+                        overflows_++;
+                        continue;
+                    }
+                    if (kind.pending.insert(id).second) {
+                        pending_total_++;
+                    }
+                }
+            }
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started_at).count();
+        last_flush_ms_ = elapsed;
+        if (elapsed > max_flush_ms_) max_flush_ms_ = elapsed;
+        spdlog::debug("지연 반영 완료, 소요 시간 : {}ms", elapsed);
+
+        lock.lock();
+    }
+
+    json WriteBehindQueue::stats() {
+        json result = {
+            {"pending", 0},
+            {"overflows", overflows_.load()},
+            {"lastFlushMs", last_flush_ms_.load()},
+            {"maxFlushMs", max_flush_ms_.load()},
+            {"kinds", json::object()}
+        };
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        result["pending"] = pending_total_;
+        for (const auto& [name, kind] : kinds_) {
+            result["kinds"][name] = {
+                {"pending", kind.pending.size()},
+                {"flushed", kind.flushed},
+                {"statements", kind.statements},
+                {"failures", kind.failures},
+                {"dropped", kind.dropped}
+            };
+        }
+        return result;
+    }
+
+    std::string WriteBehindQueue::toArrayLiteral(const std::vector<int>& ids) {
+        std::string literal = "{";
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (i > 0) literal += ',';
+            literal += std::to_string(ids[i]);
+        }
+        literal += '}';
+        return literal;
+    }
+
+} // namespace game_server
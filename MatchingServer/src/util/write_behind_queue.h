@@ -0,0 +1,84 @@
+﻿// util/write_behind_queue.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+
+    // 지연 반영 설정 (config.json의 "writeBehind" 섹션)
+    struct WriteBehindConfig {
+        bool enabled = true;
+        std::chrono::milliseconds flush_interval{ 500 };   // 주기적 반영 간격
+        std::size_t batch_size = 500;                      // 한 문장에 담는 최대 ID 수
+        std::size_t max_pending = 50000;                   // 전체 대기 상한, 넘으면 호출자가 동기로 반영
+        int shutdown_retries = 3;                          // 종료 시 마지막 반영이 실패하면 다시 시도하는 횟수
+        std::chrono::milliseconds shutdown_retry_delay{ 200 };   // 첫 재시도 전 대기, 시도마다 두 배로 늘림
+
+        static WriteBehindConfig fromJson(const nlohmann::json& config);
+    };
+
+    // 요청 경로에서 바로 커밋할 필요가 없는 갱신(last_login, 게임 완료 처리 등)을 모아
+    // 종류별로 다중 행 UPDATE 한 번에 반영하는 큐
+    // 같은 종류의 같은 ID는 한 번만 반영되며, 종료 시 남은 항목을 모두 반영한다.
+    class WriteBehindQueue {
+    public:
+        // 모아 둔 ID 목록을 반영, 실패하면 false (다음 주기에 재시도)
+        using FlushHandler = std::function<bool(const std::vector<int>& ids)>;
+
+        explicit WriteBehindQueue(const WriteBehindConfig& config);
+        ~WriteBehindQueue();
+
+        // 리포지토리 생성 시 종류별 반영 함수 등록
+        void registerKind(const std::string& kind, FlushHandler handler);
+
+        // 대기열에 추가, 비활성화 또는 상한 초과 시 false를 반환하므로 호출자가 직접 반영해야 함
+        bool enqueue(const std::string& kind, int id);
+
+        // 대기 중인 항목을 모두 반영 (정상 종료 시 호출)
+        void flush();
+        // 반영 스레드를 멈추고 남은 항목을 반영, 실패하면 shutdown_retries번 재시도한 뒤 남은 ID를 오류 로그로 남기고 버림
+        void stop();
+
+        nlohmann::json stats();
+
+        // ID 목록을 PostgreSQL 정수 배열 리터럴({1,2,3})로 변환, "= ANY($1::int[])"에 사용
+        static std::string toArrayLiteral(const std::vector<int>& ids);
+
+    private:
+        struct Kind {
+            FlushHandler handler;
+            std::unordered_set<int> pending;
+            std::uint64_t flushed = 0;
+            std::uint64_t statements = 0;
+            std::uint64_t failures = 0;
+            std::uint64_t dropped = 0;     // 종료 시 재시도 후에도 반영하지 못해 버린 수
+        };
+
+        void flush_loop();
+        void flush_all(std::unique_lock<std::mutex>& lock);
+        void drop_pending();
+
+        WriteBehindConfig config_;
+        std::map<std::string, Kind> kinds_;
+        std::size_t pending_total_ = 0;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::mutex flush_mutex_;          // 주기 반영과 flush() 호출이 동시에 DB에 쓰지 않도록 직렬화
+        bool stopping_ = false;
+        std::atomic<std::uint64_t> overflows_{ 0 };
+        std::atomic<std::int64_t> last_flush_ms_{ 0 };
+        std::atomic<std::int64_t> max_flush_ms_{ 0 };
+        std::thread flush_thread_;
+    };
+
+} // namespace game_server
@@ -0,0 +1,58 @@
+﻿// tools/load_generator/latency_recorder.cpp
+// 지연 시간 히스토그램 구현 파일
+#include "latency_recorder.h"
+#include <bit>
+#include <cmath>
+
+namespace load_generator {
+
+    std::size_t LatencyRecorder::bucketOf(std::uint64_t micros) {
+        if (micros < kLinear) return static_cast<std::size_t>(micros);
+        // 상위 7비트(64~127)만 남기도록 이동한 횟수가 구간 번호
+        unsigned shift = static_cast<unsigned>(std::bit_width(micros)) - 7;
+        std::size_t bucket = kLinear + (shift - 1) * kSubBuckets + static_cast<std::size_t>((micros >> shift) - kSubBuckets);
+        return bucket < kBuckets ? bucket : kBuckets - 1;
+    }
+
+    std::uint64_t LatencyRecorder::valueOf(std::size_t bucket) {
+        if (bucket < kLinear) return bucket;
+        std::size_t offset = bucket - kLinear;
+        unsigned shift = static_cast<unsigned>(offset / kSubBuckets) + 1;
+        std::uint64_t low = (static_cast<std::uint64_t>(offset % kSubBuckets) + kSubBuckets) << shift;
+        return low + ((std::uint64_t{ 1 } << shift) >> 1);
+    }
+
+    void LatencyRecorder::record(std::uint64_t micros) {
+        buckets_[bucketOf(micros)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(micros, std::memory_order_relaxed);
+
+        std::uint64_t current = max_.load(std::memory_order_relaxed);
+        while (micros > current && !max_.compare_exchange_weak(current, micros, std::memory_order_relaxed)) {
+        }
+    }
+
+    double LatencyRecorder::mean() const {
+        std::uint64_t total = count();
+        return total ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / total : 0.0;
+    }
+
+    std::uint64_t LatencyRecorder::percentile(double quantile) const {
+        std::uint64_t total = count();
+        if (total == 0) return 0;
+
+        // 순위 ceil(q * n)번째 값이 속한 구간 (최댓값보다 크게 보고하지 않음)
+        std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(quantile * total));
+        if (rank == 0) rank = 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                std::uint64_t value = valueOf(i);
+                return value < max() ? value : max();
+            }
+        }
+        return max();
+    }
+
+} // namespace load_generator
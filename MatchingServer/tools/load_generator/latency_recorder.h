@@ -0,0 +1,37 @@
+﻿// tools/load_generator/latency_recorder.h
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace load_generator {
+
+    // 마이크로초 단위 지연 시간 히스토그램 (여러 io 스레드에서 락 없이 기록)
+    // 128us 미만은 1us 단위, 그 이상은 2의 거듭제곱 구간마다 64칸으로 나눠 상대 오차 1.6% 이내로 백분위를 계산한다.
+    class LatencyRecorder {
+    public:
+        void record(std::uint64_t micros);
+
+        std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+        std::uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+        double mean() const;
+        // quantile은 0~1 (0.999 = p999), 기록이 없으면 0
+        std::uint64_t percentile(double quantile) const;
+
+    private:
+        static constexpr std::size_t kLinear = 128;
+        static constexpr std::size_t kSubBuckets = 64;
+        static constexpr std::size_t kBuckets = kLinear + 58 * kSubBuckets;
+
+        static std::size_t bucketOf(std::uint64_t micros);
+        // 구간의 중간 값 (백분위 보고용)
+        static std::uint64_t valueOf(std::size_t bucket);
+
+        std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+        std::atomic<std::uint64_t> count_{ 0 };
+        std::atomic<std::uint64_t> sum_{ 0 };
+        std::atomic<std::uint64_t> max_{ 0 };
+    };
+
+} // namespace load_generator
@@ -0,0 +1,413 @@
+﻿// tools/load_generator/load_client.cpp
+// 가상 사용자 및 부하 클라이언트 구현 파일
+// 핸드셰이크 → 회원가입 → 로그인 후 시나리오 비율에 따라 요청을 보내고 응답까지의 지연 시간을 기록
+#include "load_client.h"
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+namespace load_generator {
+
+    namespace asio = boost::asio;
+    using tcp = asio::ip::tcp;
+
+    namespace {
+
+        const char* const kActions[] = {
+            "handshake", "register", "login", "listRooms", "createRoom", "joinRoom", "exitRoom", "alivePing", "chat"
+        };
+
+        std::mt19937_64& randomEngine() {
+            thread_local std::mt19937_64 engine(std::random_device{}());
+            return engine;
+        }
+
+        std::uint64_t elapsedMicros(std::chrono::steady_clock::time_point since) {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - since).count());
+        }
+
+    } // namespace
+
+    double ReconnectStats::acceptsPerSecond() const {
+        std::uint64_t micros = last_accept_micros.load(std::memory_order_relaxed);
+        return micros == 0 ? 0.0 : accept.count() / (micros / 1e6);
+    }
+
+    LoadStats::LoadStats() {
+        for (const char* name : kActions) {
+            auto stats = std::make_unique<ActionStats>();
+            stats->name = name;
+            actions_.push_back(std::move(stats));
+        }
+    }
+
+    ActionStats& LoadStats::action(std::string_view name) {
+        for (auto& stats : actions_) {
+            if (stats->name == name) return *stats;
+        }
+        throw std::invalid_argument("집계하지 않는 액션입니다: " + std::string(name));
+    }
+
+    std::uint64_t LoadStats::totalResponses() const {
+        std::uint64_t total = 0;
+        for (const auto& stats : actions_) total += stats->latency.count();
+        return total;
+    }
+
+    std::uint64_t LoadStats::totalErrors() const {
+        std::uint64_t total = 0;
+        for (const auto& stats : actions_) total += stats->errors.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    std::uint64_t LoadStats::totalTimeouts() const {
+        std::uint64_t total = 0;
+        for (const auto& stats : actions_) total += stats->timeouts.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // 연결 하나를 쓰는 가상 사용자, 한 번에 요청 하나만 보내고 응답을 받은 뒤 대기 시간을 두고 다음 요청을 보냄
+    // reconnecting이면 재접속 폭주로 다시 접속하는 사용자로, 연결/수락 지연 시간을 ReconnectStats에 기록
+    class VirtualUser : public std::enable_shared_from_this<VirtualUser> {
+    public:
+        VirtualUser(LoadClient& client, std::size_t index, bool reconnecting = false)
+            : client_(client),
+            index_(index),
+            reconnecting_(reconnecting),
+            strand_(asio::make_strand(client.io_)),
+            socket_(strand_),
+            timer_(strand_),
+            timeout_timer_(strand_),
+            user_name_(client.config_.user_prefix + std::to_string(index)),
+            mix_([&client]() {
+                std::vector<double> weights;
+                for (const auto& entry : client.config_.mix) weights.push_back(entry.second);
+                return std::discrete_distribution<std::size_t>(weights.begin(), weights.end());
+            }()),
+            think_(client.config_.rate_per_user)
+        {
+        }
+
+        void start(std::chrono::milliseconds delay) {
+            auto self(shared_from_this());
+            timer_.expires_after(delay);
+            timer_.async_wait([this, self](boost::system::error_code ec) {
+                if (!ec && !client_.stopping_) connect();
+                });
+        }
+
+        void close() {
+            auto self(shared_from_this());
+            asio::post(strand_, [this, self]() { shutdown(false); });
+        }
+
+    private:
+        void connect() {
+            const ScenarioConfig& config = client_.config_;
+            boost::system::error_code ec;
+            tcp::endpoint remote(asio::ip::make_address(config.host, ec), config.port);
+            if (!ec) socket_.open(remote.protocol(), ec);
+            if (!ec && !config.bind_base.empty()) {
+                // 서버의 IP당 연결 제한을 피하기 위해 사용자마다 다른 주소로 바인드
+                // 재접속하는 사용자는 이전 연결의 종료를 서버가 처리하기 전에 접속할 수 있으므로 users만큼 뒤의 주소를 씀
+                auto base = asio::ip::make_address_v4(config.bind_base, ec);
+                if (!ec) {
+                    std::size_t offset = index_ + (reconnecting_ ? config.users : 0);
+                    socket_.bind(tcp::endpoint(asio::ip::address_v4(base.to_uint() + static_cast<std::uint32_t>(offset)), 0), ec);
+                }
+            }
+            if (ec) {
+                client_.stats_.connect_failures.fetch_add(1, std::memory_order_relaxed);
+                if (reconnecting_) client_.stats_.reconnect.failures.fetch_add(1, std::memory_order_relaxed);
+                shutdown(false);
+                return;
+            }
+
+            auto self(shared_from_this());
+            connect_started_ = std::chrono::steady_clock::now();
+            socket_.async_connect(remote, [this, self](boost::system::error_code ec) {
+                if (ec) {
+                    if (ec != asio::error::operation_aborted) {
+                        client_.stats_.connect_failures.fetch_add(1, std::memory_order_relaxed);
+                        if (reconnecting_) client_.stats_.reconnect.failures.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    shutdown(false);
+                    return;
+                }
+                if (reconnecting_) client_.stats_.reconnect.connect.record(elapsedMicros(connect_started_));
+                connected_ = true;
+                client_.connected_.fetch_add(1, std::memory_order_relaxed);
+                read_loop();
+
+                // 핸드셰이크 응답에는 action이 없음
+                send("handshake", { {"version", client_.config_.version} }, "");
+                });
+        }
+
+        void read_loop() {
+            auto self(shared_from_this());
+            socket_.async_read_some(asio::buffer(read_buffer_), [this, self](boost::system::error_code ec, std::size_t length) {
+                if (ec) {
+                    shutdown(!client_.stopping_);
+                    return;
+                }
+                splitter_.feed(read_buffer_.data(), length, [this](std::string_view text) {
+                    json message = json::parse(text, nullptr, false);
+                    if (!message.is_discarded()) on_message(message);
+                    });
+                if (socket_.is_open()) read_loop();
+                });
+        }
+
+        void send(const char* action, json request, const char* expected) {
+            action_ = action;
+            if (action_ != "handshake") request["action"] = action_;
+            expected_ = expected;
+            out_ = request.dump();
+            waiting_ = true;
+            sent_at_ = std::chrono::steady_clock::now();
+
+            auto self(shared_from_this());
+            timeout_timer_.expires_after(client_.config_.request_timeout);
+            timeout_timer_.async_wait([this, self](boost::system::error_code ec) {
+                if (ec || !waiting_) return;
+                // 늦게 온 응답이 다음 요청과 섞이지 않도록 연결을 끊음
+                client_.stats_.action(action_).timeouts.fetch_add(1, std::memory_order_relaxed);
+                if (reconnecting_ && action_ == "handshake") {
+                    client_.stats_.reconnect.failures.fetch_add(1, std::memory_order_relaxed);
+                }
+                shutdown(false);
+                });
+
+            asio::async_write(socket_, asio::buffer(out_), [this, self](boost::system::error_code ec, std::size_t) {
+                if (ec) shutdown(!client_.stopping_);
+                });
+        }
+
+        // 기다리던 요청의 응답인지 확인 (브로드캐스트는 무시)
+        bool matches(const json& message) const {
+            if (!message.contains("action")) return true;   // 오류 응답 일부와 핸드셰이크 응답에는 action이 없음
+            const auto& action = message["action"];
+            if (!action.is_string() || action.get_ref<const std::string&>() != expected_) return false;
+            // 채팅은 다른 사용자의 채팅과 구분하기 위해 보낸 내용을 확인
+            if (expected_ == "chat" && !message.contains("status")) {
+                return message.value("message", "") == chat_text_;
+            }
+            return true;
+        }
+
+        void on_message(const json& message) {
+            if (!waiting_ || !matches(message)) return;
+            waiting_ = false;
+            timeout_timer_.cancel();
+
+            ActionStats& stats = client_.stats_.action(action_);
+            stats.latency.record(elapsedMicros(sent_at_));
+            // 채팅 브로드캐스트에는 status가 없음
+            bool success = message.value("status", expected_ == "chat" ? "success" : "") == "success";
+            if (!success) stats.errors.fetch_add(1, std::memory_order_relaxed);
+
+            if (action_ == "handshake") {
+                if (reconnecting_) record_accept(success);
+                if (!success) {
+                    shutdown(false);
+                    return;
+                }
+                // 재접속하는 사용자는 이미 가입했으므로 바로 로그인
+                if (client_.config_.register_users && !reconnecting_) {
+                    send("register", { {"userName", user_name_}, {"password", client_.config_.password} }, "register");
+                }
+                else {
+                    send_login();
+                }
+                return;
+            }
+            if (action_ == "register") {
+                // 이전 실행에서 만든 계정이면 오류 응답이 오므로 결과와 관계없이 로그인
+                send_login();
+                return;
+            }
+            if (action_ == "login") {
+                if (!success) {
+                    client_.stats_.login_failures.fetch_add(1, std::memory_order_relaxed);
+                    shutdown(false);
+                    return;
+                }
+                schedule_next();
+                return;
+            }
+
+            if (action_ == "listRooms" && success && message.contains("rooms")) {
+                rooms_.clear();
+                for (const auto& room : message["rooms"]) {
+                    if (room.value("currentPlayers", 0) < room.value("maxPlayers", 0)) {
+                        rooms_.push_back(room.value("roomId", 0));
+                    }
+                }
+            }
+            else if ((action_ == "createRoom" || action_ == "joinRoom") && success) {
+                in_room_ = true;
+            }
+            else if (action_ == "exitRoom") {
+                in_room_ = false;
+            }
+            schedule_next();
+        }
+
+        void record_accept(bool success) {
+            ReconnectStats& reconnect = client_.stats_.reconnect;
+            if (!success) {
+                reconnect.failures.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            auto now = std::chrono::steady_clock::now();
+            reconnect.accept.record(elapsedMicros(connect_started_));
+            auto since_start = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - reconnect.started).count());
+            std::uint64_t last = reconnect.last_accept_micros.load(std::memory_order_relaxed);
+            while (since_start > last &&
+                !reconnect.last_accept_micros.compare_exchange_weak(last, since_start, std::memory_order_relaxed)) {
+            }
+        }
+
+        void send_login() {
+            send("login", { {"userName", user_name_}, {"password", client_.config_.password} }, "login");
+        }
+
+        void schedule_next() {
+            if (client_.stopping_) return;
+            auto self(shared_from_this());
+            timer_.expires_after(std::chrono::microseconds(static_cast<long long>(think_(randomEngine()) * 1e6)));
+            timer_.async_wait([this, self](boost::system::error_code ec) {
+                if (!ec && !client_.stopping_ && socket_.is_open()) send_next();
+                });
+        }
+
+        void send_next() {
+            // 방에 들어간 사용자는 다음 요청으로 항상 퇴장 (대기실 상태를 유지해야 채팅/방 목록이 의미 있음)
+            if (in_room_) {
+                send("exitRoom", json::object(), "exitRoom");
+                return;
+            }
+
+            const std::string& action = client_.config_.mix[mix_(randomEngine())].first;
+            if (action == "createRoom") {
+                send("createRoom", { {"roomName", "load" + std::to_string(index_)}, {"maxPlayers", 8} }, "createRoom");
+            }
+            else if (action == "joinRoom" && !rooms_.empty()) {
+                std::uniform_int_distribution<std::size_t> pick(0, rooms_.size() - 1);
+                send("joinRoom", { {"roomId", rooms_[pick(randomEngine())]} }, "joinRoom");
+            }
+            else if (action == "alivePing") {
+                send("alivePing", json::object(), "refreshSession");
+            }
+            else if (action == "chat") {
+                chat_text_ = "load" + std::to_string(index_) + "-" + std::to_string(++chat_seq_);
+                send("chat", { {"message", chat_text_} }, "chat");
+            }
+            else {
+                // 참가할 방을 모르면 방 목록부터 조회
+                send("listRooms", json::object(), "listRooms");
+            }
+        }
+
+        void shutdown(bool unexpected) {
+            if (closed_) return;
+            closed_ = true;
+            waiting_ = false;
+            if (unexpected) client_.stats_.disconnects.fetch_add(1, std::memory_order_relaxed);
+            if (connected_) client_.connected_.fetch_sub(1, std::memory_order_relaxed);
+
+            boost::system::error_code ignored;
+            timer_.cancel();
+            timeout_timer_.cancel();
+            socket_.shutdown(tcp::socket::shutdown_both, ignored);
+            socket_.close(ignored);
+        }
+
+        LoadClient& client_;
+        std::size_t index_;
+        bool reconnecting_;
+        asio::strand<asio::io_context::executor_type> strand_;
+        tcp::socket socket_;
+        asio::steady_timer timer_;          // 램프업 지연, 요청 사이 대기
+        asio::steady_timer timeout_timer_;
+        std::array<char, 8192> read_buffer_;
+        MessageSplitter splitter_;
+
+        std::string user_name_;
+        std::discrete_distribution<std::size_t> mix_;
+        std::exponential_distribution<double> think_;
+
+        std::string out_;
+        std::string action_;
+        std::string expected_;
+        std::string chat_text_;
+        std::uint64_t chat_seq_ = 0;
+        std::chrono::steady_clock::time_point sent_at_;
+        std::chrono::steady_clock::time_point connect_started_;
+        std::vector<int> rooms_;
+        bool waiting_ = false;
+        bool in_room_ = false;
+        bool connected_ = false;
+        bool closed_ = false;
+    };
+
+    LoadClient::LoadClient(const ScenarioConfig& config, LoadStats& stats)
+        : config_(config), stats_(stats)
+    {
+    }
+
+    LoadClient::~LoadClient() {
+        close();
+    }
+
+    void LoadClient::start() {
+        work_.emplace(asio::make_work_guard(io_));
+        for (std::size_t i = 0; i < config_.threads; ++i) {
+            threads_.emplace_back([this]() { io_.run(); });
+        }
+
+        users_.reserve(config_.users);
+        for (std::size_t i = 0; i < config_.users; ++i) {
+            auto user = std::make_shared<VirtualUser>(*this, i);
+            auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(config_.ramp_up * i / config_.users);
+            user->start(delay);
+            users_.push_back(std::move(user));
+        }
+    }
+
+    void LoadClient::reconnectAll() {
+        ReconnectStats& reconnect = stats_.reconnect;
+        reconnect.users = users_.size();
+        reconnect.started = std::chrono::steady_clock::now();
+
+        // 서버 재시작처럼 모든 연결을 먼저 끊고, 새 연결은 묶음마다 간격을 두고 시작
+        for (auto& user : users_) {
+            user->close();
+        }
+        std::size_t burst = config_.reconnect_burst == 0 ? users_.size() : config_.reconnect_burst;
+        for (std::size_t i = 0; i < users_.size(); ++i) {
+            auto user = std::make_shared<VirtualUser>(*this, i, true);
+            user->start(config_.reconnect_interval * static_cast<long long>(i / burst));
+            users_[i] = std::move(user);
+        }
+    }
+
+    void LoadClient::close() {
+        if (threads_.empty()) return;
+
+        stopping_ = true;
+        for (auto& user : users_) {
+            user->close();
+        }
+        work_.reset();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+        threads_.clear();
+        users_.clear();
+    }
+
+} // namespace load_generator
@@ -0,0 +1,130 @@
+﻿// tools/load_generator/load_client.h
+#pragma once
+#include "scenario.h"
+#include "latency_recorder.h"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace load_generator {
+
+    // 액션별 집계 (지연 시간은 응답을 받은 요청만, 타임아웃은 따로 셈)
+    struct ActionStats {
+        std::string name;
+        LatencyRecorder latency;
+        std::atomic<std::uint64_t> errors{ 0 };      // status가 success가 아닌 응답
+        std::atomic<std::uint64_t> timeouts{ 0 };
+    };
+
+    // 재접속 폭주 구간 집계 (폭주 시작 이후 다시 접속한 사용자만)
+    struct ReconnectStats {
+        std::size_t users = 0;                           // 재접속 대상, 0이면 폭주를 실행하지 않음
+        std::chrono::steady_clock::time_point started;   // 모든 연결을 끊은 시각
+        LatencyRecorder connect;                         // connect 시작 → TCP 연결 완료
+        LatencyRecorder accept;                          // connect 시작 → 핸드셰이크 응답 (서버가 accept하여 세션을 만들기까지)
+        std::atomic<std::uint64_t> failures{ 0 };        // 연결 실패, 핸드셰이크 실패/타임아웃
+        std::atomic<std::uint64_t> last_accept_micros{ 0 };  // started 기준 마지막 핸드셰이크 응답 시각
+
+        // 끊은 시각부터 마지막 사용자가 다시 받아들여질 때까지의 초당 수락 수
+        double acceptsPerSecond() const;
+    };
+
+    class LoadStats {
+    public:
+        LoadStats();
+
+        // 알 수 없는 이름이면 예외
+        ActionStats& action(std::string_view name);
+        const std::vector<std::unique_ptr<ActionStats>>& actions() const { return actions_; }
+        std::uint64_t totalResponses() const;
+        std::uint64_t totalErrors() const;
+        std::uint64_t totalTimeouts() const;
+
+        std::atomic<std::uint64_t> connect_failures{ 0 };
+        std::atomic<std::uint64_t> login_failures{ 0 };
+        std::atomic<std::uint64_t> disconnects{ 0 };    // 종료 전에 서버가 연결을 끊은 횟수
+        ReconnectStats reconnect;
+
+    private:
+        std::vector<std::unique_ptr<ActionStats>> actions_;
+    };
+
+    // 서버는 구분자 없이 JSON 객체를 이어서 보내므로 중괄호 깊이로 메시지 경계를 찾음
+    class MessageSplitter {
+    public:
+        template <class OnMessage>
+        void feed(const char* data, std::size_t length, OnMessage&& on_message) {
+            pending_.append(data, length);
+            std::size_t consumed = 0;
+            for (std::size_t i = scanned_; i < pending_.size(); ++i) {
+                char c = pending_[i];
+                if (in_string_) {
+                    if (escape_) escape_ = false;
+                    else if (c == '\\') escape_ = true;
+                    else if (c == '"') in_string_ = false;
+                    continue;
+                }
+                if (depth_ == 0 && c != '{') {
+                    // 객체 사이의 공백 등은 버림
+                    consumed = i + 1;
+                    continue;
+                }
+                if (c == '"') in_string_ = true;
+                else if (c == '{' || c == '[') ++depth_;
+                else if ((c == '}' || c == ']') && --depth_ == 0) {
+                    on_message(std::string_view(pending_.data() + consumed, i + 1 - consumed));
+                    consumed = i + 1;
+                }
+            }
+            pending_.erase(0, consumed);
+            scanned_ = pending_.size();
+        }
+
+    private:
+        std::string pending_;
+        std::size_t scanned_ = 0;
+        int depth_ = 0;
+        bool in_string_ = false;
+        bool escape_ = false;
+    };
+
+    class VirtualUser;
+
+    // boost_Practice의 AsyncTCPClient를 부하 생성용으로 확장한 클라이언트
+    // io 스레드 여러 개가 사용자(연결) 수천 개를 나눠 처리하며, 사용자마다 strand로 핸들러를 직렬화한다.
+    class LoadClient {
+    public:
+        LoadClient(const ScenarioConfig& config, LoadStats& stats);
+        ~LoadClient();
+
+        // io 스레드를 만들고 램프업 일정에 맞춰 사용자 접속 시작
+        void start();
+        // 모든 사용자 연결을 닫고 스레드 정리 (응답을 기다리던 요청은 집계하지 않음)
+        void close();
+        // 재접속 폭주 시작: 모든 연결을 끊고 reconnect_burst명씩 reconnect_interval 간격으로 새 연결을 맺음
+        void reconnectAll();
+
+        std::size_t connectedUsers() const { return connected_.load(std::memory_order_relaxed); }
+
+    private:
+        friend class VirtualUser;
+
+        const ScenarioConfig& config_;
+        LoadStats& stats_;
+        boost::asio::io_context io_;
+        std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> work_;
+        std::vector<std::thread> threads_;
+        std::vector<std::shared_ptr<VirtualUser>> users_;
+        std::atomic<bool> stopping_{ false };
+        std::atomic<std::size_t> connected_{ 0 };
+    };
+
+} // namespace load_generator
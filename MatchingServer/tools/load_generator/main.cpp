@@ -0,0 +1,215 @@
+﻿// tools/load_generator/main.cpp
+// 매칭 서버 부하 생성기 진입점
+// 사용법: LoadGenerator [scenario.json] [--users N] [--threads N] [--rate R] [--duration S] [--ramp S]
+//                      [--host H] [--port P] [--report result.json] [--reconnect-at S] [--reconnect-burst N]
+#include "scenario.h"
+#include "load_client.h"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+    using load_generator::json;
+
+    std::atomic<bool> interrupted{ false };
+
+    // 명령행 옵션을 시나리오 JSON 키로 덮어씀
+    json parseArguments(int argc, char* argv[]) {
+        json scenario = json::object();
+        int i = 1;
+        if (i < argc && argv[i][0] != '-') {
+            std::ifstream file(argv[i]);
+            if (!file.is_open()) {
+                throw std::runtime_error(std::string("시나리오 파일을 열 수 없습니다: ") + argv[i]);
+            }
+            scenario = json::parse(file);
+            ++i;
+        }
+
+        for (; i < argc; i += 2) {
+            std::string option = argv[i];
+            if (i + 1 >= argc) throw std::invalid_argument(option + " 옵션에 값이 없습니다");
+            std::string value = argv[i + 1];
+
+            if (option == "--users") scenario["users"] = std::stoul(value);
+            else if (option == "--threads") scenario["threads"] = std::stoul(value);
+            else if (option == "--rate") scenario["ratePerUser"] = std::stod(value);
+            else if (option == "--duration") scenario["durationSeconds"] = std::stod(value);
+            else if (option == "--ramp") scenario["rampUpSeconds"] = std::stod(value);
+            else if (option == "--host") scenario["host"] = value;
+            else if (option == "--port") scenario["port"] = std::stoul(value);
+            else if (option == "--report") scenario["reportPath"] = value;
+            else if (option == "--reconnect-at") scenario["reconnectAtSeconds"] = std::stod(value);
+            else if (option == "--reconnect-burst") scenario["reconnectBurst"] = std::stoul(value);
+            else throw std::invalid_argument("알 수 없는 옵션입니다: " + option);
+        }
+        return scenario;
+    }
+
+    double toMillis(std::uint64_t micros) {
+        return micros / 1000.0;
+    }
+
+    void printSummary(const load_generator::LoadStats& stats, double seconds) {
+        std::printf("\n%-11s %9s %7s %7s %9s %9s %9s %9s %9s\n",
+            "action", "count", "errors", "timeout", "req/s", "p50(ms)", "p99(ms)", "p999(ms)", "max(ms)");
+        for (const auto& action : stats.actions()) {
+            std::uint64_t count = action->latency.count();
+            std::uint64_t timeouts = action->timeouts.load();
+            if (count == 0 && timeouts == 0) continue;
+            std::printf("%-11s %9llu %7llu %7llu %9.1f %9.2f %9.2f %9.2f %9.2f\n",
+                action->name.c_str(),
+                static_cast<unsigned long long>(count),
+                static_cast<unsigned long long>(action->errors.load()),
+                static_cast<unsigned long long>(timeouts),
+                count / seconds,
+                toMillis(action->latency.percentile(0.50)),
+                toMillis(action->latency.percentile(0.99)),
+                toMillis(action->latency.percentile(0.999)),
+                toMillis(action->latency.max()));
+        }
+        std::printf("\n총 응답 %llu건 (%.1f/s), 연결 실패 %llu, 로그인 실패 %llu, 서버 측 연결 종료 %llu\n",
+            static_cast<unsigned long long>(stats.totalResponses()), stats.totalResponses() / seconds,
+            static_cast<unsigned long long>(stats.connect_failures.load()),
+            static_cast<unsigned long long>(stats.login_failures.load()),
+            static_cast<unsigned long long>(stats.disconnects.load()));
+
+        const auto& reconnect = stats.reconnect;
+        if (reconnect.users == 0) return;
+        std::printf("\n재접속 폭주: %zu명 중 %llu명 수락 (%.1f accepts/s), 실패 %llu\n",
+            reconnect.users, static_cast<unsigned long long>(reconnect.accept.count()), reconnect.acceptsPerSecond(),
+            static_cast<unsigned long long>(reconnect.failures.load()));
+        std::printf("%-11s %9s %9s %9s %9s\n", "", "p50(ms)", "p99(ms)", "p999(ms)", "max(ms)");
+        auto printLatency = [](const char* name, const load_generator::LatencyRecorder& latency) {
+            std::printf("%-11s %9.2f %9.2f %9.2f %9.2f\n", name,
+                toMillis(latency.percentile(0.50)), toMillis(latency.percentile(0.99)),
+                toMillis(latency.percentile(0.999)), toMillis(latency.max()));
+        };
+        printLatency("connect", reconnect.connect);
+        printLatency("accept", reconnect.accept);
+    }
+
+    json latencyJson(const load_generator::LatencyRecorder& latency) {
+        return {
+            {"count", latency.count()},
+            {"p50Ms", toMillis(latency.percentile(0.50))},
+            {"p99Ms", toMillis(latency.percentile(0.99))},
+            {"p999Ms", toMillis(latency.percentile(0.999))},
+            {"maxMs", toMillis(latency.max())}
+        };
+    }
+
+    json toJson(const load_generator::ScenarioConfig& config, const load_generator::LoadStats& stats, double seconds) {
+        json actions = json::object();
+        for (const auto& action : stats.actions()) {
+            std::uint64_t count = action->latency.count();
+            if (count == 0 && action->timeouts.load() == 0) continue;
+            actions[action->name] = {
+                {"count", count},
+                {"errors", action->errors.load()},
+                {"timeouts", action->timeouts.load()},
+                {"throughput", count / seconds},
+                {"meanMs", action->latency.mean() / 1000.0},
+                {"p50Ms", toMillis(action->latency.percentile(0.50))},
+                {"p99Ms", toMillis(action->latency.percentile(0.99))},
+                {"p999Ms", toMillis(action->latency.percentile(0.999))},
+                {"maxMs", toMillis(action->latency.max())}
+            };
+        }
+        json result = {
+            {"scenario", config.toJson()},
+            {"elapsedSeconds", seconds},
+            {"totalResponses", stats.totalResponses()},
+            {"connectFailures", stats.connect_failures.load()},
+            {"loginFailures", stats.login_failures.load()},
+            {"disconnects", stats.disconnects.load()},
+            {"actions", actions}
+        };
+        const auto& reconnect = stats.reconnect;
+        if (reconnect.users > 0) {
+            result["reconnectStorm"] = {
+                {"users", reconnect.users},
+                {"accepted", reconnect.accept.count()},
+                {"failures", reconnect.failures.load()},
+                {"acceptsPerSecond", reconnect.acceptsPerSecond()},
+                {"connect", latencyJson(reconnect.connect)},
+                {"accept", latencyJson(reconnect.accept)}
+            };
+        }
+        return result;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        auto config = load_generator::ScenarioConfig::fromJson(parseArguments(argc, argv));
+        std::signal(SIGINT, [](int) { interrupted = true; });
+
+        std::printf("부하 시작: %s:%u, 사용자 %zu명, io 스레드 %zu개, 사용자당 %.2f req/s, 램프업 %.1f초, 전체 %.1f초\n",
+            config.host.c_str(), config.port, config.users, config.threads, config.rate_per_user,
+            config.ramp_up.count() / 1000.0, config.duration.count() / 1000.0);
+
+        load_generator::LoadStats stats;
+        load_generator::LoadClient client(config, stats);
+        auto started = std::chrono::steady_clock::now();
+        auto deadline = started + config.duration;
+        auto next_report = started + config.report_interval;
+        std::uint64_t last_responses = 0;
+        bool reconnect_pending = config.reconnect_at.count() > 0;
+        client.start();
+
+        // 주기적으로 진행 상황 출력
+        while (!interrupted && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            auto now = std::chrono::steady_clock::now();
+            if (reconnect_pending && now >= started + config.reconnect_at) {
+                reconnect_pending = false;
+                std::printf("[%6.1fs] 재접속 폭주 시작: 접속 %zu명을 끊고 %zu명씩 %lldms 간격으로 재접속\n",
+                    std::chrono::duration<double>(now - started).count(), client.connectedUsers(),
+                    config.reconnect_burst == 0 ? config.users : config.reconnect_burst,
+                    static_cast<long long>(config.reconnect_interval.count()));
+                std::fflush(stdout);
+                client.reconnectAll();
+            }
+            if (now < next_report) continue;
+
+            std::uint64_t responses = stats.totalResponses();
+            double elapsed = std::chrono::duration<double>(now - started).count();
+            std::printf("[%6.1fs] 접속 %zu명, 최근 %lld초 %.1f req/s, 오류 %llu, 타임아웃 %llu\n",
+                elapsed, client.connectedUsers(), static_cast<long long>(config.report_interval.count()),
+                (responses - last_responses) / static_cast<double>(config.report_interval.count()),
+                static_cast<unsigned long long>(stats.totalErrors()),
+                static_cast<unsigned long long>(stats.totalTimeouts()));
+            std::fflush(stdout);
+            last_responses = responses;
+            next_report += config.report_interval;
+        }
+
+        client.close();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        printSummary(stats, seconds);
+
+        if (!config.report_path.empty()) {
+            std::ofstream report(config.report_path, std::ios::trunc);
+            if (!report.is_open()) {
+                throw std::runtime_error("결과 파일을 열 수 없습니다: " + config.report_path);
+            }
+            report << toJson(config, stats, seconds).dump(2) << '\n';
+            std::printf("결과를 %s에 기록했습니다\n", config.report_path.c_str());
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "부하 생성기 오류: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+﻿// tools/load_generator/scenario.cpp
+// 부하 시나리오 설정 구현 파일
+#include "scenario.h"
+#include <stdexcept>
+
+namespace load_generator {
+
+    bool isMixAction(const std::string& action) {
+        return action == "listRooms" || action == "createRoom" || action == "joinRoom" ||
+            action == "alivePing" || action == "chat";
+    }
+
+    ScenarioConfig ScenarioConfig::fromJson(const json& config) {
+        ScenarioConfig result;
+        if (!config.is_object()) return result;
+
+        result.host = config.value("host", result.host);
+        result.port = config.value("port", result.port);
+        result.version = config.value("version", result.version);
+        result.bind_base = config.value("bindBase", result.bind_base);
+        result.users = config.value("users", result.users);
+        result.threads = config.value("threads", result.threads);
+        result.ramp_up = std::chrono::milliseconds(static_cast<long long>(
+            config.value("rampUpSeconds", result.ramp_up.count() / 1000.0) * 1000));
+        result.duration = std::chrono::milliseconds(static_cast<long long>(
+            config.value("durationSeconds", result.duration.count() / 1000.0) * 1000));
+        result.rate_per_user = config.value("ratePerUser", result.rate_per_user);
+        result.request_timeout = std::chrono::milliseconds(
+            config.value("requestTimeoutMs", static_cast<int>(result.request_timeout.count())));
+        result.report_interval = std::chrono::seconds(
+            config.value("reportIntervalSeconds", static_cast<int>(result.report_interval.count())));
+        result.user_prefix = config.value("userPrefix", result.user_prefix);
+        result.password = config.value("password", result.password);
+        result.register_users = config.value("registerUsers", result.register_users);
+        result.report_path = config.value("reportPath", result.report_path);
+        result.reconnect_at = std::chrono::milliseconds(static_cast<long long>(
+            config.value("reconnectAtSeconds", result.reconnect_at.count() / 1000.0) * 1000));
+        result.reconnect_burst = config.value("reconnectBurst", result.reconnect_burst);
+        result.reconnect_interval = std::chrono::milliseconds(
+            config.value("reconnectIntervalMs", static_cast<int>(result.reconnect_interval.count())));
+
+        if (config.contains("mix")) {
+            result.mix.clear();
+            for (const auto& [action, weight] : config["mix"].items()) {
+                if (!isMixAction(action)) {
+                    throw std::invalid_argument("mix에 쓸 수 없는 액션입니다: " + action);
+                }
+                if (weight.get<double>() > 0) {
+                    result.mix.emplace_back(action, weight.get<double>());
+                }
+            }
+        }
+
+        if (result.users == 0 || result.threads == 0) {
+            throw std::invalid_argument("users와 threads는 1 이상이어야 합니다");
+        }
+        if (result.mix.empty() || result.rate_per_user <= 0) {
+            throw std::invalid_argument("mix와 ratePerUser가 비어 있으면 로그인 이후 요청을 보낼 수 없습니다");
+        }
+        if (result.reconnect_at.count() > 0 && result.reconnect_at >= result.duration) {
+            throw std::invalid_argument("reconnectAtSeconds는 durationSeconds보다 작아야 합니다");
+        }
+        return result;
+    }
+
+    json ScenarioConfig::toJson() const {
+        json mix_json = json::object();
+        for (const auto& [action, weight] : mix) {
+            mix_json[action] = weight;
+        }
+        return {
+            {"host", host},
+            {"port", port},
+            {"bindBase", bind_base},
+            {"users", users},
+            {"threads", threads},
+            {"rampUpSeconds", ramp_up.count() / 1000.0},
+            {"durationSeconds", duration.count() / 1000.0},
+            {"ratePerUser", rate_per_user},
+            {"requestTimeoutMs", request_timeout.count()},
+            {"registerUsers", register_users},
+            {"reconnectAtSeconds", reconnect_at.count() / 1000.0},
+            {"reconnectBurst", reconnect_burst},
+            {"reconnectIntervalMs", reconnect_interval.count()},
+            {"mix", mix_json}
+        };
+    }
+
+} // namespace load_generator
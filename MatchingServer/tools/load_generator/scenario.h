@@ -0,0 +1,55 @@
+﻿// tools/load_generator/scenario.h
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace load_generator {
+
+    using json = nlohmann::json;
+
+    // 부하 시나리오 설정 (scenario.json)
+    struct ScenarioConfig {
+        std::string host = "127.0.0.1";
+        unsigned short port = 8080;
+        std::string version = "1.0.0";
+        // 서버는 IP당 연결 하나만 허용하므로 사용자마다 이 주소부터 1씩 증가한 주소로 바인드 (비우면 바인드하지 않음)
+        // 루프백(127.0.0.0/8)은 별도 설정 없이 모든 주소를 쓸 수 있음
+        std::string bind_base = "127.1.0.1";
+
+        std::size_t users = 1000;
+        std::size_t threads = 4;
+        std::chrono::milliseconds ramp_up{ 10000 };      // 사용자 접속을 이 시간 동안 고르게 나눔
+        std::chrono::milliseconds duration{ 60000 };     // 램프업을 포함한 전체 실행 시간
+        double rate_per_user = 1.0;                      // 로그인 이후 사용자당 초당 요청 수 (대기 시간은 지수 분포)
+        std::chrono::milliseconds request_timeout{ 5000 };
+        std::chrono::seconds report_interval{ 5 };
+
+        std::string user_prefix = "load";
+        std::string password = "loadtest1";
+        bool register_users = true;                      // 로그인 전에 회원가입 시도 (이미 있으면 오류 응답으로 집계)
+
+        // 로그인 이후 요청 비율 (action, 가중치), 방 참가/생성에 성공하면 다음 요청은 항상 exitRoom
+        std::vector<std::pair<std::string, double>> mix = {
+            { "listRooms", 40 }, { "alivePing", 30 }, { "chat", 15 }, { "joinRoom", 10 }, { "createRoom", 5 }
+        };
+
+        // 재접속 폭주: 시작 후 reconnect_at 시점에 모든 연결을 한꺼번에 끊고 reconnect_burst명씩 묶어 다시 접속 (0이면 하지 않음)
+        // 배포 직후 클라이언트가 몰려 재접속하는 상황을 재현하여 서버의 accept 처리량과 connect 지연 시간을 측정
+        std::chrono::milliseconds reconnect_at{ 0 };
+        std::size_t reconnect_burst = 0;                 // 묶음 하나의 사용자 수 (0이면 전체가 동시에)
+        std::chrono::milliseconds reconnect_interval{ 100 };   // 묶음 사이 간격
+
+        std::string report_path;                         // 지정하면 결과를 JSON으로 기록
+
+        static ScenarioConfig fromJson(const json& config);
+        json toJson() const;
+    };
+
+    // 시나리오가 보낼 수 있는 요청 (mix에 쓸 수 있는 이름)
+    bool isMixAction(const std::string& action);
+
+} // namespace load_generator
@@ -0,0 +1,248 @@
+﻿// common/auth/signed_token.cpp
+// 서명 토큰 구현 파일
+// 고정 길이 바이너리 페이로드에 HMAC을 붙이고 base64url로 인코딩
+#include "signed_token.h"
+#include "crypto/crypto_util.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace game_server {
+namespace auth {
+
+    namespace {
+        constexpr unsigned char kTokenVersion = 1;
+        constexpr std::size_t kPayloadLength = 1 + 2 + 4 + 4 + 8;
+        constexpr std::size_t kTagLength = 16;
+        constexpr std::size_t kTokenLength = kPayloadLength + kTagLength;
+        // 이보다 짧은 비밀 키는 경고만 하고 사용
+        constexpr std::size_t kMinSecretLength = 32;
+
+        void writeUint16(unsigned char* out, std::uint16_t value) {
+            out[0] = static_cast<unsigned char>(value >> 8);
+            out[1] = static_cast<unsigned char>(value);
+        }
+
+        void writeUint32(unsigned char* out, std::uint32_t value) {
+            out[0] = static_cast<unsigned char>(value >> 24);
+            out[1] = static_cast<unsigned char>(value >> 16);
+            out[2] = static_cast<unsigned char>(value >> 8);
+            out[3] = static_cast<unsigned char>(value);
+        }
+
+        std::uint16_t readUint16(const unsigned char* in) {
+            return static_cast<std::uint16_t>((in[0] << 8) | in[1]);
+        }
+
+        std::uint32_t readUint32(const unsigned char* in) {
+            return (static_cast<std::uint32_t>(in[0]) << 24) | (static_cast<std::uint32_t>(in[1]) << 16) |
+                (static_cast<std::uint32_t>(in[2]) << 8) | in[3];
+        }
+
+        std::uint32_t nowSeconds() {
+            return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        }
+
+        std::string_view payloadView(const unsigned char* payload) {
+            return std::string_view(reinterpret_cast<const char*>(payload), kPayloadLength);
+        }
+    }
+
+    const char* toString(TokenStatus status) {
+        switch (status) {
+        case TokenStatus::Valid: return "valid";
+        case TokenStatus::Malformed: return "malformed";
+        case TokenStatus::UnknownKey: return "unknown key";
+        case TokenStatus::BadSignature: return "bad signature";
+        case TokenStatus::Expired: return "expired";
+        }
+        return "unknown";
+    }
+
+    bool SessionToken::parse(std::string_view text, SessionToken& out) {
+        if (text.size() != kSessionTokenLength) return false;
+        for (char c : text) {
+            bool valid = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+            if (!valid) return false;
+        }
+        std::copy(text.begin(), text.end(), out.chars_.begin());
+        return true;
+    }
+
+    std::string SessionToken::fingerprint() const {
+        if (empty()) return "-";
+
+        // 앞 4글자가 버전 1B + 키 ID 2B
+        unsigned char header[3];
+        std::size_t length = 0;
+        std::uint16_t keyId = 0;
+        if (crypto::base64UrlDecode(view().substr(0, 4), header, sizeof(header), length) && length == sizeof(header)) {
+            keyId = readUint16(header + 1);
+        }
+
+        auto digest = crypto::sha256(view());
+        return "k" + std::to_string(keyId) + ":" + crypto::toHexString(digest.data(), 4);
+    }
+
+    TokenKeyConfig TokenKeyConfig::fromJson(const nlohmann::json& config) {
+        TokenKeyConfig result;
+        if (!config.is_object()) return result;
+
+        result.active_key_id = config.value("activeKeyId", result.active_key_id);
+        result.ttl = std::chrono::seconds(config.value("ttlSeconds", static_cast<long long>(result.ttl.count())));
+
+        if (config.contains("keys") && config["keys"].is_array()) {
+            for (const auto& entry : config["keys"]) {
+                if (!entry.is_object()) continue;
+                SigningKey key;
+                key.id = entry.value("id", static_cast<std::uint16_t>(0));
+                key.secret = entry.value("secret", "");
+
+                // 비밀 키를 설정 파일 대신 환경 변수로 전달하는 경우
+                std::string env_name = entry.value("secretEnv", "");
+                if (!env_name.empty()) {
+                    const char* env_value = std::getenv(env_name.c_str());
+                    key.secret = env_value ? env_value : "";
+                }
+
+                if (key.secret.empty()) {
+                    spdlog::warn("토큰 서명 키 {}의 비밀 값이 비어 있어 무시합니다", key.id);
+                    continue;
+                }
+                result.keys.push_back(std::move(key));
+            }
+        }
+        return result;
+    }
+
+    const SigningKey* TokenSigner::KeySet::find(std::uint16_t id) const {
+        for (const auto& key : keys) {
+            if (key.id == id) return &key;
+        }
+        return nullptr;
+    }
+
+    TokenSigner::TokenSigner(const TokenKeyConfig& config)
+        : keys_(buildKeySet(config))
+    {
+    }
+
+    void TokenSigner::rotate(const TokenKeyConfig& config) {
+        auto key_set = buildKeySet(config);
+        std::lock_guard<std::mutex> lock(keys_mutex_);
+        keys_ = std::move(key_set);
+    }
+
+    std::shared_ptr<const TokenSigner::KeySet> TokenSigner::keys() const {
+        std::lock_guard<std::mutex> lock(keys_mutex_);
+        return keys_;
+    }
+
+    std::shared_ptr<const TokenSigner::KeySet> TokenSigner::buildKeySet(const TokenKeyConfig& config) {
+        auto key_set = std::make_shared<KeySet>();
+        key_set->active_key_id = config.active_key_id;
+        key_set->keys = config.keys;
+        key_set->ttl = config.ttl.count() > 0 ? config.ttl : TokenKeyConfig().ttl;
+
+        for (const auto& key : key_set->keys) {
+            if (key.secret.size() < kMinSecretLength) {
+                spdlog::warn("토큰 서명 키 {}의 길이가 {}바이트 미만입니다", key.id, kMinSecretLength);
+            }
+        }
+
+        // 발급 키가 없으면 이 프로세스에서만 유효한 임시 키 사용 (다른 노드에서는 검증 불가)
+        if (!key_set->find(key_set->active_key_id)) {
+            std::array<unsigned char, kMinSecretLength> secret;
+            if (!crypto::randomBytes(secret.data(), secret.size())) {
+                throw std::runtime_error("임시 토큰 서명 키 생성 실패");
+            }
+            SigningKey key;
+            key.id = key_set->active_key_id;
+            key.secret.assign(reinterpret_cast<const char*>(secret.data()), secret.size());
+            key_set->keys.push_back(std::move(key));
+            spdlog::warn("토큰 발급 키 {}가 설정되지 않아 임시 키를 생성했습니다, 다른 노드와 토큰이 호환되지 않습니다",
+                key_set->active_key_id);
+        }
+
+        spdlog::info("토큰 서명 키 {}개 로드, 발급 키 ID : {}, 유효 기간 : {}초",
+            key_set->keys.size(), key_set->active_key_id, key_set->ttl.count());
+        return key_set;
+    }
+
+    SessionToken TokenSigner::issue(std::int32_t userId) const {
+        return issue(userId, std::chrono::seconds(0));
+    }
+
+    SessionToken TokenSigner::issue(std::int32_t userId, std::chrono::seconds ttl) const {
+        auto key_set = keys();
+        const SigningKey* key = key_set->find(key_set->active_key_id);
+        if (ttl.count() <= 0) ttl = key_set->ttl;
+
+        std::array<unsigned char, kTokenLength> token;
+        unsigned char* p = token.data();
+        p[0] = kTokenVersion;
+        writeUint16(p + 1, key->id);
+        writeUint32(p + 3, static_cast<std::uint32_t>(userId));
+        writeUint32(p + 7, nowSeconds() + static_cast<std::uint32_t>(ttl.count()));
+        // 같은 사용자, 같은 초에 발급된 토큰도 서로 달라지도록 난수 포함
+        if (!crypto::randomBytes(p + 11, 8)) {
+            throw std::runtime_error("토큰 난수 생성 실패");
+        }
+
+        crypto::Sha256Digest mac = crypto::hmacSha256(key->secret, payloadView(p));
+        std::copy(mac.begin(), mac.begin() + kTagLength, p + kPayloadLength);
+
+        SessionToken result;
+        crypto::base64UrlEncode(token.data(), token.size(), result.chars_.data());
+        return result;
+    }
+
+    TokenStatus TokenSigner::verify(std::string_view token, TokenClaims* claims) const {
+        std::array<unsigned char, kTokenLength> raw;
+        std::size_t length = 0;
+        if (!crypto::base64UrlDecode(token, raw.data(), raw.size(), length) ||
+            length != kTokenLength || raw[0] != kTokenVersion) {
+            return TokenStatus::Malformed;
+        }
+
+        auto key_set = keys();
+        std::uint16_t key_id = readUint16(raw.data() + 1);
+        const SigningKey* key = key_set->find(key_id);
+        if (!key) {
+            return TokenStatus::UnknownKey;
+        }
+
+        crypto::Sha256Digest mac = crypto::hmacSha256(key->secret, payloadView(raw.data()));
+        if (!crypto::constantTimeEquals(mac.data(), raw.data() + kPayloadLength, kTagLength)) {
+            return TokenStatus::BadSignature;
+        }
+
+        // 서명이 맞는 토큰만 만료 여부 확인 (위조된 값으로 상태를 추측할 수 없도록)
+        std::uint32_t expires_at = readUint32(raw.data() + 7);
+        if (expires_at <= nowSeconds()) {
+            return TokenStatus::Expired;
+        }
+
+        if (claims) {
+            claims->key_id = key_id;
+            claims->user_id = static_cast<std::int32_t>(readUint32(raw.data() + 3));
+            claims->expires_at = expires_at;
+        }
+        return TokenStatus::Valid;
+    }
+
+    TokenStatus TokenSigner::recheck(const TokenClaims& claims) const {
+        if (!keys()->find(claims.key_id)) {
+            return TokenStatus::UnknownKey;
+        }
+        if (claims.expires_at <= nowSeconds()) {
+            return TokenStatus::Expired;
+        }
+        return TokenStatus::Valid;
+    }
+
+} // namespace auth
+} // namespace game_server
@@ -0,0 +1,124 @@
+﻿// common/auth/signed_token.h
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+namespace auth {
+
+    // 서명 키 하나 (키 ID는 토큰에 기록되어 검증 시 어떤 키로 확인할지 결정)
+    struct SigningKey {
+        std::uint16_t id = 0;
+        std::string secret;
+    };
+
+    // 토큰 서명 설정 (config.json의 "sessionToken" 섹션)
+    // keys에는 현재 발급용 키와, 이전에 발급된 토큰 검증을 위해 남겨둔 키를 함께 둔다.
+    struct TokenKeyConfig {
+        std::uint16_t active_key_id = 0;
+        std::vector<SigningKey> keys;
+        std::chrono::seconds ttl{ 24 * 60 * 60 };
+
+        // {"activeKeyId": 1, "ttlSeconds": 86400, "keys": [{"id": 1, "secret": "..."}, {"id": 2, "secretEnv": "TOKEN_KEY_2"}]}
+        static TokenKeyConfig fromJson(const nlohmann::json& config);
+    };
+
+    struct TokenClaims {
+        std::uint16_t key_id = 0;
+        std::int32_t user_id = 0;
+        std::uint32_t expires_at = 0;   // 유닉스 시간(초)
+    };
+
+    enum class TokenStatus {
+        Valid,
+        Malformed,
+        UnknownKey,
+        BadSignature,
+        Expired
+    };
+
+    const char* toString(TokenStatus status);
+
+    // 서명 토큰의 base64url 표기 길이 (35바이트 -> 47글자, 패딩 없음)
+    constexpr std::size_t kSessionTokenLength = 47;
+
+    // 힙 할당 없이 토큰 문자열을 그대로 담는 고정 크기 타입 (세션 맵의 키)
+    class SessionToken {
+    public:
+        SessionToken() = default;
+
+        // 길이와 문자 집합만 확인 (서명 검증은 TokenSigner::verify)
+        static bool parse(std::string_view text, SessionToken& out);
+
+        bool empty() const { return chars_[0] == '\0'; }
+        std::string_view view() const {
+            return empty() ? std::string_view() : std::string_view(chars_.data(), chars_.size());
+        }
+        std::string str() const { return std::string(view()); }
+        void clear() { chars_.fill('\0'); }
+
+        // 로그용 식별자 "k<키 ID>:<SHA-256 앞 8글자>", 토큰 원문은 그대로 재사용할 수 있으므로 로그에 남기지 않음
+        std::string fingerprint() const;
+
+        bool operator==(const SessionToken& other) const { return chars_ == other.chars_; }
+        bool operator!=(const SessionToken& other) const { return chars_ != other.chars_; }
+
+    private:
+        friend class TokenSigner;
+        std::array<char, kSessionTokenLength> chars_{};
+    };
+
+    struct SessionTokenHash {
+        std::size_t operator()(const SessionToken& token) const {
+            return std::hash<std::string_view>()(token.view());
+        }
+    };
+
+    inline void to_json(nlohmann::json& j, const SessionToken& token) {
+        j = token.view();
+    }
+
+    // 서버 간 공유 상태 없이 검증할 수 있는 서명 토큰
+    // 형식: base64url(버전 1B | 키 ID 2B | 사용자 ID 4B | 만료 시각 4B | 난수 8B | HMAC-SHA256 앞 16B)
+    // 같은 키 설정을 가진 어느 노드든 세션 맵 조회 없이 서명과 만료만으로 검증할 수 있다.
+    class TokenSigner {
+    public:
+        explicit TokenSigner(const TokenKeyConfig& config);
+
+        // 키 교체: 새 토큰은 새 발급 키로 서명하고, 남겨둔 이전 키로 서명된 토큰도 계속 검증
+        void rotate(const TokenKeyConfig& config);
+
+        SessionToken issue(std::int32_t userId) const;
+        SessionToken issue(std::int32_t userId, std::chrono::seconds ttl) const;
+
+        TokenStatus verify(std::string_view token, TokenClaims* claims = nullptr) const;
+        // verify를 통과한 토큰의 클레임을 다시 사용할 때 만료와 키 존재 여부만 재확인 (키 교체로 제거된 키는 UnknownKey)
+        TokenStatus recheck(const TokenClaims& claims) const;
+
+    private:
+        struct KeySet {
+            std::uint16_t active_key_id = 0;
+            std::vector<SigningKey> keys;
+            std::chrono::seconds ttl{ 0 };
+
+            const SigningKey* find(std::uint16_t id) const;
+        };
+
+        std::shared_ptr<const KeySet> keys() const;
+        static std::shared_ptr<const KeySet> buildKeySet(const TokenKeyConfig& config);
+
+        mutable std::mutex keys_mutex_;
+        std::shared_ptr<const KeySet> keys_;
+    };
+
+} // namespace auth
+} // namespace game_server
@@ -0,0 +1,197 @@
+﻿// common/bench/bench_harness.h
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+namespace bench {
+
+    // MatchingServer와 GameSocketServer 벤치마크가 함께 쓰는 최소 측정 도구 (헤더 전용, C++17)
+    // 반복 횟수는 한 번의 측정이 min_time 이상 걸리도록 자동으로 늘리고, repetitions번 측정한 중앙값을 보고한다.
+    // 결과는 커밋 간 비교를 위해 JSON으로 저장한다 (common/bench/compare.py).
+
+    // 측정 대상 계산이 최적화로 사라지지 않도록 값을 사용한 것으로 처리
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+        static volatile const void* sink;
+        sink = &value;
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    struct Result {
+        std::string name;
+        std::uint64_t iterations = 0;     // 측정 1회당 반복 횟수
+        double ns_per_op = 0;             // 중앙값
+        double min_ns_per_op = 0;
+        double max_ns_per_op = 0;
+        std::uint64_t items_per_op = 1;   // 브로드캐스트 수신자 수처럼 한 번의 연산이 처리하는 항목 수
+        bool skipped = false;
+        std::string note;
+        std::vector<std::pair<std::string, double>> metrics;   // 연산당 힙 할당 수처럼 시간 외에 함께 보고하는 값
+    };
+
+    class Runner {
+    public:
+        // 옵션: --filter <부분 문자열> --json <경로> --min-time <초> --repetitions <횟수>
+        Runner(std::string suite, int argc, char* argv[])
+            : suite_(std::move(suite))
+        {
+            for (int i = 1; i + 1 < argc; i += 2) {
+                std::string option = argv[i];
+                std::string value = argv[i + 1];
+                if (option == "--filter") filter_ = value;
+                else if (option == "--json") json_path_ = value;
+                else if (option == "--min-time") min_time_ = std::chrono::duration<double>(std::stod(value));
+                else if (option == "--repetitions") repetitions_ = std::max(1, std::stoi(value));
+            }
+        }
+
+        bool enabled(const std::string& name) const {
+            return filter_.empty() || name.find(filter_) != std::string::npos;
+        }
+
+        // body는 연산 1회를 수행하는 함수
+        template <typename Body>
+        void run(const std::string& name, Body&& body, std::uint64_t items_per_op = 1) {
+            if (!enabled(name)) return;
+
+            // 측정 1회가 min_time을 넘을 때까지 반복 횟수를 늘림 (scrypt처럼 느린 연산은 1회)
+            std::uint64_t iterations = 1;
+            for (;;) {
+                double elapsed = measure(body, iterations);
+                if (elapsed >= min_time_.count() || iterations >= (std::uint64_t{ 1 } << 40)) break;
+                double scale = elapsed > 0 ? min_time_.count() / elapsed * 1.2 : 10.0;
+                iterations = static_cast<std::uint64_t>(iterations * std::min(std::max(scale, 1.5), 10.0));
+            }
+
+            std::vector<double> samples;
+            for (int i = 0; i < repetitions_; ++i) {
+                samples.push_back(measure(body, iterations) * 1e9 / iterations);
+            }
+            std::sort(samples.begin(), samples.end());
+
+            Result result;
+            result.name = name;
+            result.iterations = iterations;
+            result.ns_per_op = samples[samples.size() / 2];
+            result.min_ns_per_op = samples.front();
+            result.max_ns_per_op = samples.back();
+            result.items_per_op = items_per_op;
+            print(result);
+            results_.push_back(std::move(result));
+        }
+
+        // 직전에 측정한 name 항목에 시간 외 지표를 추가 (JSON에는 key 이름의 필드로 기록)
+        void addMetric(const std::string& name, const std::string& key, double value) {
+            if (results_.empty() || results_.back().name != name || results_.back().skipped) return;
+            std::printf("%-48s %14.2f %s\n", "", value, key.c_str());
+            std::fflush(stdout);
+            results_.back().metrics.emplace_back(key, value);
+        }
+
+        // 환경이 없어 실행하지 못한 항목 (예: BENCH_DB_URL 미지정)
+        void skip(const std::string& name, const std::string& reason) {
+            if (!enabled(name)) return;
+            Result result;
+            result.name = name;
+            result.skipped = true;
+            result.note = reason;
+            std::printf("%-48s %s\n", name.c_str(), ("건너뜀: " + reason).c_str());
+            results_.push_back(std::move(result));
+        }
+
+        // 결과를 JSON으로 저장, 실패 시 1 반환 (main의 반환값으로 사용)
+        int finish() const {
+            if (json_path_.empty()) return 0;
+
+            nlohmann::json results = nlohmann::json::array();
+            for (const auto& result : results_) {
+                nlohmann::json item = {
+                    {"name", result.name},
+                    {"skipped", result.skipped}
+                };
+                if (result.skipped) {
+                    item["note"] = result.note;
+                }
+                else {
+                    item["iterations"] = result.iterations;
+                    item["nsPerOp"] = result.ns_per_op;
+                    item["minNsPerOp"] = result.min_ns_per_op;
+                    item["maxNsPerOp"] = result.max_ns_per_op;
+                    item["opsPerSecond"] = result.ns_per_op > 0 ? 1e9 / result.ns_per_op : 0;
+                    if (result.items_per_op > 1) {
+                        item["itemsPerOp"] = result.items_per_op;
+                        item["nsPerItem"] = result.ns_per_op / result.items_per_op;
+                    }
+                    for (const auto& [key, value] : result.metrics) {
+                        item[key] = value;
+                    }
+                }
+                results.push_back(std::move(item));
+            }
+
+            const char* commit = std::getenv("BENCH_COMMIT");
+            nlohmann::json document = {
+                {"suite", suite_},
+                {"commit", commit ? commit : ""},
+                {"timestamp", static_cast<std::int64_t>(std::time(nullptr))},
+                {"repetitions", repetitions_},
+                {"results", results}
+            };
+
+            std::ofstream file(json_path_, std::ios::trunc);
+            if (!file.is_open()) {
+                std::fprintf(stderr, "결과 파일을 열 수 없습니다: %s\n", json_path_.c_str());
+                return 1;
+            }
+            file << document.dump(2) << '\n';
+            std::printf("결과를 %s에 기록했습니다\n", json_path_.c_str());
+            return 0;
+        }
+
+    private:
+        template <typename Body>
+        static double measure(Body& body, std::uint64_t iterations) {
+            auto started = std::chrono::steady_clock::now();
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                body();
+            }
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+
+        static void print(const Result& result) {
+            if (result.items_per_op > 1) {
+                std::printf("%-48s %14.1f ns/op %12.1f ns/item  (min %.1f, max %.1f, %llu회)\n",
+                    result.name.c_str(), result.ns_per_op, result.ns_per_op / result.items_per_op,
+                    result.min_ns_per_op, result.max_ns_per_op, static_cast<unsigned long long>(result.iterations));
+            }
+            else {
+                std::printf("%-48s %14.1f ns/op  (min %.1f, max %.1f, %llu회)\n",
+                    result.name.c_str(), result.ns_per_op,
+                    result.min_ns_per_op, result.max_ns_per_op, static_cast<unsigned long long>(result.iterations));
+            }
+            std::fflush(stdout);
+        }
+
+        std::string suite_;
+        std::string filter_;
+        std::string json_path_;
+        std::chrono::duration<double> min_time_{ 0.2 };
+        int repetitions_ = 5;
+        std::vector<Result> results_;
+    };
+
+} // namespace bench
+} // namespace game_server
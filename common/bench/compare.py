@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""벤치마크 결과 JSON 두 개를 비교한다.
+
+사용법: compare.py <기준.json> <비교.json> [--threshold 10]
+
+- bench_harness.h 결과(results[].nsPerOp)는 항목별 ns/op를,
+  LoadGenerator 결과(actions.<이름>.p50Ms/p99Ms/throughput)는 액션별 지연 시간과 처리량을,
+  재접속 폭주 결과(reconnectStorm)가 있으면 초당 수락 수와 connect p99도 비교한다.
+- 느려진 비율이 threshold(%)를 넘는 항목이 있으면 종료 코드 1을 반환한다.
+"""
+import json
+import sys
+
+
+def load_metrics(path):
+    """{항목 이름: (값, 클수록 좋은지)} 형태로 변환"""
+    with open(path, encoding="utf-8") as f:
+        document = json.load(f)
+
+    metrics = {}
+    if "results" in document:
+        for result in document["results"]:
+            if result.get("skipped"):
+                continue
+            metrics[result["name"]] = (result["nsPerOp"], False)
+    elif "actions" in document:
+        for name, action in document["actions"].items():
+            metrics[f"{name} p50 ms"] = (action["p50Ms"], False)
+            metrics[f"{name} p99 ms"] = (action["p99Ms"], False)
+            metrics[f"{name} throughput"] = (action["throughput"], True)
+        storm = document.get("reconnectStorm")
+        if storm:
+            metrics["reconnect accepts/s"] = (storm["acceptsPerSecond"], True)
+            metrics["reconnect connect p99 ms"] = (storm["connect"]["p99Ms"], False)
+            metrics["reconnect accept p99 ms"] = (storm["accept"]["p99Ms"], False)
+    else:
+        raise ValueError(f"알 수 없는 결과 형식: {path}")
+    return metrics
+
+
+def main(argv):
+    args = [arg for arg in argv[1:]]
+    threshold = 10.0
+    if "--threshold" in args:
+        index = args.index("--threshold")
+        threshold = float(args[index + 1])
+        del args[index:index + 2]
+    if len(args) != 2:
+        print(__doc__)
+        return 2
+
+    baseline = load_metrics(args[0])
+    current = load_metrics(args[1])
+
+    regressions = 0
+    print(f"{'항목':<56} {'기준':>14} {'비교':>14} {'변화':>9}")
+    for name in sorted(set(baseline) | set(current)):
+        if name not in baseline or name not in current:
+            side = "기준" if name in baseline else "비교"
+            print(f"{name:<56} {side}에만 있음")
+            continue
+        old, higher_is_better = baseline[name]
+        new, _ = current[name]
+        if old == 0:
+            continue
+        change = (new - old) / old * 100.0
+        slower = -change if higher_is_better else change
+        mark = ""
+        if slower > threshold:
+            mark = "  <- 느려짐"
+            regressions += 1
+        elif slower < -threshold:
+            mark = "  <- 빨라짐"
+        print(f"{name:<56} {old:>14.2f} {new:>14.2f} {change:>+8.1f}%{mark}")
+
+    if regressions:
+        print(f"\n{threshold:.0f}% 넘게 느려진 항목 {regressions}개")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,93 @@
+#!/bin/bash
+# 벤치마크용 일회성 PostgreSQL
+# 사용법: local_postgres.sh start   -> 임시 인스턴스를 띄우고 스키마를 적재한 뒤 접속 환경 변수를 출력 (eval로 적용)
+#         local_postgres.sh stop    -> 인스턴스와 데이터 삭제
+# gamedata 데이터베이스에는 MatchingServer/db-init.sql을, gamesocket 데이터베이스에는 저장소 루트의 init.sql을 적재한다.
+# 두 스키마 모두 users 테이블을 만들므로 데이터베이스를 분리한다.
+# docker가 있으면 postgres:14 컨테이너(tmpfs 데이터 디렉토리)를, 없으면 PATH의 initdb/pg_ctl로 임시 디렉토리에 띄운다.
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+REPO_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+STATE_FILE="${BENCH_PG_STATE:-/tmp/bench-postgres.state}"
+PORT="${BENCH_PG_PORT:-55432}"
+DB_USER=admin
+DB_PASSWORD=admin
+
+load_schema() {
+    local psql_cmd=("$@")
+    "${psql_cmd[@]}" -d postgres -c "CREATE DATABASE gamedata WITH OWNER $DB_USER;" > /dev/null
+    "${psql_cmd[@]}" -d postgres -c "CREATE DATABASE gamesocket WITH OWNER $DB_USER;" > /dev/null
+    "${psql_cmd[@]}" -d gamedata < "$REPO_DIR/MatchingServer/db-init.sql" > /dev/null
+    "${psql_cmd[@]}" -d gamesocket < "$REPO_DIR/init.sql" > /dev/null
+}
+
+wait_ready() {
+    for _ in $(seq 1 60); do
+        if "$@" > /dev/null 2>&1; then
+            return 0
+        fi
+        sleep 0.5
+    done
+    echo "PostgreSQL이 준비되지 않았습니다" >&2
+    return 1
+}
+
+start() {
+    if [ -f "$STATE_FILE" ]; then
+        echo "이미 실행 중입니다 ($STATE_FILE). 먼저 stop을 실행하세요" >&2
+        exit 1
+    fi
+
+    if command -v docker > /dev/null 2>&1; then
+        local name="bench-postgres-$$"
+        docker run -d --rm --name "$name" \
+            -e POSTGRES_USER=$DB_USER -e POSTGRES_PASSWORD=$DB_PASSWORD -e POSTGRES_DB=postgres \
+            -p "127.0.0.1:$PORT:5432" --tmpfs /var/lib/postgresql/data \
+            postgres:14 -c fsync=off -c synchronous_commit=off > /dev/null
+        echo "docker $name" > "$STATE_FILE"
+        wait_ready docker exec "$name" pg_isready -U $DB_USER -d postgres
+        # 초기화 스크립트 실행 뒤 서버가 재시작되므로 실제 접속이 될 때까지 한 번 더 대기
+        wait_ready docker exec "$name" psql -U $DB_USER -d postgres -c "SELECT 1"
+        load_schema docker exec -i "$name" psql -v ON_ERROR_STOP=1 -q -U $DB_USER
+    else
+        local data_dir
+        data_dir="$(mktemp -d /tmp/bench-postgres.XXXXXX)"
+        local pwfile="$data_dir.pw"
+        echo "$DB_PASSWORD" > "$pwfile"
+        initdb -D "$data_dir" -U $DB_USER --pwfile="$pwfile" -A md5 > /dev/null
+        rm -f "$pwfile"
+        pg_ctl -D "$data_dir" -l "$data_dir/server.log" -w \
+            -o "-p $PORT -k /tmp -c listen_addresses=127.0.0.1 -c fsync=off -c synchronous_commit=off" start > /dev/null
+        echo "local $data_dir" > "$STATE_FILE"
+        PGPASSWORD=$DB_PASSWORD load_schema psql -v ON_ERROR_STOP=1 -q -h 127.0.0.1 -p "$PORT" -U $DB_USER
+    fi
+
+    echo "export DB_HOST=127.0.0.1 DB_PORT=$PORT DB_USER=$DB_USER DB_PASSWORD=$DB_PASSWORD DB_NAME=gamedata"
+    echo "export BENCH_DB_URL='host=127.0.0.1 port=$PORT user=$DB_USER password=$DB_PASSWORD dbname=gamedata'"
+    echo "export BENCH_GAME_DB_URL='host=127.0.0.1 port=$PORT user=$DB_USER password=$DB_PASSWORD dbname=gamesocket'"
+}
+
+stop() {
+    if [ ! -f "$STATE_FILE" ]; then
+        return 0
+    fi
+    read -r kind target < "$STATE_FILE"
+    if [ "$kind" = "docker" ]; then
+        docker stop "$target" > /dev/null || true
+    else
+        pg_ctl -D "$target" -m immediate stop > /dev/null || true
+        rm -rf "$target"
+    fi
+    rm -f "$STATE_FILE"
+}
+
+case "$1" in
+    start) start ;;
+    stop) stop ;;
+    *)
+        echo "사용법: $0 start|stop" >&2
+        exit 1
+        ;;
+esac
@@ -0,0 +1,259 @@
+﻿// common/crypto/crypto_util.cpp
+// 공용 암호 유틸리티 구현 파일
+// 요청마다 EVP 컨텍스트를 만들고 해제하지 않도록 스레드별 컨텍스트를 초기화하여 재사용
+#include "crypto_util.h"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/opensslv.h>
+#include <openssl/rand.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
+
+namespace game_server {
+namespace crypto {
+
+    namespace {
+        constexpr char kHexDigits[] = "0123456789abcdef";
+        constexpr char kBase64UrlDigits[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+        int base64UrlValue(char c) {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '-') return 62;
+            if (c == '_') return 63;
+            return -1;
+        }
+
+        int hexValue(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        // 스레드 종료 시 해제되는 다이제스트 컨텍스트
+        struct DigestContext {
+            EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+            ~DigestContext() { EVP_MD_CTX_free(ctx); }
+        };
+
+        EVP_MD_CTX* threadDigestContext() {
+            thread_local DigestContext context;
+            if (!context.ctx) throw std::runtime_error("EVP_MD_CTX 생성 실패");
+            return context.ctx;
+        }
+
+        // 스레드별 난수 버퍼 크기 (getrandom 한 번으로 채우는 양)
+        constexpr std::size_t kRandomPoolSize = 4096;
+
+        bool fillFromOs(unsigned char* out, std::size_t length) {
+#if defined(__linux__)
+            while (length > 0) {
+                ssize_t filled = ::getrandom(out, length, 0);
+                if (filled < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                out += filled;
+                length -= static_cast<std::size_t>(filled);
+            }
+            return true;
+#else
+            return RAND_bytes(out, static_cast<int>(length)) == 1;
+#endif
+        }
+
+        struct RandomPool {
+            std::array<unsigned char, kRandomPoolSize> bytes;
+            std::size_t offset = kRandomPoolSize;   // 처음 사용 시 채움
+            ~RandomPool() { OPENSSL_cleanse(bytes.data(), bytes.size()); }
+        };
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        // 알고리즘 조회는 비용이 있으므로 한 번만 가져와서 재사용
+        EVP_MD* sha256Md() {
+            static EVP_MD* md = EVP_MD_fetch(nullptr, "SHA256", nullptr);
+            return md;
+        }
+
+        struct MacContext {
+            EVP_MAC* mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+            EVP_MAC_CTX* ctx = mac ? EVP_MAC_CTX_new(mac) : nullptr;
+            ~MacContext() {
+                EVP_MAC_CTX_free(ctx);
+                EVP_MAC_free(mac);
+            }
+        };
+
+        EVP_MAC_CTX* threadMacContext() {
+            thread_local MacContext context;
+            if (!context.ctx) throw std::runtime_error("EVP_MAC_CTX 생성 실패");
+            return context.ctx;
+        }
+#else
+        const EVP_MD* sha256Md() {
+            return EVP_sha256();
+        }
+#endif
+    }
+
+    void toHex(const unsigned char* data, std::size_t length, char* out) {
+        for (std::size_t i = 0; i < length; ++i) {
+            out[i * 2] = kHexDigits[data[i] >> 4];
+            out[i * 2 + 1] = kHexDigits[data[i] & 0x0F];
+        }
+    }
+
+    std::string toHexString(const unsigned char* data, std::size_t length) {
+        std::string out(length * 2, '\0');
+        toHex(data, length, out.data());
+        return out;
+    }
+
+    bool fromHex(std::string_view hex, unsigned char* out, std::size_t out_length) {
+        if (hex.size() != out_length * 2) return false;
+        for (std::size_t i = 0; i < out_length; ++i) {
+            int high = hexValue(hex[i * 2]);
+            int low = hexValue(hex[i * 2 + 1]);
+            if (high < 0 || low < 0) return false;
+            out[i] = static_cast<unsigned char>((high << 4) | low);
+        }
+        return true;
+    }
+
+    void base64UrlEncode(const unsigned char* data, std::size_t length, char* out) {
+        std::size_t i = 0;
+        for (; i + 3 <= length; i += 3) {
+            std::uint32_t block = (static_cast<std::uint32_t>(data[i]) << 16) |
+                (static_cast<std::uint32_t>(data[i + 1]) << 8) | data[i + 2];
+            *out++ = kBase64UrlDigits[(block >> 18) & 0x3F];
+            *out++ = kBase64UrlDigits[(block >> 12) & 0x3F];
+            *out++ = kBase64UrlDigits[(block >> 6) & 0x3F];
+            *out++ = kBase64UrlDigits[block & 0x3F];
+        }
+
+        std::size_t rest = length - i;
+        if (rest > 0) {
+            std::uint32_t block = static_cast<std::uint32_t>(data[i]) << 16;
+            if (rest == 2) block |= static_cast<std::uint32_t>(data[i + 1]) << 8;
+            *out++ = kBase64UrlDigits[(block >> 18) & 0x3F];
+            *out++ = kBase64UrlDigits[(block >> 12) & 0x3F];
+            if (rest == 2) *out++ = kBase64UrlDigits[(block >> 6) & 0x3F];
+        }
+    }
+
+    std::string base64UrlEncode(const unsigned char* data, std::size_t length) {
+        std::string out(base64UrlLength(length), '\0');
+        base64UrlEncode(data, length, out.data());
+        return out;
+    }
+
+    bool base64UrlDecode(std::string_view text, unsigned char* out, std::size_t out_capacity, std::size_t& out_length) {
+        // 패딩 없는 형식에서 나머지 1글자는 나올 수 없음
+        if (text.size() % 4 == 1) return false;
+        std::size_t decoded = text.size() / 4 * 3 + (text.size() % 4 == 0 ? 0 : text.size() % 4 - 1);
+        if (decoded > out_capacity) return false;
+
+        std::uint32_t block = 0;
+        int bits = 0;
+        std::size_t written = 0;
+        for (char c : text) {
+            int value = base64UrlValue(c);
+            if (value < 0) return false;
+            block = (block << 6) | static_cast<std::uint32_t>(value);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                out[written++] = static_cast<unsigned char>((block >> bits) & 0xFF);
+            }
+        }
+        // 남은 비트가 0이 아니면 정규 인코딩이 아님 (같은 토큰의 다른 표기 방지)
+        if ((block & ((1u << bits) - 1)) != 0) return false;
+
+        out_length = written;
+        return true;
+    }
+
+    bool randomBytes(unsigned char* out, std::size_t length) {
+        // 큰 요청은 버퍼를 거치지 않고 바로 채움
+        if (length > kRandomPoolSize / 4) {
+            return fillFromOs(out, length);
+        }
+
+        thread_local RandomPool pool;
+        if (pool.offset + length > pool.bytes.size()) {
+            if (!fillFromOs(pool.bytes.data(), pool.bytes.size())) return false;
+            pool.offset = 0;
+        }
+
+        // 한 번 꺼낸 바이트는 지워서 같은 값이 다시 나가거나 메모리에 남지 않도록 함
+        unsigned char* source = pool.bytes.data() + pool.offset;
+        std::memcpy(out, source, length);
+        OPENSSL_cleanse(source, length);
+        pool.offset += length;
+        return true;
+    }
+
+    bool constantTimeEquals(std::string_view a, std::string_view b) {
+        // 길이는 공개된 정보(고정 길이 해시)이므로 먼저 비교해도 무방
+        if (a.size() != b.size()) return false;
+        return CRYPTO_memcmp(a.data(), b.data(), a.size()) == 0;
+    }
+
+    bool constantTimeEquals(const unsigned char* a, const unsigned char* b, std::size_t length) {
+        return CRYPTO_memcmp(a, b, length) == 0;
+    }
+
+    Sha256Digest sha256(std::string_view data) {
+        Sha256Digest digest;
+        EVP_MD_CTX* ctx = threadDigestContext();
+        unsigned int length = 0;
+        if (EVP_DigestInit_ex(ctx, sha256Md(), nullptr) != 1 ||
+            EVP_DigestUpdate(ctx, data.data(), data.size()) != 1 ||
+            EVP_DigestFinal_ex(ctx, digest.data(), &length) != 1) {
+            throw std::runtime_error("SHA-256 계산 실패");
+        }
+        return digest;
+    }
+
+    Sha256Digest hmacSha256(std::string_view key, std::string_view data) {
+        Sha256Digest digest;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        EVP_MAC_CTX* ctx = threadMacContext();
+        char digest_name[] = "SHA256";
+        OSSL_PARAM params[] = {
+            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest_name, 0),
+            OSSL_PARAM_construct_end()
+        };
+        std::size_t length = 0;
+        if (EVP_MAC_init(ctx, reinterpret_cast<const unsigned char*>(key.data()), key.size(), params) != 1 ||
+            EVP_MAC_update(ctx, reinterpret_cast<const unsigned char*>(data.data()), data.size()) != 1 ||
+            EVP_MAC_final(ctx, digest.data(), &length, digest.size()) != 1) {
+            throw std::runtime_error("HMAC-SHA256 계산 실패");
+        }
+#else
+        unsigned int length = 0;
+        if (!HMAC(EVP_sha256(), key.data(), static_cast<int>(key.size()),
+            reinterpret_cast<const unsigned char*>(data.data()), data.size(), digest.data(), &length)) {
+            throw std::runtime_error("HMAC-SHA256 계산 실패");
+        }
+#endif
+        return digest;
+    }
+
+} // namespace crypto
+} // namespace game_server
@@ -0,0 +1,55 @@
+﻿// common/crypto/crypto_util.h
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace game_server {
+namespace crypto {
+
+    // MatchingServer와 GameSocketServer가 함께 사용하는 암호 유틸리티
+    // 16진수 변환은 스택 버퍼만 사용하고, 다이제스트/HMAC 컨텍스트는 스레드별로 재사용한다.
+
+    constexpr std::size_t kSha256Length = 32;
+    using Sha256Digest = std::array<unsigned char, kSha256Length>;
+
+    // out에 length * 2 바이트의 소문자 16진수를 기록 (널 종료 없음)
+    void toHex(const unsigned char* data, std::size_t length, char* out);
+
+    // 고정 길이 바이트 배열을 스택 배열의 16진수로 변환
+    template <std::size_t N>
+    std::array<char, N * 2> toHex(const std::array<unsigned char, N>& data) {
+        std::array<char, N * 2> out;
+        toHex(data.data(), N, out.data());
+        return out;
+    }
+
+    // 결과 문자열 한 번만 할당
+    std::string toHexString(const unsigned char* data, std::size_t length);
+
+    // 16진수 문자열을 바이트로 변환, 길이가 맞지 않거나 16진수가 아니면 false
+    bool fromHex(std::string_view hex, unsigned char* out, std::size_t out_length);
+
+    // 패딩 없는 base64url (RFC 4648 §5), 토큰처럼 URL/JSON에 그대로 넣는 값에 사용
+    std::string base64UrlEncode(const unsigned char* data, std::size_t length);
+    // out에 base64UrlLength(length) 글자를 기록 (널 종료 없음)
+    void base64UrlEncode(const unsigned char* data, std::size_t length, char* out);
+    constexpr std::size_t base64UrlLength(std::size_t length) { return (length * 4 + 2) / 3; }
+    // out_capacity보다 길거나 base64url 문자가 아니면 false, 성공 시 out_length에 바이트 수 기록
+    bool base64UrlDecode(std::string_view text, unsigned char* out, std::size_t out_capacity, std::size_t& out_length);
+
+    // 암호학적으로 안전한 난수, 실패 시 false
+    // 작은 요청은 스레드별 버퍼(getrandom으로 한 번에 채움)에서 꺼내므로 잠금과 시스템 호출이 거의 없다.
+    // 버퍼는 스레드별이므로 fork한 자식 프로세스에서는 사용하지 않는다.
+    bool randomBytes(unsigned char* out, std::size_t length);
+
+    // 길이가 같으면 내용과 관계없이 같은 시간에 비교 (해시, 서명 비교용)
+    bool constantTimeEquals(std::string_view a, std::string_view b);
+    bool constantTimeEquals(const unsigned char* a, const unsigned char* b, std::size_t length);
+
+    Sha256Digest sha256(std::string_view data);
+    Sha256Digest hmacSha256(std::string_view key, std::string_view data);
+
+} // namespace crypto
+} // namespace game_server
@@ -0,0 +1,159 @@
+﻿// common/protocol/request_limits.cpp
+// 요청 메시지 제한 구현 파일
+// nlohmann::json SAX 인터페이스로 값을 하나씩 받으며 제한을 검사하고 DOM을 직접 구성
+#include "request_limits.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace game_server {
+namespace protocol {
+
+    using json = nlohmann::json;
+
+    RequestLimits RequestLimits::fromJson(const json& config) {
+        RequestLimits result;
+        if (!config.is_object()) return result;
+        result.max_message_bytes = std::max<std::size_t>(1, config.value("maxMessageBytes", result.max_message_bytes));
+        result.max_depth = std::max<std::size_t>(1, config.value("maxDepth", result.max_depth));
+        result.max_string_bytes = config.value("maxStringBytes", result.max_string_bytes);
+        result.max_elements = std::max<std::size_t>(1, config.value("maxElements", result.max_elements));
+        result.max_chat_bytes = std::max<std::size_t>(1, config.value("maxChatBytes", result.max_chat_bytes));
+        return result;
+    }
+
+    const char* toString(LimitViolation violation) {
+        switch (violation) {
+        case LimitViolation::None: return "none";
+        case LimitViolation::MessageTooLarge: return "message_too_large";
+        case LimitViolation::TooDeep: return "too_deep";
+        case LimitViolation::StringTooLong: return "string_too_long";
+        case LimitViolation::TooManyElements: return "too_many_elements";
+        case LimitViolation::Malformed: return "malformed";
+        }
+        return "unknown";
+    }
+
+    namespace {
+
+        // 제한을 넘는 순간 false를 반환해 파서를 멈추는 SAX 처리기
+        class BoundedDomBuilder {
+        public:
+            BoundedDomBuilder(json& root, const RequestLimits& limits)
+                : root_(root), limits_(limits) {}
+
+            LimitViolation violation() const { return violation_; }
+
+            bool null() { return value(nullptr); }
+            bool boolean(bool v) { return value(v); }
+            bool number_integer(json::number_integer_t v) { return value(v); }
+            bool number_unsigned(json::number_unsigned_t v) { return value(v); }
+            bool number_float(json::number_float_t v, const json::string_t&) { return value(v); }
+
+            bool string(json::string_t& v) {
+                if (v.size() > limits_.max_string_bytes) return fail(LimitViolation::StringTooLong);
+                return value(std::move(v));
+            }
+
+            bool binary(json::binary_t&) { return fail(LimitViolation::Malformed); }
+
+            bool start_object(std::size_t) {
+                return open(json::value_t::object);
+            }
+
+            bool key(json::string_t& k) {
+                if (k.size() > limits_.max_string_bytes) return fail(LimitViolation::StringTooLong);
+                object_key_ = &(*stack_.back())[std::move(k)];
+                return true;
+            }
+
+            bool end_object() {
+                stack_.pop_back();
+                return true;
+            }
+
+            bool start_array(std::size_t) {
+                return open(json::value_t::array);
+            }
+
+            bool end_array() {
+                stack_.pop_back();
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) {
+                return fail(LimitViolation::Malformed);
+            }
+
+        private:
+            bool fail(LimitViolation violation) {
+                violation_ = violation;
+                return false;
+            }
+
+            // 스칼라 또는 컨테이너 하나를 현재 위치에 추가
+            template <typename Value>
+            json* place(Value&& v) {
+                if (++elements_ > limits_.max_elements) {
+                    fail(LimitViolation::TooManyElements);
+                    return nullptr;
+                }
+                if (stack_.empty()) {
+                    root_ = json(std::forward<Value>(v));
+                    return &root_;
+                }
+                if (stack_.back()->is_array()) {
+                    stack_.back()->emplace_back(std::forward<Value>(v));
+                    return &stack_.back()->back();
+                }
+                *object_key_ = json(std::forward<Value>(v));
+                return object_key_;
+            }
+
+            template <typename Value>
+            bool value(Value&& v) {
+                return place(std::forward<Value>(v)) != nullptr;
+            }
+
+            bool open(json::value_t type) {
+                if (stack_.size() >= limits_.max_depth) return fail(LimitViolation::TooDeep);
+                json* container = place(type);
+                if (!container) return false;
+                stack_.push_back(container);
+                return true;
+            }
+
+            json& root_;
+            const RequestLimits& limits_;
+            std::vector<json*> stack_;
+            json* object_key_ = nullptr;
+            std::size_t elements_ = 0;
+            LimitViolation violation_ = LimitViolation::None;
+        };
+    }
+
+    LimitViolation parseBounded(const char* first, const char* last, const RequestLimits& limits, json& out) {
+        if (static_cast<std::size_t>(last - first) > limits.max_message_bytes) {
+            return LimitViolation::MessageTooLarge;
+        }
+
+        json result;
+        BoundedDomBuilder builder(result, limits);
+        bool ok = false;
+        try {
+            ok = json::sax_parse(first, last, &builder);
+        }
+        catch (const std::exception&) {
+            // 파서 외부 예외 (메모리 부족 등)
+            return LimitViolation::Malformed;
+        }
+        if (!ok) {
+            return builder.violation() == LimitViolation::None ? LimitViolation::Malformed : builder.violation();
+        }
+        out = std::move(result);
+        return LimitViolation::None;
+    }
+
+} // namespace protocol
+} // namespace game_server
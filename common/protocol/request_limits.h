@@ -0,0 +1,38 @@
+﻿// common/protocol/request_limits.h
+#pragma once
+#include <cstddef>
+#include <nlohmann/json.hpp>
+
+namespace game_server {
+namespace protocol {
+
+    // 요청 메시지 제한 (MatchingServer config.json의 "requestLimits", GameSocketServer 설정 파일의 같은 섹션)
+    // 메시지 크기는 파싱 전에, 나머지는 SAX 파싱 중에 검사하여 처음 위반한 지점에서 멈추므로
+    // 한 요청의 파싱 비용은 max_message_bytes에 비례하는 값을 넘지 않는다.
+    struct RequestLimits {
+        std::size_t max_message_bytes = 4096;   // 메시지(본문) 하나의 최대 바이트
+        std::size_t max_depth = 8;              // 객체/배열 최대 중첩 깊이
+        std::size_t max_string_bytes = 1024;    // 문자열 값/키 하나의 최대 바이트
+        std::size_t max_elements = 256;         // 메시지 전체의 최대 값(키 제외) 개수
+        std::size_t max_chat_bytes = 200;       // 대기실 채팅 메시지 하나의 최대 바이트 (MatchingServer chat 액션)
+
+        static RequestLimits fromJson(const nlohmann::json& config);
+    };
+
+    enum class LimitViolation {
+        None,
+        MessageTooLarge,
+        TooDeep,
+        StringTooLong,
+        TooManyElements,
+        Malformed          // 제한과 관계없는 JSON 문법 오류
+    };
+
+    // 메트릭 라벨, 로그용 이름
+    const char* toString(LimitViolation violation);
+
+    // 제한을 지키며 파싱, 성공 시 None을 반환하고 out에 결과를 채움 (예외를 던지지 않음)
+    LimitViolation parseBounded(const char* first, const char* last, const RequestLimits& limits, nlohmann::json& out);
+
+} // namespace protocol
+} // namespace game_server